@@ -0,0 +1,75 @@
+# plugin_add_dsp_library(<Plugin> SOURCES <files...> [MODULES <extra juce modules...>])
+#
+# Creates <Plugin>_DSP: a static library holding the plugin's processor and
+# voice sources, built with PLUGIN_DSP_ONLY=1 so createEditor() returns nullptr
+# (null editor factory) and no editor, WebView or BinaryData code is compiled.
+# Every PluginProcessor.cpp implements hasEditor()/createEditor() twice under
+# #if PLUGIN_DSP_ONLY: false/nullptr there, the real editor otherwise - this
+# is the one place that explains why.
+#
+# The library links only juce_audio_processors and juce_dsp (plus what those
+# modules require, plus any extra MODULES such as juce::juce_audio_formats)
+# with JUCE_WEB_BROWSER=0, so it builds on headless machines
+# without a browser stack. The JUCE module sources are compiled into the
+# library itself; consumers (benchmarks, render tools) link <Plugin>_DSP alone
+# and inherit its include paths and definitions - they must not link other
+# juce:: module targets or the modules would be compiled twice.
+#
+# Targets are EXCLUDE_FROM_ALL: regular plugin builds are unaffected, and
+# render machines build them explicitly (cmake --build build --target Drum808_DSP).
+
+function(plugin_add_dsp_library PLUGIN_NAME)
+    cmake_parse_arguments(ARG "" "" "SOURCES;MODULES" ${ARGN})
+
+    if(NOT ARG_SOURCES)
+        message(FATAL_ERROR "plugin_add_dsp_library(${PLUGIN_NAME}) needs SOURCES")
+    endif()
+
+    set(DSP_TARGET ${PLUGIN_NAME}_DSP)
+
+    add_library(${DSP_TARGET} STATIC EXCLUDE_FROM_ALL)
+
+    target_sources(${DSP_TARGET}
+        PRIVATE
+            ${ARG_SOURCES}
+    )
+
+    target_include_directories(${DSP_TARGET}
+        PRIVATE
+            Source
+    )
+
+    target_link_libraries(${DSP_TARGET}
+        PRIVATE
+            juce::juce_audio_processors
+            juce::juce_dsp
+            PluginShared
+            ${ARG_MODULES}
+        PUBLIC
+            juce::juce_recommended_config_flags
+            juce::juce_recommended_lto_flags
+            juce::juce_recommended_warning_flags
+    )
+
+    target_compile_definitions(${DSP_TARGET}
+        PUBLIC
+            PLUGIN_DSP_ONLY=1
+            JUCE_VST3_CAN_REPLACE_VST2=0
+            JUCE_WEB_BROWSER=0
+            JUCE_USE_CURL=0
+        INTERFACE
+            $<TARGET_PROPERTY:${DSP_TARGET},COMPILE_DEFINITIONS>
+    )
+
+    target_include_directories(${DSP_TARGET}
+        INTERFACE
+            $<TARGET_PROPERTY:${DSP_TARGET},INCLUDE_DIRECTORIES>
+    )
+
+    set_target_properties(${DSP_TARGET} PROPERTIES
+        POSITION_INDEPENDENT_CODE TRUE
+        VISIBILITY_INLINES_HIDDEN TRUE
+        C_VISIBILITY_PRESET hidden
+        CXX_VISIBILITY_PRESET hidden
+    )
+endfunction()
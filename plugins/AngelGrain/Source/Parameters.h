@@ -0,0 +1,44 @@
+#pragma once
+#include "ParameterTable.h"
+#include "StateCodec.h"
+
+// Parameter table - single source of truth for IDs, ranges and defaults.
+// Order must match AngelGrainParam (it is also the host parameter order).
+enum class AngelGrainParam
+{
+    DelayTime, GrainSize, Feedback, Chaos, Character, Mix, TempoSync,
+    Count
+};
+
+inline constexpr std::array angelGrainParameterTable
+{
+    // delayTime - Float (50-2000ms, default 500, skew 0.5)
+    pfs::floatParameter("delayTime", "Delay Time", 50.0f, 2000.0f, 0.1f, 0.5f, 500.0f, "ms"),
+
+    // grainSize - Float (5-500ms, default 100, skew 0.5)
+    pfs::floatParameter("grainSize", "Grain Size", 5.0f, 500.0f, 0.1f, 0.5f, 100.0f, "ms"),
+
+    // feedback - Float (0-100%, default 30, skew 1.0)
+    pfs::floatParameter("feedback", "Feedback", 0.0f, 100.0f, 0.1f, 1.0f, 30.0f, "%"),
+
+    // chaos - Float (0-100%, default 25, skew 1.0)
+    pfs::floatParameter("chaos", "Chaos", 0.0f, 100.0f, 0.1f, 1.0f, 25.0f, "%"),
+
+    // character - Float (0-100%, default 50, skew 1.0)
+    pfs::floatParameter("character", "Character", 0.0f, 100.0f, 0.1f, 1.0f, 50.0f, "%"),
+
+    // mix - Float (0-100%, default 50, skew 1.0)
+    pfs::floatParameter("mix", "Mix", 0.0f, 100.0f, 0.1f, 1.0f, 50.0f, "%"),
+
+    // tempoSync - Bool (default true)
+    pfs::boolParameter("tempoSync", "Tempo Sync", true),
+};
+
+static_assert(angelGrainParameterTable.size() == static_cast<size_t>(AngelGrainParam::Count));
+static_assert(pfs::isValidParameterTable(angelGrainParameterTable));
+static_assert(pfs::hasUniqueStateHashes(angelGrainParameterTable));
+
+using AngelGrainParameterCache = pfs::ParameterCache<AngelGrainParam, angelGrainParameterTable.size()>;
+using AngelGrainParameterSnapshot = AngelGrainParameterCache::Snapshot;
+using AngelGrainStateCodec = pfs::StateCodec<angelGrainParameterTable.size()>;
+
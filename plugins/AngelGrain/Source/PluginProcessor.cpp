@@ -1,72 +1,13 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+#include "Saturation.h"
+
+#if ! PLUGIN_DSP_ONLY
+ #include "PluginEditor.h"
+#endif
 
 juce::AudioProcessorValueTreeState::ParameterLayout AngelGrainAudioProcessor::createParameterLayout()
 {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-
-    // delayTime - Float (50-2000ms, default 500, skew 0.5)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "delayTime", 1 },
-        "Delay Time",
-        juce::NormalisableRange<float>(50.0f, 2000.0f, 0.1f, 0.5f),
-        500.0f,
-        "ms"
-    ));
-
-    // grainSize - Float (5-500ms, default 100, skew 0.5)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "grainSize", 1 },
-        "Grain Size",
-        juce::NormalisableRange<float>(5.0f, 500.0f, 0.1f, 0.5f),
-        100.0f,
-        "ms"
-    ));
-
-    // feedback - Float (0-100%, default 30, skew 1.0)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "feedback", 1 },
-        "Feedback",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        30.0f,
-        "%"
-    ));
-
-    // chaos - Float (0-100%, default 25, skew 1.0)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "chaos", 1 },
-        "Chaos",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        25.0f,
-        "%"
-    ));
-
-    // character - Float (0-100%, default 50, skew 1.0)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "character", 1 },
-        "Character",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        50.0f,
-        "%"
-    ));
-
-    // mix - Float (0-100%, default 50, skew 1.0)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "mix", 1 },
-        "Mix",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        50.0f,
-        "%"
-    ));
-
-    // tempoSync - Bool (default true)
-    layout.add(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { "tempoSync", 1 },
-        "Tempo Sync",
-        true
-    ));
-
-    return layout;
+    return pfs::createParameterLayout(angelGrainParameterTable);
 }
 
 AngelGrainAudioProcessor::AngelGrainAudioProcessor()
@@ -74,6 +15,8 @@ AngelGrainAudioProcessor::AngelGrainAudioProcessor()
                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, angelGrainParameterTable)
+    , stateCodec(parameters, angelGrainParameterTable)
 {
 }
 
@@ -125,8 +68,7 @@ void AngelGrainAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBl
     feedbackSampleR = 0.0f;
 
     // Calculate initial grain interval from delayTime parameter
-    auto* delayTimeParam = parameters.getRawParameterValue("delayTime");
-    float delayTimeMs = delayTimeParam->load();
+    float delayTimeMs = parameterCache.load(AngelGrainParam::DelayTime);
     nextGrainInterval = static_cast<int>((delayTimeMs / 1000.0f) * sampleRate);
 
     // Pre-allocate stereo buffers for real-time safety
@@ -152,20 +94,15 @@ void AngelGrainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
         dryBuffer.setSize(2, numSamples, false, false, true);
     }
 
-    // Read parameters atomically
-    auto* delayTimeParam = parameters.getRawParameterValue("delayTime");
-    auto* mixParam = parameters.getRawParameterValue("mix");
-    auto* feedbackParam = parameters.getRawParameterValue("feedback");
-    auto* characterParam = parameters.getRawParameterValue("character");
-    auto* chaosParam = parameters.getRawParameterValue("chaos");
-    auto* tempoSyncParam = parameters.getRawParameterValue("tempoSync");
-
-    float delayTimeMs = delayTimeParam->load();
-    float mixValue = mixParam->load() / 100.0f;
-    float feedbackGain = (feedbackParam->load() / 100.0f) * 0.95f;  // Map 0-100% to 0-0.95
-    float characterAmount = characterParam->load() / 100.0f;
-    float chaosAmount = chaosParam->load() / 100.0f;
-    bool tempoSyncEnabled = tempoSyncParam->load() > 0.5f;
+    // Read parameters once per block (cached atomics, no ID lookups)
+    const auto params = parameterCache.snapshot();
+
+    float delayTimeMs = params[AngelGrainParam::DelayTime];
+    float mixValue = params[AngelGrainParam::Mix] / 100.0f;
+    float feedbackGain = (params[AngelGrainParam::Feedback] / 100.0f) * 0.95f;  // Map 0-100% to 0-0.95
+    float characterAmount = params[AngelGrainParam::Character] / 100.0f;
+    float chaosAmount = params[AngelGrainParam::Chaos] / 100.0f;
+    bool tempoSyncEnabled = params[AngelGrainParam::TempoSync] > 0.5f;
 
     // Tempo sync: quantize delay time to note divisions
     if (tempoSyncEnabled)
@@ -239,7 +176,7 @@ void AngelGrainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
         samplesSinceLastGrain++;
         if (samplesSinceLastGrain >= currentInterval && currentInterval > 0)
         {
-            spawnGrain();
+            spawnGrain(params);
             samplesSinceLastGrain = 0;
         }
 
@@ -293,8 +230,8 @@ void AngelGrainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
         // Apply soft saturation (tanh) at high feedback to prevent runaway
         if (feedbackGain > 0.5f)
         {
-            feedbackL = std::tanh(feedbackL);
-            feedbackR = std::tanh(feedbackR);
+            feedbackL = pfs::saturation::tanh(feedbackL);
+            feedbackR = pfs::saturation::tanh(feedbackR);
         }
         feedbackSampleL = feedbackL;
         feedbackSampleR = feedbackR;
@@ -321,27 +258,39 @@ void AngelGrainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
     }
 }
 
+#if PLUGIN_DSP_ONLY
+bool AngelGrainAudioProcessor::hasEditor() const
+{
+    return false;
+}
+
+juce::AudioProcessorEditor* AngelGrainAudioProcessor::createEditor()
+{
+    return nullptr;
+}
+#else
+bool AngelGrainAudioProcessor::hasEditor() const
+{
+    return true;
+}
+
 juce::AudioProcessorEditor* AngelGrainAudioProcessor::createEditor()
 {
     return new AngelGrainAudioProcessorEditor(*this);
 }
+#endif
 
 void AngelGrainAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    stateCodec.save(destData);
 }
 
 void AngelGrainAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState != nullptr && xmlState->hasTagName(parameters.state.getType()))
-        parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    stateCodec.load(data, sizeInBytes);
 }
 
-void AngelGrainAudioProcessor::spawnGrain()
+void AngelGrainAudioProcessor::spawnGrain(const AngelGrainParameterSnapshot& params)
 {
     // Find a free voice
     int voiceIndex = findFreeVoice();
@@ -350,14 +299,10 @@ void AngelGrainAudioProcessor::spawnGrain()
 
     auto& voice = grainVoices[static_cast<size_t>(voiceIndex)];
 
-    // Read parameters
-    auto* grainSizeParam = parameters.getRawParameterValue("grainSize");
-    auto* delayTimeParam = parameters.getRawParameterValue("delayTime");
-    auto* chaosParam = parameters.getRawParameterValue("chaos");
-
-    float grainSizeMs = grainSizeParam->load();
-    float delayTimeMs = delayTimeParam->load();
-    float chaosAmount = chaosParam->load() / 100.0f;  // Normalize to 0.0-1.0
+    // Parameters from the block snapshot
+    float grainSizeMs = params[AngelGrainParam::GrainSize];
+    float delayTimeMs = params[AngelGrainParam::DelayTime];
+    float chaosAmount = params[AngelGrainParam::Chaos] / 100.0f;  // Normalize to 0.0-1.0
 
     // Calculate grain length in samples
     voice.grainLengthSamples = static_cast<int>((grainSizeMs / 1000.0f) * currentSampleRate);
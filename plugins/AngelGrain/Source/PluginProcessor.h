@@ -1,6 +1,7 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "Parameters.h"
 
 // Grain voice structure for polyphonic grain management
 struct GrainVoice
@@ -25,7 +26,7 @@ public:
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override { return true; }
+    bool hasEditor() const override;
 
     const juce::String getName() const override { return "AngelGrain"; }
     bool acceptsMidi() const override { return false; }
@@ -84,12 +85,18 @@ private:
     float feedbackSampleR = 0.0f;
 
     // Helper methods
-    void spawnGrain();
+    void spawnGrain(const AngelGrainParameterSnapshot& params);
     float getWindowSample(float normalizedPosition, float tukeyAlpha);
     int findFreeVoice();
     int selectPitchShift(float chaosAmount);
     float calculatePlaybackRate(int semitones);
     float quantizeDelayTimeToTempo(float delayTimeMs, double bpm);
 
+    // Cached parameter pointers (declared after parameters - resolved from it)
+    AngelGrainParameterCache parameterCache;
+
+    // Binary get/setStateInformation (same table, resolved once)
+    AngelGrainStateCodec stateCodec;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AngelGrainAudioProcessor)
 };
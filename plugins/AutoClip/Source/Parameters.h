@@ -0,0 +1,29 @@
+#pragma once
+#include "ParameterTable.h"
+#include "StateCodec.h"
+
+// Parameter table - single source of truth for IDs, ranges and defaults.
+// Order must match AutoClipParam (it is also the host parameter order).
+enum class AutoClipParam
+{
+    ClipThreshold, SoloClipped,
+    Count
+};
+
+inline constexpr std::array autoClipParameterTable
+{
+    // clipThreshold - Float (0-100%, linear)
+    pfs::floatParameter("clipThreshold", "Clip Threshold", 0.0f, 100.0f, 0.01f, 1.0f, 0.0f, "%"),
+
+    // soloClipped - Bool (default: false)
+    pfs::boolParameter("soloClipped", "Clip Solo", false),
+};
+
+static_assert(autoClipParameterTable.size() == static_cast<size_t>(AutoClipParam::Count));
+static_assert(pfs::isValidParameterTable(autoClipParameterTable));
+static_assert(pfs::hasUniqueStateHashes(autoClipParameterTable));
+
+using AutoClipParameterCache = pfs::ParameterCache<AutoClipParam, autoClipParameterTable.size()>;
+using AutoClipParameterSnapshot = AutoClipParameterCache::Snapshot;
+using AutoClipStateCodec = pfs::StateCodec<autoClipParameterTable.size()>;
+
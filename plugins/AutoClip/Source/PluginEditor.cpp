@@ -42,7 +42,9 @@ AutoClipAudioProcessorEditor::AutoClipAudioProcessorEditor(AutoClipAudioProcesso
     // Set editor size (from UI mockup dimensions)
     setSize(300, 500);
 
-    // Phase 5.3: Start meter update timer (30 Hz refresh rate)
+    // Phase 5.3: Start meter update timer (30 Hz refresh rate), skipping frames
+    // queued while no editor was open
+    processorRef.meterFrames.discardAll();
     startTimerHz(30);
 }
 
@@ -116,30 +118,28 @@ void AutoClipAudioProcessorEditor::timerCallback()
     if (!webView)
         return;
 
-    // Read parameters
-    auto* clipThresholdParam = processorRef.parameters.getRawParameterValue("clipThreshold");
-    float clipThresholdPercent = clipThresholdParam->load();
-    float clipThreshold = clipThresholdPercent * 0.01f;  // Convert 0-100% to 0.0-1.0
+    // Drain the meter frames published by the audio thread since the last tick
+    // (wait-free SPSC ring) - the displayed peak is the loudest block in between
+    float inputPeak = 0.0f;
+    float outputPeak = 0.0f;
+    bool isClipping = false;
 
-    // Simple peak detection from last processed buffer
-    // Note: Real implementation would use atomic<float> in processor for thread-safe access
-    // For now, use smoothed approximation based on parameters
+    AutoClipAudioProcessor::MeterFrame frame;
 
-    // Estimate input peak (assume normalized signal)
-    float estimatedInputPeak = 0.7f;  // Placeholder - would read from processor
-
-    // Estimate output peak (if clipping, output clamped to threshold)
-    float estimatedOutputPeak = (clipThreshold > 0.01f && clipThreshold < 1.0f)
-                                ? clipThreshold
-                                : estimatedInputPeak;
-
-    // Smooth peaks for visual stability (exponential smoothing)
-    const float smoothingFactor = 0.3f;
-    smoothedInputPeak += (estimatedInputPeak - smoothedInputPeak) * smoothingFactor;
-    smoothedOutputPeak += (estimatedOutputPeak - smoothedOutputPeak) * smoothingFactor;
+    while (processorRef.meterFrames.pop(frame))
+    {
+        inputPeak = juce::jmax(inputPeak, frame.inputPeak);
+        outputPeak = juce::jmax(outputPeak, frame.outputPeak);
+        isClipping = isClipping || frame.isClipping;
+    }
 
-    // Detect clipping (occurs when threshold < 1.0 and signal would exceed it)
-    bool isClipping = (clipThreshold < 0.99f && estimatedInputPeak > clipThreshold);
+    // Smooth peaks for visual stability: instant attack, exponential release
+    // (with no frames, e.g. transport stopped, the meters fall back to zero)
+    const float releaseFactor = 0.3f;
+    smoothedInputPeak = inputPeak >= smoothedInputPeak ? inputPeak
+                                                       : smoothedInputPeak + (inputPeak - smoothedInputPeak) * releaseFactor;
+    smoothedOutputPeak = outputPeak >= smoothedOutputPeak ? outputPeak
+                                                          : smoothedOutputPeak + (outputPeak - smoothedOutputPeak) * releaseFactor;
 
     // Send meter data to JavaScript via custom event
     // JavaScript listens for 'meterUpdate' event
@@ -1,30 +1,15 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+
+#if ! PLUGIN_DSP_ONLY
+ #include "PluginEditor.h"
+#endif
 
 //==============================================================================
 // Parameter Layout (BEFORE constructor)
 //==============================================================================
 juce::AudioProcessorValueTreeState::ParameterLayout AutoClipAudioProcessor::createParameterLayout()
 {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-
-    // clipThreshold - Float (0-100%, linear)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "clipThreshold", 1 },
-        "Clip Threshold",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.01f, 1.0f),  // min, max, step, skew
-        0.0f,
-        "%"
-    ));
-
-    // soloClipped - Bool (default: false)
-    layout.add(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { "soloClipped", 1 },
-        "Clip Solo",
-        false
-    ));
-
-    return layout;
+    return pfs::createParameterLayout(autoClipParameterTable);
 }
 
 //==============================================================================
@@ -35,6 +20,8 @@ AutoClipAudioProcessor::AutoClipAudioProcessor()
                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, autoClipParameterTable)
+    , stateCodec(parameters, autoClipParameterTable)
 {
 }
 
@@ -82,11 +69,11 @@ void AutoClipAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
     juce::ignoreUnused(midiMessages);
 
     // Read parameters (atomic, real-time safe)
-    auto* clipThresholdParam = parameters.getRawParameterValue("clipThreshold");
+    auto* clipThresholdParam = &parameterCache[AutoClipParam::ClipThreshold];
     float clipThresholdPercent = clipThresholdParam->load();
     float clipThreshold = clipThresholdPercent * 0.01f;  // Convert 0-100% to 0.0-1.0
 
-    auto* soloClippedParam = parameters.getRawParameterValue("soloClipped");
+    auto* soloClippedParam = &parameterCache[AutoClipParam::SoloClipped];
     bool soloClipped = soloClippedParam->load() > 0.5f;
 
     const int numSamples = buffer.getNumSamples();
@@ -99,6 +86,10 @@ void AutoClipAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
         originalBuffer.copyFrom(channel, 0, buffer, channel, 0, numSamples);
     }
 
+    // Phase 5.3: Block peaks across all channels for the meters
+    float meterInputPeak = 0.0f;
+    float meterOutputPeak = 0.0f;
+
     // Phase 4.1 & 4.2: Process each channel
     for (int channel = 0; channel < numChannels; ++channel)
     {
@@ -129,8 +120,14 @@ void AutoClipAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
             // Store clipped sample (will apply gain in second pass)
             channelData[sample] = clippedSample;
         }
+
+        meterInputPeak = juce::jmax(meterInputPeak, inputPeak);
+        meterOutputPeak = juce::jmax(meterOutputPeak, outputPeak);
     }
 
+    // Phase 5.3: Publish meter frame (dropped if the editor isn't draining the ring)
+    meterFrames.push({ meterInputPeak, meterOutputPeak, meterInputPeak > clipThreshold });
+
     // Phase 4.2: Calculate gain compensation (after analyzing all channels)
     float targetGain = 1.0f;
     if (outputPeak > 0.001f && inputPeak > 0.001f)
@@ -171,27 +168,39 @@ void AutoClipAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
 //==============================================================================
 // Editor Creation
 //==============================================================================
+#if PLUGIN_DSP_ONLY
+bool AutoClipAudioProcessor::hasEditor() const
+{
+    return false;
+}
+
+juce::AudioProcessorEditor* AutoClipAudioProcessor::createEditor()
+{
+    return nullptr;
+}
+#else
+bool AutoClipAudioProcessor::hasEditor() const
+{
+    return true;
+}
+
 juce::AudioProcessorEditor* AutoClipAudioProcessor::createEditor()
 {
     return new AutoClipAudioProcessorEditor(*this);
 }
+#endif
 
 //==============================================================================
 // State Management
 //==============================================================================
 void AutoClipAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    stateCodec.save(destData);
 }
 
 void AutoClipAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState != nullptr && xmlState->hasTagName(parameters.state.getType()))
-        parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    stateCodec.load(data, sizeInBytes);
 }
 
 //==============================================================================
@@ -1,6 +1,8 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "Parameters.h"
+#include "Telemetry.h"
 
 class AutoClipAudioProcessor : public juce::AudioProcessor
 {
@@ -13,7 +15,7 @@ public:
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override { return true; }
+    bool hasEditor() const override;
 
     const juce::String getName() const override { return "AutoClip"; }
     bool acceptsMidi() const override { return false; }
@@ -33,6 +35,16 @@ public:
     // Public APVTS for editor binding
     juce::AudioProcessorValueTreeState parameters;
 
+    // Phase 5.3: Metering - one frame per processed block (audio thread → editor, wait-free SPSC ring)
+    struct MeterFrame
+    {
+        float inputPeak;    // Peak before clipping, across all channels
+        float outputPeak;   // Peak after clipping, before gain compensation
+        bool isClipping;    // Input exceeded the threshold in this block
+    };
+
+    pfs::SpscRing<MeterFrame, 256> meterFrames;
+
 private:
     // Parameter layout creation
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
@@ -51,5 +63,11 @@ private:
     // Phase 4.3: Clip Solo (Delta Monitoring)
     juce::AudioBuffer<float> originalBuffer;
 
+    // Cached parameter pointers (declared after parameters - resolved from it)
+    AutoClipParameterCache parameterCache;
+
+    // Binary get/setStateInformation (same table, resolved once)
+    AutoClipStateCodec stateCodec;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AutoClipAudioProcessor)
 };
@@ -0,0 +1,41 @@
+#pragma once
+#include "ParameterTable.h"
+#include "StateCodec.h"
+
+// Parameter table - single source of truth for IDs, ranges and defaults.
+// Order must match DriveVerbParam (it is also the host parameter order).
+enum class DriveVerbParam
+{
+    Size, Decay, DryWet, Drive, Filter, FilterPosition,
+    Count
+};
+
+inline constexpr std::array driveVerbParameterTable
+{
+    // SIZE - Room dimensions control (0-100%, default 40%, linear)
+    pfs::floatParameter("size", "Size", 0.0f, 100.0f, 0.1f, 1.0f, 40.0f, "%"),
+
+    // DECAY - Reverb tail length (0.5-10s, default 2s, logarithmic skew 0.3)
+    pfs::floatParameter("decay", "Decay", 0.5f, 10.0f, 0.01f, 0.3f, 2.0f, "s"),
+
+    // DRY/WET - Mix control (0-100%, default 30%, linear)
+    pfs::floatParameter("dryWet", "Dry/Wet", 0.0f, 100.0f, 0.1f, 1.0f, 30.0f, "%"),
+
+    // DRIVE - Tape saturation amount (0-24dB, default 6dB, linear)
+    pfs::floatParameter("drive", "Drive", 0.0f, 24.0f, 0.1f, 1.0f, 6.0f, "dB"),
+
+    // FILTER - DJ-style filter (-100 to +100%, default 0%, linear)
+    pfs::floatParameter("filter", "Filter", -100.0f, 100.0f, 0.1f, 1.0f, 0.0f, "%"),
+
+    // FILTER POSITION - Pre/Post toggle (0.0=PRE, 1.0=POST, default 1.0)
+    pfs::floatParameter("filterPosition", "Filter Position", 0.0f, 1.0f, 1.0f, 1.0f, 1.0f),
+};
+
+static_assert(driveVerbParameterTable.size() == static_cast<size_t>(DriveVerbParam::Count));
+static_assert(pfs::isValidParameterTable(driveVerbParameterTable));
+static_assert(pfs::hasUniqueStateHashes(driveVerbParameterTable));
+
+using DriveVerbParameterCache = pfs::ParameterCache<DriveVerbParam, driveVerbParameterTable.size()>;
+using DriveVerbParameterSnapshot = DriveVerbParameterCache::Snapshot;
+using DriveVerbStateCodec = pfs::StateCodec<driveVerbParameterTable.size()>;
+
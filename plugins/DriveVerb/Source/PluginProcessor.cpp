@@ -1,64 +1,13 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+#include "Saturation.h"
+
+#if ! PLUGIN_DSP_ONLY
+ #include "PluginEditor.h"
+#endif
 
 juce::AudioProcessorValueTreeState::ParameterLayout DriveVerbAudioProcessor::createParameterLayout()
 {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-
-    // SIZE - Room dimensions control (0-100%, default 40%, linear)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "size", 1 },
-        "Size",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        40.0f,
-        "%"
-    ));
-
-    // DECAY - Reverb tail length (0.5-10s, default 2s, logarithmic skew 0.3)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "decay", 1 },
-        "Decay",
-        juce::NormalisableRange<float>(0.5f, 10.0f, 0.01f, 0.3f),
-        2.0f,
-        "s"
-    ));
-
-    // DRY/WET - Mix control (0-100%, default 30%, linear)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "dryWet", 1 },
-        "Dry/Wet",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        30.0f,
-        "%"
-    ));
-
-    // DRIVE - Tape saturation amount (0-24dB, default 6dB, linear)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "drive", 1 },
-        "Drive",
-        juce::NormalisableRange<float>(0.0f, 24.0f, 0.1f, 1.0f),
-        6.0f,
-        "dB"
-    ));
-
-    // FILTER - DJ-style filter (-100 to +100%, default 0%, linear)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "filter", 1 },
-        "Filter",
-        juce::NormalisableRange<float>(-100.0f, 100.0f, 0.1f, 1.0f),
-        0.0f,
-        "%"
-    ));
-
-    // FILTER POSITION - Pre/Post toggle (0.0=PRE, 1.0=POST, default 1.0)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "filterPosition", 1 },
-        "Filter Position",
-        juce::NormalisableRange<float>(0.0f, 1.0f, 1.0f),
-        1.0f
-    ));
-
-    return layout;
+    return pfs::createParameterLayout(driveVerbParameterTable);
 }
 
 DriveVerbAudioProcessor::DriveVerbAudioProcessor()
@@ -66,6 +15,8 @@ DriveVerbAudioProcessor::DriveVerbAudioProcessor()
                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, driveVerbParameterTable)
+    , stateCodec(parameters, driveVerbParameterTable)
 {
 }
 
@@ -88,11 +39,9 @@ void DriveVerbAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlo
     dryWetMixer.prepare(spec);
     dryWetMixer.setMixingRule(juce::dsp::DryWetMixingRule::balanced); // Equal-power mixing
 
-    // Prepare drive waveshaper with tanh transfer function (Stage 4.2)
-    driveShaper.prepare(spec);
-    driveShaper.functionToUse = [](float sample) { return std::tanh(sample); };
-
     // Prepare DJ-style filter (Stage 4.3)
+    // Second-order coefficient storage, rewritten in place by processBlock (set before prepare)
+    filterProcessor.state = pfs::BiquadCoefficients().makeStorage();
     filterProcessor.prepare(spec);
 }
 
@@ -100,7 +49,6 @@ void DriveVerbAudioProcessor::releaseResources()
 {
     reverb.reset();
     dryWetMixer.reset();
-    driveShaper.reset();
     filterProcessor.reset();
 }
 
@@ -110,12 +58,12 @@ void DriveVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juc
     juce::ignoreUnused(midiMessages);
 
     // Get current parameter values (atomic reads, real-time safe)
-    auto* sizeParam = parameters.getRawParameterValue("size");
-    auto* decayParam = parameters.getRawParameterValue("decay");
-    auto* dryWetParam = parameters.getRawParameterValue("dryWet");
-    auto* driveParam = parameters.getRawParameterValue("drive");
-    auto* filterParam = parameters.getRawParameterValue("filter");
-    auto* filterPositionParam = parameters.getRawParameterValue("filterPosition");
+    auto* sizeParam = &parameterCache[DriveVerbParam::Size];
+    auto* decayParam = &parameterCache[DriveVerbParam::Decay];
+    auto* dryWetParam = &parameterCache[DriveVerbParam::DryWet];
+    auto* driveParam = &parameterCache[DriveVerbParam::Drive];
+    auto* filterParam = &parameterCache[DriveVerbParam::Filter];
+    auto* filterPositionParam = &parameterCache[DriveVerbParam::FilterPosition];
 
     float sizeValue = sizeParam->load();      // 0-100%
     float decayValue = decayParam->load();    // 0.5-10s
@@ -160,39 +108,33 @@ void DriveVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juc
     if (isPostMode)
     {
         // POST MODE: Drive → Filter (drive affects harmonics, then filter shapes them)
-        applyDrive(block, context, driveValue);
+        applyDrive(block, driveValue);
         applyFilter(block, context, filterValue);
     }
     else
     {
         // PRE MODE: Filter → Drive (filter shapes frequency content, then drive adds harmonics)
         applyFilter(block, context, filterValue);
-        applyDrive(block, context, driveValue);
+        applyDrive(block, driveValue);
     }
 
     // Mix dry and wet signals
     dryWetMixer.mixWetSamples(block);
 }
 
-void DriveVerbAudioProcessor::applyDrive(juce::dsp::AudioBlock<float>& block, juce::dsp::ProcessContextReplacing<float>& context, float driveValue)
+void DriveVerbAudioProcessor::applyDrive(juce::dsp::AudioBlock<float>& block, float driveValue)
 {
     // Apply drive to wet signal (Stage 4.2)
     // Convert dB to linear gain: gain = 10^(dB/20)
     float driveGain = std::pow(10.0f, driveValue / 20.0f);
 
-    // Apply gain before waveshaping (increases saturation with higher drive)
+    // Apply gain before tanh waveshaping (tape-like saturation, higher drive saturates more)
     for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
     {
-        auto* channelData = block.getChannelPointer(channel);
-        for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
-        {
-            channelData[sample] *= driveGain;
-        }
+        pfs::saturation::tanhBlock(block.getChannelPointer(channel),
+                                   static_cast<int>(block.getNumSamples()), driveGain);
     }
 
-    // Apply tanh waveshaping (tape-like saturation)
-    driveShaper.process(context);
-
     // Measure output level for VU meter (after waveshaping)
     float maxLevel = 0.0f;
     for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
@@ -235,9 +177,9 @@ void DriveVerbAudioProcessor::applyFilter(juce::dsp::AudioBlock<float>& block, j
             float normalizedValue = std::abs(filterValue) / 100.0f; // 0.0 to 1.0
             float cutoffHz = 20000.0f * std::pow(10.0f, -normalizedValue * std::log10(20000.0f / 200.0f));
 
-            *filterProcessor.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
+            pfs::BiquadCoefficients::lowPass(
                 sampleRate, juce::jlimit(200.0f, 20000.0f, cutoffHz), 0.707f
-            );
+            ).copyTo(*filterProcessor.state);
         }
         else
         {
@@ -246,9 +188,9 @@ void DriveVerbAudioProcessor::applyFilter(juce::dsp::AudioBlock<float>& block, j
             float normalizedValue = filterValue / 100.0f; // 0.0 to 1.0
             float cutoffHz = 20.0f * std::pow(10.0f, normalizedValue * std::log10(10000.0f / 20.0f));
 
-            *filterProcessor.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
+            pfs::BiquadCoefficients::highPass(
                 sampleRate, juce::jlimit(20.0f, 10000.0f, cutoffHz), 0.707f
-            );
+            ).copyTo(*filterProcessor.state);
         }
 
         // Process buffer through filter
@@ -266,24 +208,36 @@ void DriveVerbAudioProcessor::applyFilter(juce::dsp::AudioBlock<float>& block, j
     }
 }
 
+#if PLUGIN_DSP_ONLY
+bool DriveVerbAudioProcessor::hasEditor() const
+{
+    return false;
+}
+
+juce::AudioProcessorEditor* DriveVerbAudioProcessor::createEditor()
+{
+    return nullptr;
+}
+#else
+bool DriveVerbAudioProcessor::hasEditor() const
+{
+    return true;
+}
+
 juce::AudioProcessorEditor* DriveVerbAudioProcessor::createEditor()
 {
     return new DriveVerbAudioProcessorEditor(*this);
 }
+#endif
 
 void DriveVerbAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    stateCodec.save(destData);
 }
 
 void DriveVerbAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState != nullptr && xmlState->hasTagName(parameters.state.getType()))
-        parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    stateCodec.load(data, sizeInBytes);
 }
 
 // Factory function
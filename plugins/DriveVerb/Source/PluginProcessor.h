@@ -1,6 +1,8 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "Parameters.h"
+#include "BiquadDesigner.h"
 
 class DriveVerbAudioProcessor : public juce::AudioProcessor
 {
@@ -13,7 +15,7 @@ public:
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override { return true; }
+    bool hasEditor() const override;
 
     const juce::String getName() const override { return "DriveVerb"; }
     bool acceptsMidi() const override { return false; }
@@ -45,19 +47,22 @@ private:
     juce::dsp::Reverb reverb;
     juce::dsp::DryWetMixer<float> dryWetMixer;
 
-    // Stage 4.2: Drive saturation
-    juce::dsp::WaveShaper<float> driveShaper;
-
     // Stage 4.3: DJ-style filter (low-pass/high-pass with center bypass)
     juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>> filterProcessor;
     bool previousWasLowPass = false;  // Track filter type transitions
 
     // Stage 4.4: Helper methods for PRE/POST routing
-    void applyDrive(juce::dsp::AudioBlock<float>& block, juce::dsp::ProcessContextReplacing<float>& context, float driveValue);
+    void applyDrive(juce::dsp::AudioBlock<float>& block, float driveValue);
     void applyFilter(juce::dsp::AudioBlock<float>& block, juce::dsp::ProcessContextReplacing<float>& context, float filterValue);
 
     // VU meter - drive output level
     std::atomic<float> driveOutputLevelDB { -60.0f };
 
+    // Cached parameter pointers (declared after parameters - resolved from it)
+    DriveVerbParameterCache parameterCache;
+
+    // Binary get/setStateInformation (same table, resolved once)
+    DriveVerbStateCodec stateCodec;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DriveVerbAudioProcessor)
 };
@@ -0,0 +1,467 @@
+#include "Drum808HitCache.h"
+#include <algorithm>
+
+namespace
+{
+    constexpr int pollIntervalMs = 20;
+    constexpr int renderChunkSize = 64;
+    constexpr float silenceRatio = 1.0e-3f;     // -60 dB below the hit's peak...
+    constexpr double silenceSeconds = 0.05;     // ...for 50 ms (a whole cycle of the lowest kick) ends the render
+    constexpr double fadeSeconds = 0.05;        // the last 50 ms fade out, so the cut never clicks
+    constexpr double maxHitSeconds = 10.0;      // past the -60 dB point of the longest decay; cuts the clap tail at about -45 dB
+    constexpr double variantHeadSeconds = 0.25; // noise variants differ for this long (kick burst, clap spikes)...
+    constexpr double crossfadeSeconds = 0.05;   // ...then crossfade into variant 0's shared tail
+    constexpr double stealReleaseSeconds = 0.005;
+    constexpr double levelSmoothingSeconds = 0.005;     // as the live voices' level ramp
+
+    // Each instrument's parameters are a run of four in the table, in instrument order
+    static_assert(static_cast<int>(Drum808Param::LowTomLevel) == static_cast<int>(Drum808Instrument::LowTom) * 4);
+    static_assert(static_cast<int>(Drum808Param::ClapLevel) == static_cast<int>(Drum808Instrument::Clap) * 4);
+    static_assert(static_cast<int>(Drum808Param::OpenHatTuning) == static_cast<int>(Drum808Instrument::OpenHat) * 4 + 3);
+}
+
+//==============================================================================
+Drum808HitCache::Drum808HitCache(juce::AudioProcessorValueTreeState& state, const Drum808ParameterCache& parameters)
+    : juce::Thread("Drum808 hit cache"),
+      valueTreeState(state),
+      parameterCache(parameters),
+      renderBank(std::make_unique<Drum808VoiceBank>()),
+      renderSeed(renderBank->getNoiseSeed())
+{
+    valueTreeState.addParameterListener(drum808ParameterTable[static_cast<size_t>(Drum808Param::CachedVoices)].id, this);
+}
+
+Drum808HitCache::~Drum808HitCache()
+{
+    valueTreeState.removeParameterListener(drum808ParameterTable[static_cast<size_t>(Drum808Param::CachedVoices)].id, this);
+    stopThread(2000);
+}
+
+void Drum808HitCache::prepare(double newSampleRate)
+{
+    stopThread(2000);
+    freeAllHits();
+
+    sampleRate = newSampleRate;
+    releaseStep = static_cast<float>(1.0 / juce::jmax(1.0, stealReleaseSeconds * sampleRate));
+    renderBank->prepare(sampleRate);
+
+    for (auto& level : levels)
+        level.reset(sampleRate, levelSmoothingSeconds);
+
+    isFirstParameterUpdate = true;
+
+    startThread(juce::Thread::Priority::background);
+}
+
+void Drum808HitCache::release()
+{
+    stopThread(2000);
+    freeAllHits();
+}
+
+//==============================================================================
+Drum808Param Drum808HitCache::getLevelParameter(Drum808Instrument instrument) noexcept
+{
+    return static_cast<Drum808Param>(static_cast<int>(instrument) * numParametersPerInstrument);
+}
+
+// Everything but the level, which only scales the hit
+Drum808HitCache::ParameterKey Drum808HitCache::getKey(const Drum808ParameterSnapshot& params, Drum808Instrument instrument) noexcept
+{
+    ParameterKey key;
+    const auto firstKeyParameter = static_cast<int>(getLevelParameter(instrument)) + 1;
+
+    for (int i = 0; i < numKeyParameters; ++i)
+        key[static_cast<size_t>(i)] = params[static_cast<Drum808Param>(firstKeyParameter + i)];
+
+    return key;
+}
+
+// Only the noise-driven instruments differ from hit to hit
+int Drum808HitCache::getNumVariants(Drum808Instrument instrument) noexcept
+{
+    return instrument == Drum808Instrument::Kick || instrument == Drum808Instrument::Clap ? maxNoiseVariants : 1;
+}
+
+//==============================================================================
+void Drum808HitCache::parameterChanged(const juce::String&, float newValue)
+{
+    if (newValue >= 0.5f)
+        notify();
+}
+
+// Polls while the mode is on (or replaced hits still wait to be freed), otherwise
+// sleeps until parameterChanged() switches it on
+void Drum808HitCache::run()
+{
+    while (!threadShouldExit())
+        wait(update() ? pollIntervalMs : -1);
+}
+
+// Re-renders every instrument whose parameters changed; publishes nothing while the mode is off.
+// Returns false when there is nothing left to poll for
+bool Drum808HitCache::update()
+{
+    const auto params = parameterCache.snapshot();
+    const auto isModeEnabled = params.getBool(Drum808Param::CachedVoices);
+
+    for (int i = 0; i < numInstruments; ++i)
+    {
+        const auto instrument = static_cast<Drum808Instrument>(i);
+        const auto& owned = ownedHits[static_cast<size_t>(i)];
+
+        if (!isModeEnabled)
+        {
+            if (owned != nullptr)
+                publish(instrument, nullptr);
+
+            continue;
+        }
+
+        if (owned != nullptr && owned->key == getKey(params, instrument))
+            continue;
+
+        auto hit = renderHit(instrument, params);
+
+        if (hit == nullptr)
+            return false;   // Thread stopping
+
+        publish(instrument, std::move(hit));
+    }
+
+    freeRetiredHits();
+    return isModeEnabled || !retiredHits.empty();
+}
+
+std::unique_ptr<Drum808HitCache::CachedHit> Drum808HitCache::renderHit(Drum808Instrument instrument,
+                                                                       const Drum808ParameterSnapshot& params)
+{
+    const auto numVariants = getNumVariants(instrument);
+
+    // Full level: render() scales the hit by the current one
+    auto renderParams = params;
+    renderParams.values[static_cast<size_t>(getLevelParameter(instrument))] = 100.0f;
+
+    // Variant 0 is rendered whole into scratch buffers (freed on return)
+    std::vector<float> rendered, head;
+
+    if (!renderVariant(instrument, renderParams, 0, static_cast<size_t>(maxHitSeconds * sampleRate), true, rendered))
+        return nullptr;
+
+    // Fade the end out so the cut never clicks
+    const auto length = rendered.size();
+    const auto fadeLength = juce::jmin(length, static_cast<size_t>(fadeSeconds * sampleRate));
+
+    for (size_t i = 0; i < fadeLength; ++i)
+        rendered[length - fadeLength + i] *= 1.0f - static_cast<float>(i + 1) / static_cast<float>(fadeLength);
+
+    const auto headLength = juce::jmin(length, static_cast<size_t>(variantHeadSeconds * sampleRate));
+    const auto crossfadeLength = juce::jmin(headLength, static_cast<size_t>(crossfadeSeconds * sampleRate));
+
+    auto hit = std::make_unique<CachedHit>();
+    hit->key = getKey(params, instrument);
+    hit->heads.setSize(numVariants, static_cast<int>(headLength));
+    hit->heads.copyFrom(0, 0, rendered.data(), static_cast<int>(headLength));
+    hit->tail.setSize(1, static_cast<int>(length - headLength));
+    hit->tail.copyFrom(0, 0, rendered.data() + headLength, static_cast<int>(length - headLength));
+
+    // The other variants' heads, crossfaded into variant 0 so they all continue into its tail
+    for (int variant = 1; variant < numVariants; ++variant)
+    {
+        if (!renderVariant(instrument, renderParams, variant, headLength, false, head))
+            return nullptr;
+
+        for (size_t i = 0; i < crossfadeLength; ++i)
+        {
+            const auto index = headLength - crossfadeLength + i;
+            const auto weight = static_cast<float>(i + 1) / static_cast<float>(crossfadeLength);
+            head[index] += (rendered[index] - head[index]) * weight;
+        }
+
+        hit->heads.copyFrom(variant, 0, head.data(), static_cast<int>(headLength));
+    }
+
+    return hit;
+}
+
+// Renders one hit with the variant's noise into destination, for maxLength samples or, with
+// stopAtSilence, until it has stayed silent for silenceSeconds. Returns false if the thread is stopping
+bool Drum808HitCache::renderVariant(Drum808Instrument instrument, const Drum808ParameterSnapshot& renderParams,
+                                    int variant, size_t maxLength, bool stopAtSilence, std::vector<float>& destination)
+{
+    const auto silenceLength = static_cast<size_t>(silenceSeconds * sampleRate);
+
+    std::array<std::array<float, renderChunkSize>, numInstruments> chunk {};
+    std::array<float*, numInstruments> chunkPointers {};
+
+    for (size_t i = 0; i < chunkPointers.size(); ++i)
+        chunkPointers[i] = chunk[i].data();
+
+    const auto& output = chunk[static_cast<size_t>(instrument)];
+
+    renderBank->setNoiseSeed(renderSeed + static_cast<juce::uint32>(variant));
+    renderBank->reset();
+    renderBank->setParameters(renderParams);
+    renderBank->setVoiceLimit(1);
+    renderBank->trigger(instrument, 1.0f);
+
+    destination.clear();
+    float peak = 0.0f;
+    size_t numSilentSamples = 0;
+
+    while (renderBank->isPlaying(instrument) && destination.size() < maxLength)
+    {
+        if (threadShouldExit())
+            return false;
+
+        renderBank->render(chunkPointers.data(), 0, renderChunkSize);
+        destination.insert(destination.end(), output.begin(), output.end());
+
+        const auto range = juce::FloatVectorOperations::findMinAndMax(output.data(), renderChunkSize);
+        const auto chunkPeak = juce::jmax(-range.getStart(), range.getEnd());
+        peak = juce::jmax(peak, chunkPeak);
+
+        numSilentSamples = chunkPeak <= peak * silenceRatio ? numSilentSamples + renderChunkSize : 0;
+
+        if (stopAtSilence && numSilentSamples >= silenceLength)
+            break;
+    }
+
+    // Whole chunks may overshoot; a head whose voice ended early is padded with silence
+    destination.resize(stopAtSilence ? juce::jmin(destination.size(), maxLength) : maxLength, 0.0f);
+    return true;
+}
+
+// The replaced hit is kept until the audio thread can no longer be using it (freeRetiredHits)
+void Drum808HitCache::publish(Drum808Instrument instrument, std::unique_ptr<CachedHit> hit)
+{
+    const auto index = static_cast<size_t>(instrument);
+    currentHits[index].store(hit.get());
+
+    if (ownedHits[index] != nullptr)
+        retiredHits.push_back({ std::move(ownedHits[index]), numCompletedBlocks.load() });
+
+    ownedHits[index] = std::move(hit);
+}
+
+// Safe once a block has completed since the swap (no trigger can still pick the old pointer
+// up) and every voice that started on it has ended
+void Drum808HitCache::freeRetiredHits()
+{
+    const auto completedBlocks = numCompletedBlocks.load();
+
+    retiredHits.erase(std::remove_if(retiredHits.begin(), retiredHits.end(), [completedBlocks](const RetiredHit& retired)
+                                     {
+                                         return completedBlocks > retired.replacedAfterBlock
+                                             && retired.hit->numUsers.load() == 0;
+                                     }),
+                      retiredHits.end());
+}
+
+// Renderer stopped and audio not running
+void Drum808HitCache::freeAllHits()
+{
+    for (auto& voice : voices)
+        voice = {};
+
+    for (auto& currentHit : currentHits)
+        currentHit.store(nullptr);
+
+    for (auto& owned : ownedHits)
+        owned.reset();
+
+    retiredHits.clear();
+}
+
+//==============================================================================
+void Drum808HitCache::setParameters(const Drum808ParameterSnapshot& params) noexcept
+{
+    isEnabled = params.getBool(Drum808Param::CachedVoices);
+    voiceLimit = juce::jlimit(1, maxVoices, juce::roundToInt(params[Drum808Param::Voices]));
+
+    for (int i = 0; i < numInstruments; ++i)
+    {
+        const auto instrument = static_cast<Drum808Instrument>(i);
+        auto& level = levels[static_cast<size_t>(i)];
+        blockKeys[static_cast<size_t>(i)] = getKey(params, instrument);
+
+        if (isFirstParameterUpdate)
+            level.setCurrentAndTargetValue(params[getLevelParameter(instrument)] / 100.0f);
+        else
+            level.setTargetValue(params[getLevelParameter(instrument)] / 100.0f);
+    }
+
+    isFirstParameterUpdate = false;
+}
+
+bool Drum808HitCache::trigger(Drum808Instrument instrument, float velocity) noexcept
+{
+    if (!isEnabled)
+        return false;
+
+    auto* hit = currentHits[static_cast<size_t>(instrument)].load();
+
+    if (hit == nullptr || hit->key != blockKeys[static_cast<size_t>(instrument)])
+        return false;
+
+    // Over the limit: fade out the oldest sounding voices (one-shots only get quieter).
+    // Hats sound one at a time, as the live voices do
+    const auto limit = instrument >= Drum808Instrument::ClosedHat ? 1 : voiceLimit;
+
+    for (;;)
+    {
+        CachedVoice* oldest = nullptr;
+        int numSounding = 0;
+
+        for (int slot = 0; slot < numVoiceSlots; ++slot)
+        {
+            auto& voice = getVoice(instrument, slot);
+
+            if (voice.hit == nullptr || voice.isReleasing)
+                continue;
+
+            ++numSounding;
+
+            if (oldest == nullptr || static_cast<juce::int32>(voice.triggerOrder - oldest->triggerOrder) < 0)
+                oldest = &voice;
+        }
+
+        if (numSounding < limit)
+            break;
+
+        oldest->isReleasing = true;
+    }
+
+    // A free slot if there is one, otherwise cut the oldest fading voice short
+    CachedVoice* target = nullptr;
+
+    for (int slot = 0; slot < numVoiceSlots; ++slot)
+    {
+        auto& voice = getVoice(instrument, slot);
+
+        if (voice.hit == nullptr)
+        {
+            target = &voice;
+            break;
+        }
+
+        if (target == nullptr || static_cast<juce::int32>(voice.triggerOrder - target->triggerOrder) < 0)
+            target = &voice;
+    }
+
+    if (target->hit != nullptr)
+        endVoice(*target);
+
+    auto& variant = nextVariant[static_cast<size_t>(instrument)];
+    variant = (variant + 1) % hit->heads.getNumChannels();
+
+    hit->numUsers.fetch_add(1);
+    target->hit = hit;
+    target->variant = variant;
+    target->position = 0;
+    target->gain = velocity;
+    target->isReleasing = false;
+    target->release = 1.0f;
+    target->triggerOrder = nextTriggerOrder++;
+    return true;
+}
+
+void Drum808HitCache::stop(Drum808Instrument instrument) noexcept
+{
+    for (int slot = 0; slot < numVoiceSlots; ++slot)
+        if (auto& voice = getVoice(instrument, slot); voice.hit != nullptr)
+            endVoice(voice);
+}
+
+void Drum808HitCache::render(float* const* instrumentOutputs, int startSample, int numSamples) noexcept
+{
+    for (int i = 0; i < numInstruments; ++i)
+    {
+        const auto instrument = static_cast<Drum808Instrument>(i);
+        auto* destination = instrumentOutputs[i] + startSample;
+        auto& level = levels[static_cast<size_t>(i)];
+
+        // Steady level: one gain per voice. While it ramps, per-sample gains in short steps
+        if (!level.isSmoothing())
+        {
+            renderVoices(instrument, destination, numSamples, nullptr, level.getCurrentValue());
+            continue;
+        }
+
+        for (int offset = 0; offset < numSamples; offset += levelChunkSize)
+        {
+            const auto numStepSamples = juce::jmin(levelChunkSize, numSamples - offset);
+
+            for (int s = 0; s < numStepSamples; ++s)
+                levelGains[s] = level.getNextValue();
+
+            renderVoices(instrument, destination + offset, numStepSamples, levelGains, 0.0f);
+        }
+    }
+}
+
+void Drum808HitCache::endBlock() noexcept
+{
+    numCompletedBlocks.fetch_add(1);
+}
+
+//==============================================================================
+Drum808HitCache::CachedVoice& Drum808HitCache::getVoice(Drum808Instrument instrument, int slot) noexcept
+{
+    return voices[static_cast<size_t>(static_cast<int>(instrument) * numVoiceSlots + slot)];
+}
+
+void Drum808HitCache::endVoice(CachedVoice& voice) noexcept
+{
+    voice.hit->numUsers.fetch_sub(1);
+    voice.hit = nullptr;
+}
+
+// Adds the instrument's voices scaled by levelGains (per sample) or, without them, by level
+void Drum808HitCache::renderVoices(Drum808Instrument instrument, float* destination, int numSamples,
+                                   const float* levelGains, float level) noexcept
+{
+    for (int slot = 0; slot < numVoiceSlots; ++slot)
+    {
+        auto& voice = getVoice(instrument, slot);
+
+        if (voice.hit == nullptr)
+            continue;
+
+        // At most two spans per call: the rest of the voice's own head, then the shared tail
+        for (int offset = 0; offset < numSamples && voice.hit != nullptr;)
+        {
+            const auto& hit = *voice.hit;
+            const auto headLength = hit.heads.getNumSamples();
+            const auto isInHead = voice.position < headLength;
+            const auto* source = isInHead ? hit.heads.getReadPointer(voice.variant, voice.position)
+                                          : hit.tail.getReadPointer(0, voice.position - headLength);
+            const auto spanEnd = isInHead ? headLength : hit.getNumSamples();
+            const auto numToCopy = juce::jmin(numSamples - offset, spanEnd - voice.position);
+
+            if (!voice.isReleasing && levelGains == nullptr)
+            {
+                juce::FloatVectorOperations::addWithMultiply(destination + offset, source, voice.gain * level, numToCopy);
+            }
+            else
+            {
+                // Stolen voices: linear fade to silence over stealReleaseSeconds (release stays 1 otherwise)
+                for (int s = 0; s < numToCopy && voice.release > 0.0f; ++s)
+                {
+                    const auto gain = levelGains != nullptr ? levelGains[offset + s] : level;
+                    destination[offset + s] += source[s] * voice.gain * gain * voice.release;
+
+                    if (voice.isReleasing)
+                        voice.release -= releaseStep;
+                }
+            }
+
+            voice.position += numToCopy;
+            offset += numToCopy;
+
+            if (voice.position >= hit.getNumSamples() || (voice.isReleasing && voice.release <= 0.0f))
+                endVoice(voice);
+        }
+    }
+}
@@ -0,0 +1,161 @@
+#pragma once
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "Drum808Voices.h"
+#include "Parameters.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+    "Cached voices" mode: each instrument's one-shot, pre-rendered and played
+    back as samples.
+
+    With the body voices starting from rest, a hit is a fixed function of its
+    instrument's tone, decay and tuning and the sample rate, scaled by level
+    and velocity - apart from noise, which is covered by a few renders with
+    different noise seeds, played round-robin (kick, clap). Only the first
+    quarter second of each variant is kept (the kick's noise burst, the clap's
+    spikes); they crossfade into one tail that all of them share. Hats render
+    from a fresh operator bank. Hits are rendered at full level; the level is
+    applied on playback, smoothed like the live voices', so moving it never
+    re-renders.
+
+    A background thread polls the parameters and re-renders an instrument
+    whenever its key values change, with a private Drum808VoiceBank. A render
+    runs until the hit has stayed 60 dB below its peak for 50 ms (10 s at
+    most), then fades out. The live voices ring on below that; the cache keeps
+    only the audible part, to bound its memory, and frees its render scratch
+    after every hit. While the mode is off the thread sleeps until it is
+    switched on.
+
+    The audio thread only triggers a cached hit whose parameters match the
+    current block; otherwise (mode just enabled, a knob still moving)
+    trigger() returns false and the caller synthesises the hit live.
+
+    Hits are published through an atomic pointer and never freed under the
+    audio thread: a replaced hit is deleted once no voice plays it and a
+    whole block has completed since it was replaced.
+*/
+class Drum808HitCache : private juce::Thread,
+                        private juce::AudioProcessorValueTreeState::Listener
+{
+public:
+    Drum808HitCache(juce::AudioProcessorValueTreeState& state, const Drum808ParameterCache& parameters);
+    ~Drum808HitCache() override;
+
+    /** Message thread, audio stopped: drops every hit and restarts the renderer at this sample rate. */
+    void prepare(double sampleRate);
+
+    /** Message thread, audio stopped: stops the renderer and frees every hit. */
+    void release();
+
+    //==============================================================================
+    /** Audio thread, once per block before any trigger. */
+    void setParameters(const Drum808ParameterSnapshot& params) noexcept;
+
+    /** Starts a cached hit, or returns false when there is no up-to-date one (synthesise it instead). */
+    bool trigger(Drum808Instrument instrument, float velocity) noexcept;
+
+    /** Cuts every cached voice of the instrument immediately (choke). */
+    void stop(Drum808Instrument instrument) noexcept;
+
+    /** Adds [startSample, startSample + numSamples) of every playing cached voice into instrumentOutputs. */
+    void render(float* const* instrumentOutputs, int startSample, int numSamples) noexcept;
+
+    /** Audio thread, at the end of every block: lets the renderer free replaced hits. */
+    void endBlock() noexcept;
+
+private:
+    //==============================================================================
+    static constexpr int numInstruments = Drum808VoiceBank::numInstruments;
+    static constexpr int maxVoices = Drum808VoiceBank::maxVoicesPerInstrument;
+    static constexpr int numVoiceSlots = Drum808VoiceBank::numVoiceSlots;     // maxVoices + spare release slots
+    static constexpr int numParametersPerInstrument = 4;     // level, then the three the hit is rendered from
+    static constexpr int numKeyParameters = numParametersPerInstrument - 1;
+    static constexpr int maxNoiseVariants = 4;
+    static constexpr int levelChunkSize = 64;                 // playback step while a level ramp runs
+
+    using ParameterKey = std::array<float, numKeyParameters>;
+
+    struct CachedHit
+    {
+        ParameterKey key {};
+        juce::AudioBuffer<float> heads;         // one channel per noise variant: its first variantHeadSeconds, velocity 1
+        juce::AudioBuffer<float> tail;          // the rest, shared by every variant (variant 0's)
+        std::atomic<int> numUsers { 0 };        // voices playing it (audio thread)
+
+        int getNumSamples() const noexcept      { return heads.getNumSamples() + tail.getNumSamples(); }
+    };
+
+    struct RetiredHit
+    {
+        std::unique_ptr<CachedHit> hit;
+        juce::uint64 replacedAfterBlock = 0;
+    };
+
+    struct CachedVoice
+    {
+        CachedHit* hit = nullptr;
+        int variant = 0;
+        int position = 0;
+        float gain = 0.0f;
+        bool isReleasing = false;               // stolen: fading out
+        float release = 1.0f;
+        juce::uint32 triggerOrder = 0;
+    };
+
+    //==============================================================================
+    static Drum808Param getLevelParameter(Drum808Instrument instrument) noexcept;
+    static ParameterKey getKey(const Drum808ParameterSnapshot& params, Drum808Instrument instrument) noexcept;
+    static int getNumVariants(Drum808Instrument instrument) noexcept;
+
+    // Wakes the parked renderer when the mode is switched on (any thread)
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+    // Renderer thread
+    void run() override;
+    bool update();
+    std::unique_ptr<CachedHit> renderHit(Drum808Instrument instrument, const Drum808ParameterSnapshot& params);
+    bool renderVariant(Drum808Instrument instrument, const Drum808ParameterSnapshot& renderParams, int variant,
+                       size_t maxLength, bool stopAtSilence, std::vector<float>& destination);
+    void publish(Drum808Instrument instrument, std::unique_ptr<CachedHit> hit);
+    void freeRetiredHits();
+    void freeAllHits();
+
+    // Audio thread
+    CachedVoice& getVoice(Drum808Instrument instrument, int slot) noexcept;
+    void endVoice(CachedVoice& voice) noexcept;
+    void renderVoices(Drum808Instrument instrument, float* destination, int numSamples,
+                      const float* levelGains, float level) noexcept;
+
+    //==============================================================================
+    juce::AudioProcessorValueTreeState& valueTreeState;
+    const Drum808ParameterCache& parameterCache;
+    double sampleRate = 44100.0;
+
+    // Published hits (written by the renderer, read by the audio thread)
+    std::array<std::atomic<CachedHit*>, numInstruments> currentHits {};
+    std::atomic<juce::uint64> numCompletedBlocks { 0 };
+
+    // Renderer thread only
+    std::array<std::unique_ptr<CachedHit>, numInstruments> ownedHits;
+    std::vector<RetiredHit> retiredHits;
+    std::unique_ptr<Drum808VoiceBank> renderBank;
+    juce::uint32 renderSeed = 0;            // renderBank's own noise seed; variant v renders with renderSeed + v
+
+    // Audio thread only
+    std::array<ParameterKey, numInstruments> blockKeys {};
+    std::array<CachedVoice, numInstruments * numVoiceSlots> voices {};
+    std::array<int, numInstruments> nextVariant {};
+    std::array<juce::SmoothedValue<float>, numInstruments> levels;
+    float levelGains[levelChunkSize];
+    bool isFirstParameterUpdate = true;         // set by prepare(): jump straight to the levels
+    bool isEnabled = false;
+    int voiceLimit = maxVoices;
+    juce::uint32 nextTriggerOrder = 0;
+    float releaseStep = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE(Drum808HitCache)
+};
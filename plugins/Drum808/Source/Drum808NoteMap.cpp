@@ -0,0 +1,209 @@
+#include "Drum808NoteMap.h"
+
+namespace
+{
+    static_assert(Drum808NoteMap::numInstruments <= 8, "Choke groups are 8-bit instrument masks");
+
+    constexpr const char* instrumentNames[] = { "kick", "lowtom", "midtom", "clap", "closedhat", "openhat" };
+    static_assert(std::size(instrumentNames) == static_cast<size_t>(Drum808Instrument::Count));
+
+    juce::uint8 getMask(Drum808Instrument instrument) noexcept
+    {
+        return static_cast<juce::uint8>(1u << static_cast<int>(instrument));
+    }
+}
+
+//==============================================================================
+Drum808NoteMap::Drum808NoteMap()
+{
+    resetToDefault();
+}
+
+void Drum808NoteMap::resetToDefault()
+{
+    const juce::ScopedLock sl(lock);
+
+    setDefaults(notes, chokes);
+    compileAll();
+}
+
+//==============================================================================
+void Drum808NoteMap::setNote(int note, std::optional<Drum808Instrument> instrument)
+{
+    jassert(juce::isPositiveAndBelow(note, numNotes));
+    const juce::ScopedLock sl(lock);
+
+    notes[static_cast<size_t>(note)] = instrument;
+    compile(note);
+}
+
+std::optional<Drum808Instrument> Drum808NoteMap::getNote(int note) const
+{
+    jassert(juce::isPositiveAndBelow(note, numNotes));
+    const juce::ScopedLock sl(lock);
+
+    return notes[static_cast<size_t>(note)];
+}
+
+void Drum808NoteMap::setChokes(Drum808Instrument instrument, juce::uint8 chokedInstruments)
+{
+    const juce::ScopedLock sl(lock);
+
+    chokes[static_cast<size_t>(instrument)] = static_cast<juce::uint8>(chokedInstruments & ((1u << numInstruments) - 1u));
+    compileAll();
+}
+
+juce::uint8 Drum808NoteMap::getChokes(Drum808Instrument instrument) const
+{
+    const juce::ScopedLock sl(lock);
+
+    return chokes[static_cast<size_t>(instrument)];
+}
+
+//==============================================================================
+juce::String Drum808NoteMap::noteMapToString() const
+{
+    const juce::ScopedLock sl(lock);
+    juce::StringArray entries;
+
+    for (int note = 0; note < numNotes; ++note)
+        if (const auto instrument = notes[static_cast<size_t>(note)])
+            entries.add(juce::String(note) + ":" + getInstrumentName(*instrument));
+
+    return entries.joinIntoString(",");
+}
+
+juce::String Drum808NoteMap::chokesToString() const
+{
+    const juce::ScopedLock sl(lock);
+    juce::StringArray entries;
+
+    for (int instrument = 0; instrument < numInstruments; ++instrument)
+        for (int choked = 0; choked < numInstruments; ++choked)
+            if ((chokes[static_cast<size_t>(instrument)] & getMask(static_cast<Drum808Instrument>(choked))) != 0)
+                entries.add(juce::String(getInstrumentName(static_cast<Drum808Instrument>(instrument))) + ":"
+                            + getInstrumentName(static_cast<Drum808Instrument>(choked)));
+
+    return entries.joinIntoString(",");
+}
+
+void Drum808NoteMap::setNoteMapFromString(const juce::String& text)
+{
+    const juce::ScopedLock sl(lock);
+
+    parseNoteMap(text, notes);
+    compileAll();
+}
+
+void Drum808NoteMap::setChokesFromString(const juce::String& text)
+{
+    const juce::ScopedLock sl(lock);
+
+    parseChokes(text, chokes);
+    compileAll();
+}
+
+// Parsed into locals first: the lock is held only for the copy and the one compile
+void Drum808NoteMap::setFromState(const std::optional<juce::String>& noteMapText, const std::optional<juce::String>& chokesText)
+{
+    NoteArray newNotes;
+    ChokeArray newChokes;
+    setDefaults(newNotes, newChokes);
+
+    if (noteMapText.has_value())
+        parseNoteMap(*noteMapText, newNotes);
+
+    if (chokesText.has_value())
+        parseChokes(*chokesText, newChokes);
+
+    const juce::ScopedLock sl(lock);
+    notes = newNotes;
+    chokes = newChokes;
+    compileAll();
+}
+
+//==============================================================================
+void Drum808NoteMap::setDefaults(NoteArray& noteArray, ChokeArray& chokeArray)
+{
+    noteArray.fill(std::nullopt);
+    noteArray[36] = Drum808Instrument::Kick;        // C1
+    noteArray[38] = Drum808Instrument::Clap;        // D1
+    noteArray[41] = Drum808Instrument::LowTom;      // F1
+    noteArray[42] = Drum808Instrument::ClosedHat;   // F#1
+    noteArray[45] = Drum808Instrument::MidTom;      // A1
+    noteArray[46] = Drum808Instrument::OpenHat;     // A#1
+
+    chokeArray.fill(0);
+    chokeArray[static_cast<size_t>(Drum808Instrument::ClosedHat)] = getMask(Drum808Instrument::OpenHat);
+}
+
+void Drum808NoteMap::parseNoteMap(const juce::String& text, NoteArray& noteArray)
+{
+    noteArray.fill(std::nullopt);
+
+    for (const auto& entry : juce::StringArray::fromTokens(text, ",", {}))
+    {
+        const auto noteText = entry.upToFirstOccurrenceOf(":", false, false).trim();
+        const auto note = noteText.getIntValue();
+        const auto instrument = findInstrument(entry.fromFirstOccurrenceOf(":", false, false).trim());
+
+        if (noteText.isNotEmpty() && noteText.containsOnly("0123456789") && juce::isPositiveAndBelow(note, numNotes) && instrument.has_value())
+            noteArray[static_cast<size_t>(note)] = instrument;
+    }
+}
+
+void Drum808NoteMap::parseChokes(const juce::String& text, ChokeArray& chokeArray)
+{
+    chokeArray.fill(0);
+
+    for (const auto& entry : juce::StringArray::fromTokens(text, ",", {}))
+    {
+        const auto instrument = findInstrument(entry.upToFirstOccurrenceOf(":", false, false).trim());
+        const auto choked = findInstrument(entry.fromFirstOccurrenceOf(":", false, false).trim());
+
+        if (instrument.has_value() && choked.has_value())
+            chokeArray[static_cast<size_t>(*instrument)] |= getMask(*choked);
+    }
+}
+
+const char* Drum808NoteMap::getInstrumentName(Drum808Instrument instrument) noexcept
+{
+    return instrumentNames[static_cast<size_t>(instrument)];
+}
+
+std::optional<Drum808Instrument> Drum808NoteMap::findInstrument(const juce::String& name) noexcept
+{
+    for (int i = 0; i < numInstruments; ++i)
+        if (name == instrumentNames[i])
+            return static_cast<Drum808Instrument>(i);
+
+    return std::nullopt;
+}
+
+// One note's instrument and that instrument's choke mask, packed
+juce::uint16 Drum808NoteMap::getEntry(int note) const noexcept
+{
+    const auto instrument = notes[static_cast<size_t>(note)];
+
+    return instrument.has_value()
+               ? static_cast<juce::uint16>(static_cast<int>(*instrument) | (chokes[static_cast<size_t>(*instrument)] << 8))
+               : unmapped;
+}
+
+// A single entry is one atomic store, so it goes straight into the active table
+void Drum808NoteMap::compile(int note)
+{
+    auto& table = tables[static_cast<size_t>(activeTable.load(std::memory_order_relaxed))];
+    table[static_cast<size_t>(note)].store(getEntry(note), std::memory_order_relaxed);
+}
+
+void Drum808NoteMap::compileAll()
+{
+    const auto next = 1 - activeTable.load(std::memory_order_relaxed);
+    auto& table = tables[static_cast<size_t>(next)];
+
+    for (int note = 0; note < numNotes; ++note)
+        table[static_cast<size_t>(note)].store(getEntry(note), std::memory_order_relaxed);
+
+    activeTable.store(next, std::memory_order_release);
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include "Drum808Voices.h"
+#include <array>
+#include <atomic>
+#include <optional>
+
+//==============================================================================
+/**
+    Drum808's MIDI note → instrument assignment and choke groups, compiled into
+    a flat 128-entry dispatch table for the audio thread.
+
+    The editable mapping lives on the message thread: any number of notes may
+    play the same instrument, and each instrument has a bitmask of the
+    instruments it cuts when it is triggered (bit i = Drum808Instrument i). By
+    default the notes are the 808 layout (36 kick, 38 clap, 41 low tom,
+    42 closed hat, 45 mid tom, 46 open hat) and the closed hat chokes the open hat.
+
+    Every edit recompiles the affected notes into packed atomic entries
+    (instrument + choke mask), so a note-on is one relaxed load and no branch
+    chain. A note whose entry changes between two events simply uses the new one.
+    Edits that touch many notes (chokes, a restored state) compile a whole
+    second table and publish it with one index swap, so the audio thread never
+    sees half of a new mapping.
+
+    The mapping is saved in the plugin state as two strings, e.g.
+        noteMap  "36:kick,38:clap,41:lowtom,42:closedhat,45:midtom,46:openhat"
+        chokes   "closedhat:openhat"
+*/
+class Drum808NoteMap
+{
+public:
+    static constexpr int numNotes = 128;
+    static constexpr int numInstruments = Drum808VoiceBank::numInstruments;
+
+    /** What a note-on does: cut the choked instruments, then trigger the instrument (if any). */
+    struct Action
+    {
+        std::optional<Drum808Instrument> instrument;
+        juce::uint8 chokes = 0;
+    };
+
+    Drum808NoteMap();
+
+    //==============================================================================
+    /** Audio thread: the compiled entry for a note number (0 - 127). */
+    Action getAction(int note) const noexcept
+    {
+        const auto& table = tables[static_cast<size_t>(activeTable.load(std::memory_order_acquire))];
+        const auto entry = table[static_cast<size_t>(note & (numNotes - 1))].load(std::memory_order_relaxed);
+        const auto instrument = static_cast<int>(entry & 0xff);
+
+        if (instrument >= numInstruments)
+            return {};
+
+        return { static_cast<Drum808Instrument>(instrument), static_cast<juce::uint8>(entry >> 8) };
+    }
+
+    //==============================================================================
+    // Message thread
+    void resetToDefault();
+
+    /** Assigns a note to an instrument, or unmaps it (std::nullopt). */
+    void setNote(int note, std::optional<Drum808Instrument> instrument);
+    std::optional<Drum808Instrument> getNote(int note) const;
+
+    /** The instruments (bitmask) cut whenever this instrument is triggered. */
+    void setChokes(Drum808Instrument instrument, juce::uint8 chokedInstruments);
+    juce::uint8 getChokes(Drum808Instrument instrument) const;
+
+    //==============================================================================
+    // State strings (see above)
+    static constexpr const char* noteMapStateKey = "noteMap";
+    static constexpr const char* chokesStateKey = "chokes";
+
+    juce::String noteMapToString() const;
+    juce::String chokesToString() const;
+
+    /** Replace the mapping or choke groups; unknown instrument names and out-of-range notes are skipped. */
+    void setNoteMapFromString(const juce::String& text);
+    void setChokesFromString(const juce::String& text);
+
+    /** Restores both from a saved state in one publish; a missing string keeps the default 808 layout for it. */
+    void setFromState(const std::optional<juce::String>& noteMapText, const std::optional<juce::String>& chokesText);
+
+    /** "kick", "lowtom", ... - the names used in the state strings (and by the UI's LEDs). */
+    static const char* getInstrumentName(Drum808Instrument instrument) noexcept;
+
+private:
+    //==============================================================================
+    static constexpr juce::uint16 unmapped = 0xff;
+
+    using NoteArray = std::array<std::optional<Drum808Instrument>, numNotes>;
+    using ChokeArray = std::array<juce::uint8, numInstruments>;
+    using CompiledTable = std::array<std::atomic<juce::uint16>, numNotes>;
+
+    static void setDefaults(NoteArray& noteArray, ChokeArray& chokeArray);
+    static void parseNoteMap(const juce::String& text, NoteArray& noteArray);
+    static void parseChokes(const juce::String& text, ChokeArray& chokeArray);
+    static std::optional<Drum808Instrument> findInstrument(const juce::String& name) noexcept;
+
+    juce::uint16 getEntry(int note) const noexcept;
+    void compile(int note);
+    void compileAll();
+
+    //==============================================================================
+    // Editable mapping (message thread; the lock only orders the writers and state saves)
+    juce::CriticalSection lock;
+    std::array<std::optional<Drum808Instrument>, numNotes> notes;
+    std::array<juce::uint8, numInstruments> chokes {};
+
+    // Compiled tables (read by the audio thread): instrument in the low byte (unmapped = 0xff), choke
+    // mask in the high byte. compileAll() fills the inactive one, then swaps activeTable
+    std::array<CompiledTable, 2> tables {};
+    std::atomic<int> activeTable { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(Drum808NoteMap)
+};
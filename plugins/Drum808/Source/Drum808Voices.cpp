@@ -0,0 +1,849 @@
+#include "Drum808Voices.h"
+#include <atomic>
+
+namespace
+{
+    // Hi-hat operator frequency ratios (inharmonic, metallic spectrum)
+    constexpr float hatRatios[] = { 1.0f, 1.4f, 1.7f, 2.1f, 2.5f, 3.0f };
+
+    constexpr float hatFilterQ = 4.0f;          // High Q for metallic ring
+    constexpr float silenceThreshold = 1e-8f;   // Voices stop below this (denormal protection)
+    constexpr float clapSilenceThreshold = 1e-4f;
+    constexpr double stealReleaseSeconds = 0.005; // Fade-out of a stolen voice
+
+    // First noise seed of the next bank constructed (process-wide)
+    std::atomic<juce::uint32> nextNoiseSeed { 0x808u };
+
+    // Index of the lowest set bit of a non-zero slot mask
+    int getLowestSlot(juce::uint32 slots) noexcept
+    {
+        return juce::countNumberOfBits((slots & (0u - slots)) - 1u);
+    }
+
+    // PolyBLEP residual of a -1 -> +1 step at phase 0, for a phase advancing by
+    // increment (< 0.5) per sample: smooths the discontinuity over one sample
+    // either side, which removes most of the aliasing of a naive square.
+    // Subtract it for a +1 -> -1 step.
+    template <typename T>
+    T polyBlep(T phase, T increment, T inverseIncrement) noexcept
+    {
+        using namespace pfs::simd;
+        const auto one = broadcast<T>(1.0f);
+
+        const auto afterEdge = phase * inverseIncrement;
+        const auto beforeEdge = (phase - one) * inverseIncrement;
+
+        return select(lessThan(phase, increment), afterEdge + afterEdge - afterEdge * afterEdge - one,
+                      select(greaterThan(phase, one - increment), beforeEdge * beforeEdge + beforeEdge + beforeEdge + one,
+                             broadcast<T>(0.0f)));
+    }
+
+    template <typename SmoothedValueType>
+    void snapToTarget(SmoothedValueType& value) noexcept
+    {
+        value.setCurrentAndTargetValue(value.getTargetValue());
+    }
+
+    // Adds one lane of an interleaved [sample][lane] array to a mono buffer
+    void addLane(const float* lanes, int numLanes, int lane, float* destination, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            destination[i] += lanes[i * numLanes + lane];
+    }
+}
+
+//==============================================================================
+// Each bank takes a run of numNoiseSeeds seeds, so no two banks share a voice's noise
+Drum808VoiceBank::Drum808VoiceBank() noexcept
+    : noiseSeed(nextNoiseSeed.fetch_add(numNoiseSeeds, std::memory_order_relaxed))
+{
+}
+
+void Drum808VoiceBank::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    samplePeriod = 1.0f / static_cast<float>(sampleRate);
+
+    // Clap spike transitions (sample-rate independent)
+    clapSpike2StartSample = static_cast<int>(sampleRate * 0.010);  // 10ms
+    clapSpike3StartSample = static_cast<int>(sampleRate * 0.020);  // 20ms
+    clapDecayStartSample = static_cast<int>(sampleRate * 0.030);   // 30ms
+
+    // Fixed envelope time constants
+    kickPitchCoefficient = getDecayCoefficient(0.02);   // 2x -> 1x pitch sweep
+    kickAttackCoefficient = getDecayCoefficient(0.005); // attack noise burst
+    clapSpikeCoefficient = getDecayCoefficient(0.003);
+    clapTailCoefficient = getDecayCoefficient(1.934);
+    stealReleaseStep = static_cast<float>(1.0 / juce::jmax(1.0, stealReleaseSeconds * sampleRate));
+
+    // Decay coefficients depend on the sample rate: force setParameters to recompute them
+    for (auto& instrumentSettings : settings)
+    {
+        instrumentSettings.decaySeconds = 0.0f;
+        instrumentSettings.baseFrequency = 0.0f;
+    }
+
+    for (auto& values : smoothed)
+    {
+        values.level.reset(sampleRate, smoothingSeconds);
+        values.filterFrequency.reset(sampleRate, smoothingSeconds);
+        values.filterQ.reset(sampleRate, smoothingSeconds);
+        values.hatFrequency.reset(sampleRate, smoothingSeconds);
+    }
+
+    // Per-lane signal routing (padding lanes stay silent)
+    body = {};
+    bodyChunk = {};
+    hats = {};
+
+    for (auto& hat : hats)
+        std::fill(hat.mixGain, hat.mixGain + numHatOperators, 1.0f / static_cast<float>(numHatOperators));
+
+    // The kick's pitch sweep runs through juce::dsp::Oscillator's 50ms frequency
+    // ramp, re-targeted every sample: a one-pole glide of 1/steps per sample
+    const auto kickSmoothing = 1.0f / static_cast<float>(juce::jmax(1, static_cast<int>(std::floor(0.05 * sampleRate))));
+
+    for (auto instrument : { Drum808Instrument::Kick, Drum808Instrument::LowTom,
+                             Drum808Instrument::MidTom, Drum808Instrument::Clap })
+    {
+        const auto isKick = instrument == Drum808Instrument::Kick;
+
+        for (int slot = 0; slot < numVoiceSlots; ++slot)
+        {
+            const auto lane = getBodyLane(instrument, slot);
+
+            body.sineGain[lane] = instrument == Drum808Instrument::Clap ? 0.0f : 1.0f;
+            body.dryGain[lane] = isKick ? 1.0f : 0.0f;
+            body.bandpassGain[lane] = isKick ? 0.0f : 1.0f;
+            body.frequencySmoothing[lane] = isKick ? kickSmoothing : 0.0f;
+
+            // Kick runs unfiltered: a pass-through SVF keeps its lanes' filter state at zero
+            if (isKick)
+                setFilter(body.g[lane], body.gPlusR2[lane], body.h[lane], 0.0f, 1.0f);
+        }
+    }
+
+    reset();
+}
+
+void Drum808VoiceBank::reset() noexcept
+{
+    for (auto& voice : voices)
+        voice = {};
+
+    for (auto& pool : pools)
+        pool = {};
+
+    nextTriggerOrder = 0;
+    smoothingInstruments = 0;
+    isFirstParameterUpdate = true;
+
+    for (int slot = 0; slot < numVoiceSlots; ++slot)
+    {
+        kickNoise[static_cast<size_t>(slot)].setSeed(noiseSeed + static_cast<juce::uint32>(slot));
+        clapNoise[static_cast<size_t>(slot)].setSeed(noiseSeed + static_cast<juce::uint32>(numVoiceSlots + slot));
+    }
+
+    std::fill(std::begin(body.phase), std::end(body.phase), 0.0f);
+    std::fill(std::begin(body.frequency), std::end(body.frequency), 0.0f);
+    std::fill(std::begin(body.s1), std::end(body.s1), 0.0f);
+    std::fill(std::begin(body.s2), std::end(body.s2), 0.0f);
+
+    for (auto& hat : hats)
+    {
+        std::fill(std::begin(hat.phase), std::end(hat.phase), 0.0f);
+        hat.s1 = 0.0f;
+        hat.s2 = 0.0f;
+    }
+}
+
+//==============================================================================
+void Drum808VoiceBank::setParameters(const Drum808ParameterSnapshot& params) noexcept
+{
+    auto& kickSettings = getSettings(Drum808Instrument::Kick);
+    kickSettings.tone = params[Drum808Param::KickTone] / 100.0f;
+    setDecay(Drum808Instrument::Kick, params[Drum808Param::KickDecay] / 1000.0f);
+    kickSettings.baseFrequency = 60.0f * std::pow(2.0f, params[Drum808Param::KickTuning] / 12.0f);
+    getSmoothed(Drum808Instrument::Kick).level.setTargetValue(params[Drum808Param::KickLevel] / 100.0f);
+
+    auto& lowTomSettings = getSettings(Drum808Instrument::LowTom);
+    auto& lowTomSmoothed = getSmoothed(Drum808Instrument::LowTom);
+    setDecay(Drum808Instrument::LowTom, params[Drum808Param::LowTomDecay] / 1000.0f);
+    lowTomSettings.baseFrequency = 150.0f * std::pow(2.0f, params[Drum808Param::LowTomTuning] / 12.0f);
+    lowTomSmoothed.level.setTargetValue(params[Drum808Param::LowTomLevel] / 100.0f);
+    lowTomSmoothed.filterFrequency.setTargetValue(lowTomSettings.baseFrequency);
+    lowTomSmoothed.filterQ.setTargetValue(0.5f + (params[Drum808Param::LowTomTone] / 100.0f * 4.5f));
+
+    auto& midTomSettings = getSettings(Drum808Instrument::MidTom);
+    auto& midTomSmoothed = getSmoothed(Drum808Instrument::MidTom);
+    setDecay(Drum808Instrument::MidTom, params[Drum808Param::MidTomDecay] / 1000.0f);
+    midTomSettings.baseFrequency = 220.0f * std::pow(2.0f, params[Drum808Param::MidTomTuning] / 12.0f);
+    midTomSmoothed.level.setTargetValue(params[Drum808Param::MidTomLevel] / 100.0f);
+    midTomSmoothed.filterFrequency.setTargetValue(midTomSettings.baseFrequency);
+    midTomSmoothed.filterQ.setTargetValue(0.5f + (params[Drum808Param::MidTomTone] / 100.0f * 4.5f));
+
+    auto& clapSmoothed = getSmoothed(Drum808Instrument::Clap);
+    clapSmoothed.level.setTargetValue(params[Drum808Param::ClapLevel] / 100.0f);
+    clapSmoothed.filterFrequency.setTargetValue(1000.0f * std::pow(2.0f, params[Drum808Param::ClapTuning] / 12.0f));
+    clapSmoothed.filterQ.setTargetValue(2.0f + (params[Drum808Param::ClapTone] / 100.0f * 3.0f)); // Q range 2.0-5.0
+    clapSnap = params[Drum808Param::ClapSnap] / 100.0f;
+
+    auto& closedHatSmoothed = getSmoothed(Drum808Instrument::ClosedHat);
+    setDecay(Drum808Instrument::ClosedHat, params[Drum808Param::ClosedHatDecay] / 1000.0f);
+    closedHatSmoothed.level.setTargetValue(params[Drum808Param::ClosedHatLevel] / 100.0f);
+    closedHatSmoothed.hatFrequency.setTargetValue(3500.0f * std::pow(2.0f, params[Drum808Param::ClosedHatTuning] / 12.0f));
+    closedHatSmoothed.filterFrequency.setTargetValue(6000.0f + (params[Drum808Param::ClosedHatTone] / 100.0f * 6000.0f)); // 6-12 kHz
+    closedHatSmoothed.filterQ.setTargetValue(hatFilterQ);
+
+    auto& openHatSmoothed = getSmoothed(Drum808Instrument::OpenHat);
+    setDecay(Drum808Instrument::OpenHat, params[Drum808Param::OpenHatDecay] / 1000.0f);
+    openHatSmoothed.level.setTargetValue(params[Drum808Param::OpenHatLevel] / 100.0f);
+    openHatSmoothed.hatFrequency.setTargetValue(3500.0f * std::pow(2.0f, params[Drum808Param::OpenHatTuning] / 12.0f));
+    openHatSmoothed.filterFrequency.setTargetValue(6000.0f + (params[Drum808Param::OpenHatTone] / 100.0f * 6000.0f));
+    openHatSmoothed.filterQ.setTargetValue(hatFilterQ);
+
+    setVoiceLimit(juce::roundToInt(params[Drum808Param::Voices]));
+
+    // Unchanged targets leave their smoothers idle: nothing to recompute. After reset() the
+    // targets are applied at once; otherwise render() ramps to them
+    for (int i = 0; i < numInstruments; ++i)
+    {
+        const auto instrument = static_cast<Drum808Instrument>(i);
+        auto& values = getSmoothed(instrument);
+
+        if (isFirstParameterUpdate)
+        {
+            snapToTarget(values.level);
+            snapToTarget(values.filterFrequency);
+            snapToTarget(values.filterQ);
+            snapToTarget(values.hatFrequency);
+            applySmoothedValues(instrument);
+        }
+        else if (isSmoothing(values))
+        {
+            smoothingInstruments |= 1u << i;
+        }
+    }
+
+    isFirstParameterUpdate = false;
+}
+
+void Drum808VoiceBank::setVoiceLimit(int numVoices) noexcept
+{
+    voiceLimit = juce::jlimit(1, maxVoicesPerInstrument, numVoices);
+}
+
+void Drum808VoiceBank::trigger(Drum808Instrument instrument, float velocity) noexcept
+{
+    auto& pool = getPool(instrument);
+
+    // Hat voices are envelopes on one shared set of operators, so overlapping them would
+    // only add level: a hat sounds one voice at a time and a retrigger fades out the last
+    const auto limit = isHat(instrument) ? 1 : voiceLimit;
+
+    // Release voices until the new one fits under the limit (more than one if the limit was lowered)
+    for (auto sounding = pool.playing & ~pool.releasing;
+         juce::countNumberOfBits(sounding) >= limit;
+         sounding = pool.playing & ~pool.releasing)
+    {
+        const auto slot = findVoiceToSteal(instrument, sounding);
+        auto& stolen = getVoice(instrument, slot);
+        stolen.isReleasing = true;
+        pool.releasing |= 1u << slot;
+    }
+
+    // A free slot if there is one, otherwise cut the quietest fading voice short
+    const auto freeSlots = ~pool.playing & allSlots;
+    const auto slot = freeSlots != 0 ? getLowestSlot(freeSlots) : findVoiceToSteal(instrument, pool.releasing);
+
+    startVoice(instrument, slot, velocity);
+}
+
+void Drum808VoiceBank::stop(Drum808Instrument instrument) noexcept
+{
+    for (auto playing = getPool(instrument).playing; playing != 0; playing &= playing - 1u)
+        stopVoice(instrument, getLowestSlot(playing));
+}
+
+//==============================================================================
+// Current envelope level, for picking the voice to steal
+float Drum808VoiceBank::getLoudness(const VoiceControl& voice) const noexcept
+{
+    // The clap's spikes each restart its envelope: treat it as loud until the tail
+    const auto envelope = voice.clapStage == ClapStage::Spike1 || voice.clapStage == ClapStage::Spike2
+                               || voice.clapStage == ClapStage::Spike3 ? 1.0f : voice.envelope;
+
+    return envelope * voice.velocity * voice.release;
+}
+
+// Quietest of the candidate slots, the oldest on a tie (candidates must not be empty)
+int Drum808VoiceBank::findVoiceToSteal(Drum808Instrument instrument, juce::uint32 candidates) noexcept
+{
+    jassert(candidates != 0);
+
+    auto bestSlot = getLowestSlot(candidates);
+    auto bestLoudness = getLoudness(getVoice(instrument, bestSlot));
+
+    for (candidates &= candidates - 1u; candidates != 0; candidates &= candidates - 1u)
+    {
+        const auto slot = getLowestSlot(candidates);
+        const auto& voice = getVoice(instrument, slot);
+        const auto loudness = getLoudness(voice);
+
+        // Trigger order is compared as a difference so it survives wrapping
+        if (loudness < bestLoudness
+            || (loudness == bestLoudness
+                && static_cast<juce::int32>(voice.triggerOrder - getVoice(instrument, bestSlot).triggerOrder) < 0))
+        {
+            bestSlot = slot;
+            bestLoudness = loudness;
+        }
+    }
+
+    return bestSlot;
+}
+
+void Drum808VoiceBank::startVoice(Drum808Instrument instrument, int slot, float velocity) noexcept
+{
+    auto& pool = getPool(instrument);
+    pool.playing |= 1u << slot;
+    pool.releasing &= ~(1u << slot);
+
+    auto& voice = getVoice(instrument, slot);
+    voice = {};
+    voice.isPlaying = true;
+    voice.triggerOrder = nextTriggerOrder++;
+    voice.velocity = velocity;
+    voice.envelope = 1.0f;
+    voice.pitchEnvelope = 1.0f;
+    voice.attackEnvelope = 1.0f;
+
+    // Hat voices are envelopes on the shared operators; a body voice starts from
+    // rest: oscillator at its zero crossing, filter empty
+    if (!isHat(instrument))
+    {
+        const auto lane = getBodyLane(instrument, slot);
+        body.phase[lane] = 0.0f;
+        body.s1[lane] = 0.0f;
+        body.s2[lane] = 0.0f;
+
+        if (instrument == Drum808Instrument::Clap)
+            voice.clapStage = ClapStage::Spike1;
+        else if (instrument == Drum808Instrument::Kick)
+            body.frequency[lane] = getSettings(instrument).baseFrequency * 2.0f;   // top of the sweep
+        else
+            body.frequency[lane] = getSettings(instrument).baseFrequency;          // toms hold the pitch they were struck at
+
+        updateOutputGain(instrument, slot);
+    }
+}
+
+void Drum808VoiceBank::stopVoice(Drum808Instrument instrument, int slot) noexcept
+{
+    auto& pool = getPool(instrument);
+    pool.playing &= ~(1u << slot);
+    pool.releasing &= ~(1u << slot);
+
+    auto& voice = getVoice(instrument, slot);
+    voice.isPlaying = false;
+    voice.isReleasing = false;
+    voice.envelope = 0.0f;
+    voice.envelopeSample = 0;
+    voice.clapStage = ClapStage::Idle;
+}
+
+// Stolen voices: linear fade to silence over stealReleaseSeconds
+void Drum808VoiceBank::applyRelease(VoiceControl& voice, float* amplitude, int stride, int numSamples) const noexcept
+{
+    auto release = voice.release;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        amplitude[i * stride] *= release;
+        release = juce::jmax(0.0f, release - stealReleaseStep);
+    }
+
+    voice.release = release;
+}
+
+//==============================================================================
+void Drum808VoiceBank::render(float* const* instrumentOutputs, int startSample, int numSamples) noexcept
+{
+    for (int i = 0; i < numInstruments; ++i)
+        juce::FloatVectorOperations::clear(instrumentOutputs[i] + startSample, numSamples);
+
+    for (int offset = 0; offset < numSamples;)
+    {
+        // Steady state: whole chunks and no coefficient work. While a ramp runs,
+        // shorter steps, each with freshly smoothed coefficients
+        const auto stepSize = smoothingInstruments != 0 ? smoothingStepSize : chunkSize;
+        const auto numChunkSamples = juce::jmin(stepSize, numSamples - offset);
+        const auto chunkStart = startSample + offset;
+        offset += numChunkSamples;
+
+        if (smoothingInstruments != 0)
+            advanceSmoothing(numChunkSamples);
+
+        // Voices start and stop only between chunks: a lane either plays the whole chunk or none of it
+        if (fillBodyChunk(numChunkSamples))
+        {
+            renderBodyLanes<pfs::simd::NativeLanes>(numChunkSamples);
+
+            for (int lane = 0; lane < numBodyVoices; ++lane)
+                if (bodyChunk.running[lane] != 0.0f)
+                    addLane(bodyChunk.output, numBodyLanes, lane,
+                            instrumentOutputs[lane / numVoiceSlots] + chunkStart, numChunkSamples);
+        }
+
+        for (auto instrument : { Drum808Instrument::ClosedHat, Drum808Instrument::OpenHat })
+            if (fillHatChunk(instrument, numChunkSamples))
+                renderHat<pfs::simd::NativeLanes>(hats[static_cast<size_t>(getHatIndex(instrument))], hatAmplitude,
+                                                  instrumentOutputs[static_cast<int>(instrument)] + chunkStart, numChunkSamples);
+    }
+}
+
+//==============================================================================
+// exp(-t / decay) advanced one sample
+float Drum808VoiceBank::getDecayCoefficient(double decaySeconds) const noexcept
+{
+    return static_cast<float>(std::exp(-1.0 / (decaySeconds * sampleRate)));
+}
+
+// Only recomputes the coefficient when the decay actually changed
+void Drum808VoiceBank::setDecay(Drum808Instrument instrument, float decaySeconds) noexcept
+{
+    auto& instrumentSettings = getSettings(instrument);
+
+    if (decaySeconds != instrumentSettings.decaySeconds)
+    {
+        instrumentSettings.decaySeconds = decaySeconds;
+        instrumentSettings.decayCoefficient = getDecayCoefficient(decaySeconds);
+    }
+}
+
+void Drum808VoiceBank::setFilter(float& g, float& gPlusR2, float& h, float cutoff, float q) const noexcept
+{
+    // juce::dsp::StateVariableTPTFilter::update()
+    const auto gain = static_cast<float>(std::tan(juce::MathConstants<double>::pi * cutoff / sampleRate));
+    const auto r2 = static_cast<float>(1.0 / q);
+
+    g = gain;
+    gPlusR2 = gain + r2;
+    h = static_cast<float>(1.0 / (1.0 + r2 * gain + gain * gain));
+}
+
+// Operator increments only change with tuning (or sample rate)
+void Drum808VoiceBank::setHatTuning(Drum808Instrument instrument, float baseFrequency) noexcept
+{
+    auto& hatSettings = getSettings(instrument);
+
+    if (baseFrequency == hatSettings.baseFrequency)
+        return;
+
+    hatSettings.baseFrequency = baseFrequency;
+    auto& hat = hats[static_cast<size_t>(getHatIndex(instrument))];
+
+    for (int op = 0; op < numHatOperators; ++op)
+    {
+        // In cycles; operators above Nyquist (low sample rates, top tuning) are pinned just below it
+        const auto increment = juce::jlimit(1.0e-6f, 0.49f, baseFrequency * hatRatios[op] * samplePeriod);
+
+        hat.increment[op] = increment;
+        hat.inverseIncrement[op] = 1.0f / increment;
+    }
+}
+
+// Body lanes only: hats take velocity in their summed envelope
+void Drum808VoiceBank::updateOutputGain(Drum808Instrument instrument, int slot) noexcept
+{
+    body.outputGain[getBodyLane(instrument, slot)] = getVoice(instrument, slot).velocity * getSettings(instrument).level;
+}
+
+bool Drum808VoiceBank::isSmoothing(const SmoothedSettings& values) noexcept
+{
+    return values.level.isSmoothing() || values.filterFrequency.isSmoothing()
+        || values.filterQ.isSmoothing() || values.hatFrequency.isSmoothing();
+}
+
+// Moves every ramping instrument on by numSamples and recomputes what depends on it
+void Drum808VoiceBank::advanceSmoothing(int numSamples) noexcept
+{
+    for (auto moving = smoothingInstruments; moving != 0; moving &= moving - 1u)
+    {
+        const auto index = getLowestSlot(moving);
+        auto& values = smoothed[static_cast<size_t>(index)];
+
+        values.level.skip(numSamples);
+        values.filterFrequency.skip(numSamples);
+        values.filterQ.skip(numSamples);
+        values.hatFrequency.skip(numSamples);
+        applySmoothedValues(static_cast<Drum808Instrument>(index));
+
+        if (!isSmoothing(values))
+            smoothingInstruments &= ~(1u << index);
+    }
+}
+
+// Output gain, filter coefficients (shared by all of an instrument's lanes) and hat operator increments
+void Drum808VoiceBank::applySmoothedValues(Drum808Instrument instrument) noexcept
+{
+    const auto& values = getSmoothed(instrument);
+    getSettings(instrument).level = values.level.getCurrentValue();
+
+    if (isHat(instrument))
+    {
+        auto& hat = hats[static_cast<size_t>(getHatIndex(instrument))];
+        hat.outputGain = values.level.getCurrentValue();
+        setFilter(hat.g, hat.gPlusR2, hat.h, values.filterFrequency.getCurrentValue(), values.filterQ.getCurrentValue());
+        setHatTuning(instrument, values.hatFrequency.getCurrentValue());
+        return;
+    }
+
+    for (int slot = 0; slot < numVoiceSlots; ++slot)
+        updateOutputGain(instrument, slot);
+
+    // The kick's lanes keep their pass-through filter
+    if (instrument == Drum808Instrument::Kick)
+        return;
+
+    const auto firstLane = getBodyLane(instrument, 0);
+    setFilter(body.g[firstLane], body.gPlusR2[firstLane], body.h[firstLane],
+              values.filterFrequency.getCurrentValue(), values.filterQ.getCurrentValue());
+
+    for (int slot = 1; slot < numVoiceSlots; ++slot)
+    {
+        const auto lane = getBodyLane(instrument, slot);
+        body.g[lane] = body.g[firstLane];
+        body.gPlusR2[lane] = body.gPlusR2[firstLane];
+        body.h[lane] = body.h[firstLane];
+    }
+}
+
+//==============================================================================
+bool Drum808VoiceBank::fillBodyChunk(int numSamples) noexcept
+{
+    std::fill(std::begin(bodyChunk.running), std::end(bodyChunk.running), 0.0f);
+    bool anyRunning = false;
+
+    for (auto instrument : { Drum808Instrument::Kick, Drum808Instrument::LowTom,
+                             Drum808Instrument::MidTom, Drum808Instrument::Clap })
+    {
+        for (auto playing = getPool(instrument).playing; playing != 0; playing &= playing - 1u)
+        {
+            const auto slot = getLowestSlot(playing);
+            const auto lane = getBodyLane(instrument, slot);
+            bool isRunning = false;
+
+            if (instrument == Drum808Instrument::Kick)
+                isRunning = fillKick(slot, numSamples);
+            else if (instrument == Drum808Instrument::Clap)
+                isRunning = fillClap(slot, numSamples);
+            else
+                isRunning = fillExponentialVoice(instrument, slot, bodyChunk.amplitude + lane, numBodyLanes, numSamples);
+
+            bodyChunk.running[lane] = isRunning ? 1.0f : 0.0f;
+            anyRunning |= isRunning;
+        }
+    }
+
+    return anyRunning;
+}
+
+// Sums the envelopes of a hat's playing voices, each scaled by its velocity, into hatAmplitude
+bool Drum808VoiceBank::fillHatChunk(Drum808Instrument instrument, int numSamples) noexcept
+{
+    bool anyRunning = false;
+
+    for (auto playing = getPool(instrument).playing; playing != 0; playing &= playing - 1u)
+    {
+        const auto slot = getLowestSlot(playing);
+
+        if (!fillExponentialVoice(instrument, slot, hatVoiceAmplitude, 1, numSamples))
+            continue;
+
+        const auto velocity = getVoice(instrument, slot).velocity;
+
+        if (anyRunning)
+            juce::FloatVectorOperations::addWithMultiply(hatAmplitude, hatVoiceAmplitude, velocity, numSamples);
+        else
+            juce::FloatVectorOperations::multiply(hatAmplitude, hatVoiceAmplitude, velocity, numSamples);
+
+        anyRunning = true;
+    }
+
+    return anyRunning;
+}
+
+// Toms and hats: plain exponential decay
+// amplitude[i * stride] receives the envelope; returns false when the voice is silent this chunk
+bool Drum808VoiceBank::fillExponentialVoice(Drum808Instrument instrument, int slot, float* amplitude, int stride, int numSamples) noexcept
+{
+    auto& voice = getVoice(instrument, slot);
+
+    if (!voice.isPlaying)
+        return false;
+
+    if (voice.envelope < silenceThreshold || voice.release <= 0.0f)
+    {
+        stopVoice(instrument, slot);
+        return false;
+    }
+
+    const auto coefficient = getSettings(instrument).decayCoefficient;
+    auto envelope = voice.envelope;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        amplitude[i * stride] = envelope;
+        envelope *= coefficient;
+    }
+
+    voice.envelope = envelope;
+
+    if (voice.isReleasing)
+        applyRelease(voice, amplitude, stride, numSamples);
+
+    return true;
+}
+
+bool Drum808VoiceBank::fillKick(int slot, int numSamples) noexcept
+{
+    auto& voice = getVoice(Drum808Instrument::Kick, slot);
+
+    if (!voice.isPlaying)
+        return false;
+
+    if (voice.envelope < silenceThreshold || voice.release <= 0.0f)
+    {
+        stopVoice(Drum808Instrument::Kick, slot);
+        return false;
+    }
+
+    const auto& kickSettings = getSettings(Drum808Instrument::Kick);
+    const auto lane = getBodyLane(Drum808Instrument::Kick, slot);
+    const auto attackGain = kickSettings.tone;
+    auto envelope = voice.envelope;
+    auto pitchEnvelope = voice.pitchEnvelope;
+    auto attackEnvelope = voice.attackEnvelope;
+
+    kickNoise[static_cast<size_t>(slot)].fill(noiseChunk, numSamples);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto index = i * numBodyLanes + lane;
+
+        // Pitch envelope: exponential sweep from 2x to 1x base frequency
+        bodyChunk.targetFrequency[index] = kickSettings.baseFrequency * (1.0f + pitchEnvelope);
+
+        // Attack transient (noise burst scaled by tone parameter)
+        bodyChunk.noise[index] = noiseChunk[i] * attackEnvelope * attackGain;
+
+        bodyChunk.amplitude[index] = envelope;
+
+        envelope *= kickSettings.decayCoefficient;
+        pitchEnvelope *= kickPitchCoefficient;
+        attackEnvelope *= kickAttackCoefficient;
+    }
+
+    voice.envelope = envelope;
+    voice.pitchEnvelope = pitchEnvelope;
+    voice.attackEnvelope = attackEnvelope;
+
+    if (voice.isReleasing)
+        applyRelease(voice, bodyChunk.amplitude + lane, numBodyLanes, numSamples);
+
+    return true;
+}
+
+// Multi-trigger envelope: three decaying spikes 10ms apart, then a long tail.
+// voice.envelope is the current stage's decay, restarted at 1 on each stage change
+bool Drum808VoiceBank::fillClap(int slot, int numSamples) noexcept
+{
+    auto& voice = getVoice(Drum808Instrument::Clap, slot);
+
+    if (!voice.isPlaying)
+        return false;
+
+    if ((voice.clapStage == ClapStage::Decay && voice.envelope < clapSilenceThreshold) || voice.release <= 0.0f)
+    {
+        stopVoice(Drum808Instrument::Clap, slot);
+        return false;
+    }
+
+    const auto lane = getBodyLane(Drum808Instrument::Clap, slot);
+
+    clapNoise[static_cast<size_t>(slot)].fill(noiseChunk, numSamples);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto index = i * numBodyLanes + lane;
+        const auto t = voice.envelopeSample;
+        float envelope = voice.envelope;
+
+        bodyChunk.noise[index] = noiseChunk[i];
+
+        if (voice.clapStage == ClapStage::Spike1)
+        {
+            envelope *= clapSnap;
+
+            if (t >= clapSpike2StartSample)
+            {
+                voice.clapStage = ClapStage::Spike2;
+                voice.envelope = 1.0f;
+            }
+        }
+        else if (voice.clapStage == ClapStage::Spike2)
+        {
+            envelope *= clapSnap * 0.6f;
+
+            if (t >= clapSpike3StartSample)
+            {
+                voice.clapStage = ClapStage::Spike3;
+                voice.envelope = 1.0f;
+            }
+        }
+        else if (voice.clapStage == ClapStage::Spike3)
+        {
+            envelope *= clapSnap * 0.3f;
+
+            if (t >= clapDecayStartSample)
+            {
+                voice.clapStage = ClapStage::Decay;
+                voice.envelope = 1.0f;
+            }
+        }
+
+        bodyChunk.amplitude[index] = envelope;
+
+        voice.envelope *= voice.clapStage == ClapStage::Decay ? clapTailCoefficient : clapSpikeCoefficient;
+        voice.envelopeSample++;
+    }
+
+    if (voice.isReleasing)
+        applyRelease(voice, bodyChunk.amplitude + lane, numBodyLanes, numSamples);
+
+    return true;
+}
+
+//==============================================================================
+template <typename Lanes>
+void Drum808VoiceBank::renderBodyLanes(int numSamples) noexcept
+{
+    using namespace pfs::simd;
+    constexpr int width = std::is_same_v<Lanes, float> ? 1 : laneWidth;
+
+    const auto zero = broadcast<Lanes>(0.0f);
+    const auto period = broadcast<Lanes>(samplePeriod);
+
+    for (int lane = 0; lane < numBodyLanes; lane += width)
+    {
+        if (std::all_of(bodyChunk.running + lane, bodyChunk.running + lane + width, [](float r) { return r == 0.0f; }))
+            continue;
+
+        // Stopped lanes hold their oscillator and filter state
+        const auto running = greaterThan(load<Lanes>(bodyChunk.running + lane), zero);
+
+        auto phase = load<Lanes>(body.phase + lane);
+        auto frequency = load<Lanes>(body.frequency + lane);
+        auto s1 = load<Lanes>(body.s1 + lane);
+        auto s2 = load<Lanes>(body.s2 + lane);
+
+        const auto smoothing = load<Lanes>(body.frequencySmoothing + lane);
+        const auto sineGain = load<Lanes>(body.sineGain + lane);
+        const auto dryGain = load<Lanes>(body.dryGain + lane);
+        const auto bandpassGain = load<Lanes>(body.bandpassGain + lane);
+        const auto outputGain = load<Lanes>(body.outputGain + lane);
+        const auto g = load<Lanes>(body.g + lane);
+        const auto gPlusR2 = load<Lanes>(body.gPlusR2 + lane);
+        const auto h = load<Lanes>(body.h + lane);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto index = i * numBodyLanes + lane;
+
+            // Oscillator output uses the phase before this sample's increment (as juce::dsp::Oscillator)
+            const auto input = sineFromPhase(phase) * sineGain + load<Lanes>(bodyChunk.noise + index);
+            const auto nextFrequency = frequency + (load<Lanes>(bodyChunk.targetFrequency + index) - frequency) * smoothing;
+
+            // TPT state variable filter, bandpass output
+            const auto yHP = h * (input - s1 * gPlusR2 - s2);
+            const auto yBP = yHP * g + s1;
+            const auto nextS1 = yHP * g + yBP;
+            const auto yLP = yBP * g + s2;
+            const auto nextS2 = yBP * g + yLP;
+
+            store(bodyChunk.output + index,
+                  (input * dryGain + yBP * bandpassGain) * load<Lanes>(bodyChunk.amplitude + index) * outputGain);
+
+            phase = select(running, wrapPhase(phase + nextFrequency * period), phase);
+            frequency = select(running, nextFrequency, frequency);
+            s1 = select(running, nextS1, s1);
+            s2 = select(running, nextS2, s2);
+        }
+
+        store(body.phase + lane, phase);
+        store(body.frequency + lane, frequency);
+        store(body.s1 + lane, s1);
+        store(body.s2 + lane, s2);
+    }
+}
+
+// One playing hat: its operators are rendered lane-parallel and summed, then one filter
+template <typename Lanes>
+void Drum808VoiceBank::renderHat(HatOperators& hat, const float* amplitude, float* destination, int numSamples) noexcept
+{
+    using namespace pfs::simd;
+    constexpr int width = std::is_same_v<Lanes, float> ? 1 : laneWidth;
+    constexpr int numVectors = numHatOperatorLanes / width;
+
+    const auto half = broadcast<Lanes>(0.5f);
+    const auto one = broadcast<Lanes>(1.0f);
+    const auto minusOne = broadcast<Lanes>(-1.0f);
+
+    Lanes phase[numVectors], increment[numVectors], inverseIncrement[numVectors], mixGain[numVectors];
+
+    for (int v = 0; v < numVectors; ++v)
+    {
+        phase[v] = load<Lanes>(hat.phase + v * width);
+        increment[v] = load<Lanes>(hat.increment + v * width);
+        inverseIncrement[v] = load<Lanes>(hat.inverseIncrement + v * width);
+        mixGain[v] = load<Lanes>(hat.mixGain + v * width);
+    }
+
+    auto s1 = hat.s1;
+    auto s2 = hat.s2;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Band-limited squares, each -1 for the first half of its cycle: naive value,
+        // plus the residual of the rising edge at 0.5, minus that of the falling edge at 0
+        auto mix = broadcast<Lanes>(0.0f);
+
+        for (int v = 0; v < numVectors; ++v)
+        {
+            const auto halfCyclePhase = wrapPhase(phase[v] + half);
+            const auto edges = polyBlep(halfCyclePhase, increment[v], inverseIncrement[v])
+                             - polyBlep(phase[v], increment[v], inverseIncrement[v]);
+
+            mix = mix + (select(lessThan(phase[v], half), minusOne, one) + edges) * mixGain[v];
+            phase[v] = wrapPhase(phase[v] + increment[v]);
+        }
+
+        const auto input = sumLanes(mix);
+
+        // TPT state variable filter, bandpass output
+        const auto yHP = hat.h * (input - s1 * hat.gPlusR2 - s2);
+        const auto yBP = yHP * hat.g + s1;
+        s1 = yHP * hat.g + yBP;
+        const auto yLP = yBP * hat.g + s2;
+        s2 = yBP * hat.g + yLP;
+
+        destination[i] += yBP * amplitude[i] * hat.outputGain;
+    }
+
+    for (int v = 0; v < numVectors; ++v)
+        store(hat.phase + v * width, phase[v]);
+
+    hat.s1 = s1;
+    hat.s2 = s2;
+}
@@ -0,0 +1,290 @@
+#pragma once
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_dsp/juce_dsp.h>
+#include "NoiseGenerator.h"
+#include "Parameters.h"
+#include "SimdLanes.h"
+#include <array>
+
+// The six instruments, in output-bus order (bus 1 = Kick ... bus 6 = Open Hat)
+enum class Drum808Instrument : juce::uint8 { Kick, LowTom, MidTom, Clap, ClosedHat, OpenHat, Count };
+
+//==============================================================================
+/**
+    Drum808's voice engine.
+
+    Voices are rendered lane-parallel with pfs::simd vectors instead of one
+    voice at a time per sample:
+
+        body lanes: one lane per voice (kick, low tom, mid tom, clap)
+            sine oscillator (kick: swept pitch) + noise -> SVF bandpass -> envelope
+        hat operators: one lane per operator of a hat voice (closed, open)
+            six PolyBLEP squares, summed -> SVF bandpass -> envelope
+
+    Every instrument owns a fixed pool of numVoiceSlots voices, of which
+    setVoiceLimit() lets up to maxVoicesPerInstrument sound at once, so a
+    retrigger no longer restarts the ringing voice. Allocation is constant
+    time (a bitmask of free slots); over the limit, the quietest voice (oldest
+    on a tie) is stolen and fades out over a short linear release instead of
+    cutting, in one of the numReleaseSlots slots beyond the limit. Only when
+    those are all still fading is the quietest of them cut short.
+    Body voices each take a lane. Hat voices share their instrument's
+    operators and filter: a hat voice is only an envelope on the one rendered
+    hat. Summing envelopes there would just make rolls louder, so the limit
+    does not apply to hats: each hit fades out the one before it, like the
+    stolen voices above.
+
+    Work is done in chunks of up to chunkSize samples: a scalar pass advances
+    each playing voice's envelope and noise into per-sample arrays, then the
+    vector loops run the oscillators and filters. Body lanes that are not
+    playing keep their oscillator and filter state frozen, exactly like the
+    per-voice objects this replaces; silent hats are skipped.
+
+    Envelopes are multiplicative recurrences (no per-sample exp); a voice is
+    stopped at the first chunk that starts below the silence threshold.
+
+    Level, tone (filter cutoff and Q) and hat tuning ramp to new values over
+    smoothingSeconds instead of jumping, so automating them does not zipper.
+    While a ramp runs, render() works in smoothingStepSize steps and
+    recomputes the moving instruments' coefficients before each one; once
+    every ramp has arrived it skips all coefficient work, and setParameters()
+    only starts ramps for values that changed. Decay (continuous either way)
+    and pitch (the kick glides, toms keep their strike pitch) apply as before.
+
+    Output matches the previous juce::dsp::Oscillator / StateVariableTPTFilter
+    voices within float rounding, except that every hit starts a fresh voice
+    (body oscillator at its zero crossing on its target pitch, filters empty),
+    hat tuning changes apply immediately, and the hat squares are band-limited
+    (PolyBLEP) instead of naive.
+*/
+class Drum808VoiceBank
+{
+public:
+    static constexpr int numInstruments = static_cast<int>(Drum808Instrument::Count);
+
+    /** Takes a noise seed no other bank in the process has, so instances don't play identical noise. */
+    Drum808VoiceBank() noexcept;
+
+    void prepare(double sampleRate);
+
+    /** Silences every voice and restarts the noise sources, so renders are reproducible.
+        The next setParameters() applies its values without ramping.
+    */
+    void reset() noexcept;
+
+    /** Seed the noise sources restart from in reset() (different seeds: different noise).
+        Offline renders and restored sessions set it to reproduce a render exactly.
+    */
+    void setNoiseSeed(juce::uint32 seed) noexcept                   { noiseSeed = seed; }
+    juce::uint32 getNoiseSeed() const noexcept                      { return noiseSeed; }
+
+    static constexpr const char* noiseSeedStateKey = "noiseSeed";
+
+    /** Block rate: maps the parameter snapshot to per-lane synthesis values. */
+    void setParameters(const Drum808ParameterSnapshot& params) noexcept;
+
+    /** How many voices of each body instrument may sound at once (1 - maxVoicesPerInstrument); hats always sound one. */
+    void setVoiceLimit(int numVoices) noexcept;
+
+    /** Starts a new voice of the instrument, stealing one if it is at the voice limit. */
+    void trigger(Drum808Instrument instrument, float velocity) noexcept;
+
+    /** Cuts every voice of the instrument immediately (choke). */
+    void stop(Drum808Instrument instrument) noexcept;
+
+    bool isPlaying(Drum808Instrument instrument) const noexcept     { return pools[static_cast<size_t>(instrument)].playing != 0; }
+
+    /** Renders [startSample, startSample + numSamples) of every instrument into
+        instrumentOutputs[instrument] (mono, overwritten).
+    */
+    void render(float* const* instrumentOutputs, int startSample, int numSamples) noexcept;
+
+    static constexpr int maxVoicesPerInstrument = 8;
+
+    // Spare slots a stolen voice fades out in, so a steal at the full voice
+    // limit still releases instead of cutting the voice it just stole
+    static constexpr int numReleaseSlots = 2;
+    static constexpr int numVoiceSlots = maxVoicesPerInstrument + numReleaseSlots;
+
+private:
+    //==============================================================================
+    static constexpr int chunkSize = 64;
+    static constexpr int smoothingStepSize = 16;        // coefficient update interval while a ramp runs
+    static constexpr double smoothingSeconds = 0.005;
+    static constexpr int numHatOperators = 6;
+
+    static constexpr int numBodyInstruments = 4;    // kick, low tom, mid tom, clap
+    static constexpr int numHatInstruments = 2;     // closed hat, open hat
+    static constexpr int numBodyVoices = numBodyInstruments * numVoiceSlots;
+    static constexpr int numBodyLanes = pfs::simd::roundUpToLanes(numBodyVoices);
+    static constexpr int numHatOperatorLanes = pfs::simd::roundUpToLanes(numHatOperators);
+
+    static constexpr juce::uint32 allSlots = (1u << numVoiceSlots) - 1u;
+
+    enum class ClapStage { Spike1, Spike2, Spike3, Decay, Idle };
+
+    // Per-voice envelope state, advanced by the scalar pass. Envelopes are
+    // exponential decays run as recurrences (value *= coefficient per sample)
+    struct VoiceControl
+    {
+        bool isPlaying = false;
+        bool isReleasing = false;               // stolen: fading out
+        float release = 1.0f;                   // release ramp gain, 1 -> 0
+        juce::uint32 triggerOrder = 0;          // for oldest-first stealing
+
+        float velocity = 0.0f;
+        float envelope = 0.0f;                  // amplitude (clap: current spike / tail)
+
+        float pitchEnvelope = 0.0f;             // kick only
+        float attackEnvelope = 0.0f;            // kick only
+
+        int envelopeSample = 0;                 // clap only
+        ClapStage clapStage = ClapStage::Idle;
+    };
+
+    // Oscillator + SVF state and coefficients, one entry per lane
+    struct alignas(pfs::simd::laneAlignment) BodyLanes
+    {
+        float phase[numBodyLanes] {};           // cycles, [0, 1)
+        float frequency[numBodyLanes] {};       // Hz
+        float frequencySmoothing[numBodyLanes] {};
+        float sineGain[numBodyLanes] {};
+        float dryGain[numBodyLanes] {};
+        float bandpassGain[numBodyLanes] {};
+        float outputGain[numBodyLanes] {};      // velocity * level
+
+        float s1[numBodyLanes] {}, s2[numBodyLanes] {};
+        float g[numBodyLanes] {}, gPlusR2[numBodyLanes] {}, h[numBodyLanes] {};
+    };
+
+    // One hat instrument: its six operators side by side in the lanes (padding lanes have zero gain)
+    struct alignas(pfs::simd::laneAlignment) HatOperators
+    {
+        float phase[numHatOperatorLanes] {};
+        float increment[numHatOperatorLanes] {};
+        float inverseIncrement[numHatOperatorLanes] {};  // 1 / PolyBLEP width
+        float mixGain[numHatOperatorLanes] {};
+
+        float s1 = 0.0f, s2 = 0.0f;
+        float g = 0.0f, gPlusR2 = 0.0f, h = 0.0f;
+        float outputGain = 0.0f;                // level (velocity is in the summed envelopes)
+    };
+
+    // Per-sample body lane inputs for one chunk, interleaved [sample][lane].
+    // Only playing lanes are written; the others keep stale (finite) values that
+    // their vector computes and discards
+    struct alignas(pfs::simd::laneAlignment) BodyChunk
+    {
+        float running[numBodyLanes];            // 1 if the voice plays this chunk (voices stop only between chunks)
+        float amplitude[chunkSize * numBodyLanes];
+        float noise[chunkSize * numBodyLanes];  // already scaled by its envelope
+        float targetFrequency[chunkSize * numBodyLanes];
+        float output[chunkSize * numBodyLanes];
+    };
+
+    // Block-rate values from setParameters (level: the smoothed value currently applied)
+    struct InstrumentSettings
+    {
+        float level = 0.0f;
+        float tone = 0.0f;
+        float decaySeconds = 0.0f;
+        float decayCoefficient = 0.0f;          // per-sample factor for decaySeconds
+        float baseFrequency = 0.0f;             // body: pitch; hats: operator base frequency currently applied
+    };
+
+    // Ramped block-rate values of one instrument (see the class description)
+    struct SmoothedSettings
+    {
+        juce::SmoothedValue<float> level;
+        juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> filterFrequency { 1000.0f };
+        juce::SmoothedValue<float> filterQ { 0.5f };
+        juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> hatFrequency { 3500.0f };   // hats only
+    };
+
+    // Slot bitmasks of one instrument's voice pool
+    struct VoicePool
+    {
+        juce::uint32 playing = 0;
+        juce::uint32 releasing = 0;
+    };
+
+    //==============================================================================
+    // Body lanes are grouped by instrument, so the low slots a pool hands out first share vectors
+    static int getBodyLane(Drum808Instrument instrument, int slot) noexcept { return static_cast<int>(instrument) * numVoiceSlots + slot; }
+    static int getHatIndex(Drum808Instrument instrument) noexcept   { return static_cast<int>(instrument) - numBodyInstruments; }
+    static bool isHat(Drum808Instrument instrument) noexcept        { return instrument >= Drum808Instrument::ClosedHat; }
+
+    VoiceControl& getVoice(Drum808Instrument instrument, int slot) noexcept
+    {
+        return voices[static_cast<size_t>(static_cast<int>(instrument) * numVoiceSlots + slot)];
+    }
+
+    VoicePool& getPool(Drum808Instrument instrument) noexcept              { return pools[static_cast<size_t>(instrument)]; }
+    InstrumentSettings& getSettings(Drum808Instrument instrument) noexcept { return settings[static_cast<size_t>(instrument)]; }
+    SmoothedSettings& getSmoothed(Drum808Instrument instrument) noexcept   { return smoothed[static_cast<size_t>(instrument)]; }
+
+    float getDecayCoefficient(double decaySeconds) const noexcept;
+    void setDecay(Drum808Instrument instrument, float decaySeconds) noexcept;
+    void setFilter(float& g, float& gPlusR2, float& h, float cutoff, float q) const noexcept;
+    void setHatTuning(Drum808Instrument instrument, float baseFrequency) noexcept;
+    void updateOutputGain(Drum808Instrument instrument, int slot) noexcept;
+
+    static bool isSmoothing(const SmoothedSettings& values) noexcept;
+    void advanceSmoothing(int numSamples) noexcept;
+    void applySmoothedValues(Drum808Instrument instrument) noexcept;
+
+    float getLoudness(const VoiceControl& voice) const noexcept;
+    int findVoiceToSteal(Drum808Instrument instrument, juce::uint32 candidates) noexcept;
+    void startVoice(Drum808Instrument instrument, int slot, float velocity) noexcept;
+    void stopVoice(Drum808Instrument instrument, int slot) noexcept;
+    void applyRelease(VoiceControl& voice, float* amplitude, int stride, int numSamples) const noexcept;
+
+    bool fillBodyChunk(int numSamples) noexcept;
+    bool fillHatChunk(Drum808Instrument instrument, int numSamples) noexcept;
+    bool fillExponentialVoice(Drum808Instrument instrument, int slot, float* amplitude, int stride, int numSamples) noexcept;
+    bool fillKick(int slot, int numSamples) noexcept;
+    bool fillClap(int slot, int numSamples) noexcept;
+
+    template <typename Lanes> void renderBodyLanes(int numSamples) noexcept;
+    template <typename Lanes> void renderHat(HatOperators& hat, const float* amplitude,
+                                             float* destination, int numSamples) noexcept;
+
+    //==============================================================================
+    double sampleRate = 44100.0;
+    float samplePeriod = 1.0f / 44100.0f;
+
+    std::array<VoiceControl, numInstruments * numVoiceSlots> voices {};
+    std::array<VoicePool, numInstruments> pools {};
+    std::array<InstrumentSettings, numInstruments> settings {};
+    std::array<SmoothedSettings, numInstruments> smoothed {};
+    juce::uint32 smoothingInstruments = 0;      // bitmask of instruments with a ramp still running
+    bool isFirstParameterUpdate = true;         // set by reset(): jump straight to the targets
+
+    int voiceLimit = maxVoicesPerInstrument;
+    juce::uint32 nextTriggerOrder = 0;
+    float stealReleaseStep = 0.0f;              // per-sample release ramp decrement
+
+    float kickPitchCoefficient = 0.0f;
+    float kickAttackCoefficient = 0.0f;
+    float clapSpikeCoefficient = 0.0f;
+    float clapTailCoefficient = 0.0f;
+
+    float clapSnap = 0.0f;
+    int clapSpike2StartSample = 0;
+    int clapSpike3StartSample = 0;
+    int clapDecayStartSample = 0;
+
+    // One noise source per kick and clap voice, seeded in reset() from
+    // noiseSeed + slot (kick) and noiseSeed + numVoiceSlots + slot (clap)
+    static constexpr juce::uint32 numNoiseSeeds = 2 * numVoiceSlots;
+    juce::uint32 noiseSeed;
+    std::array<pfs::NoiseGenerator, numVoiceSlots> kickNoise;
+    std::array<pfs::NoiseGenerator, numVoiceSlots> clapNoise;
+
+    BodyLanes body;
+    BodyChunk bodyChunk;
+    std::array<HatOperators, numHatInstruments> hats {};
+    alignas(pfs::simd::laneAlignment) float hatAmplitude[chunkSize];        // sum of a hat's voice envelopes
+    alignas(pfs::simd::laneAlignment) float hatVoiceAmplitude[chunkSize];
+    alignas(pfs::simd::laneAlignment) float noiseChunk[chunkSize];
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include "ParameterTable.h"
+#include "StateCodec.h"
+
+// Parameter table - single source of truth for IDs, ranges and defaults.
+// Order must match Drum808Param (it is also the host parameter order).
+enum class Drum808Param
+{
+    KickLevel, KickTone, KickDecay, KickTuning,
+    LowTomLevel, LowTomTone, LowTomDecay, LowTomTuning,
+    MidTomLevel, MidTomTone, MidTomDecay, MidTomTuning,
+    ClapLevel, ClapTone, ClapSnap, ClapTuning,
+    ClosedHatLevel, ClosedHatTone, ClosedHatDecay, ClosedHatTuning,
+    OpenHatLevel, OpenHatTone, OpenHatDecay, OpenHatTuning,
+    Voices, CachedVoices,
+    Count
+};
+
+inline constexpr std::array drum808ParameterTable
+{
+    // KICK (4 parameters)
+    pfs::floatParameter("kick_level", "Kick Level", 0.0f, 100.0f, 0.1f, 1.0f, 80.0f, "%"),
+    pfs::floatParameter("kick_tone", "Kick Tone", 0.0f, 100.0f, 0.1f, 1.0f, 50.0f, "%"),
+    pfs::floatParameter("kick_decay", "Kick Decay", 50.0f, 1000.0f, 1.0f, 1.0f, 400.0f, "ms"),
+    pfs::floatParameter("kick_tuning", "Kick Tuning", -12.0f, 12.0f, 0.1f, 1.0f, 0.0f, "st"),
+
+    // LOW TOM (4 parameters)
+    pfs::floatParameter("lowtom_level", "Low Tom Level", 0.0f, 100.0f, 0.1f, 1.0f, 75.0f, "%"),
+    pfs::floatParameter("lowtom_tone", "Low Tom Tone", 0.0f, 100.0f, 0.1f, 1.0f, 50.0f, "%"),
+    pfs::floatParameter("lowtom_decay", "Low Tom Decay", 50.0f, 1000.0f, 1.0f, 1.0f, 300.0f, "ms"),
+    pfs::floatParameter("lowtom_tuning", "Low Tom Tuning", -12.0f, 12.0f, 0.1f, 1.0f, 0.0f, "st"),
+
+    // MID TOM (4 parameters)
+    pfs::floatParameter("midtom_level", "Mid Tom Level", 0.0f, 100.0f, 0.1f, 1.0f, 75.0f, "%"),
+    pfs::floatParameter("midtom_tone", "Mid Tom Tone", 0.0f, 100.0f, 0.1f, 1.0f, 50.0f, "%"),
+    pfs::floatParameter("midtom_decay", "Mid Tom Decay", 50.0f, 1000.0f, 1.0f, 1.0f, 250.0f, "ms"),
+    pfs::floatParameter("midtom_tuning", "Mid Tom Tuning", -12.0f, 12.0f, 0.1f, 1.0f, 5.0f, "st"),
+
+    // CLAP (4 parameters)
+    pfs::floatParameter("clap_level", "Clap Level", 0.0f, 100.0f, 0.1f, 1.0f, 70.0f, "%"),
+    pfs::floatParameter("clap_tone", "Clap Tone", 0.0f, 100.0f, 0.1f, 1.0f, 50.0f, "%"),
+    pfs::floatParameter("clap_snap", "Clap Snap", 0.0f, 100.0f, 0.1f, 1.0f, 60.0f, "%"),
+    pfs::floatParameter("clap_tuning", "Clap Tuning", -12.0f, 12.0f, 0.1f, 1.0f, 0.0f, "st"),
+
+    // CLOSED HAT (4 parameters)
+    pfs::floatParameter("closedhat_level", "Closed Hat Level", 0.0f, 100.0f, 0.1f, 1.0f, 65.0f, "%"),
+    pfs::floatParameter("closedhat_tone", "Closed Hat Tone", 0.0f, 100.0f, 0.1f, 1.0f, 60.0f, "%"),
+    pfs::floatParameter("closedhat_decay", "Closed Hat Decay", 20.0f, 200.0f, 1.0f, 1.0f, 80.0f, "ms"),
+    pfs::floatParameter("closedhat_tuning", "Closed Hat Tuning", -12.0f, 12.0f, 0.1f, 1.0f, 0.0f, "st"),
+
+    // OPEN HAT (4 parameters)
+    pfs::floatParameter("openhat_level", "Open Hat Level", 0.0f, 100.0f, 0.1f, 1.0f, 60.0f, "%"),
+    pfs::floatParameter("openhat_tone", "Open Hat Tone", 0.0f, 100.0f, 0.1f, 1.0f, 60.0f, "%"),
+    pfs::floatParameter("openhat_decay", "Open Hat Decay", 100.0f, 1000.0f, 1.0f, 1.0f, 500.0f, "ms"),
+    pfs::floatParameter("openhat_tuning", "Open Hat Tuning", -12.0f, 12.0f, 0.1f, 1.0f, 0.0f, "st"),
+
+    // GLOBAL
+    pfs::intParameter("voices", "Voices", 1, 8, 1),     // Voices per drum (1: each hit replaces the last, as before)
+    pfs::boolParameter("cached_voices", "Cached Voices", false),   // Play pre-rendered hits instead of synthesising
+};
+
+static_assert(drum808ParameterTable.size() == static_cast<size_t>(Drum808Param::Count));
+static_assert(pfs::isValidParameterTable(drum808ParameterTable));
+static_assert(pfs::hasUniqueStateHashes(drum808ParameterTable));
+
+using Drum808ParameterCache = pfs::ParameterCache<Drum808Param, drum808ParameterTable.size()>;
+using Drum808ParameterSnapshot = Drum808ParameterCache::Snapshot;
+using Drum808StateCodec = pfs::StateCodec<drum808ParameterTable.size()>;
@@ -131,6 +131,9 @@ Drum808AudioProcessorEditor::Drum808AudioProcessorEditor(Drum808AudioProcessor&
     // Set window size (from mockup)
     setSize(1000, 550);
 
+    // Triggers queued while no editor was open are stale - don't flash them now
+    processorRef.triggerEvents.discardAll();
+
     // Start timer for LED updates (60fps)
     startTimer(16);
 }
@@ -153,44 +156,30 @@ void Drum808AudioProcessorEditor::resized()
 
 void Drum808AudioProcessorEditor::timerCallback()
 {
-    // Read atomic flags set by audio thread (Pattern 5: Threading)
-    // Check each voice and trigger corresponding LED in JavaScript
-
-    if (processorRef.kickTriggered.load(std::memory_order_relaxed))
-    {
-        processorRef.kickTriggered.store(false, std::memory_order_relaxed);
-        webView->emitEventIfBrowserIsVisible("ledTrigger", "kick");
-    }
-
-    if (processorRef.lowTomTriggered.load(std::memory_order_relaxed))
-    {
-        processorRef.lowTomTriggered.store(false, std::memory_order_relaxed);
-        webView->emitEventIfBrowserIsVisible("ledTrigger", "lowtom");
-    }
+    // Drain the triggers published by the audio thread since the last frame
+    // (wait-free SPSC ring) and send them as one batched event, every hit
+    // included: [{ led, velocity, delay }, ...], delay in ms after the first
+    // hit of the batch, so the UI replays a roll with its real spacing
+    const auto millisecondsPerSample = 1000.0 / juce::jmax(1.0, processorRef.getSampleRate());
 
-    if (processorRef.midTomTriggered.load(std::memory_order_relaxed))
-    {
-        processorRef.midTomTriggered.store(false, std::memory_order_relaxed);
-        webView->emitEventIfBrowserIsVisible("ledTrigger", "midtom");
-    }
+    juce::Array<juce::var> hits;
+    juce::int64 firstSample = 0;
+    Drum808AudioProcessor::TriggerEvent event;
 
-    if (processorRef.clapTriggered.load(std::memory_order_relaxed))
+    while (processorRef.triggerEvents.pop(event))
     {
-        processorRef.clapTriggered.store(false, std::memory_order_relaxed);
-        webView->emitEventIfBrowserIsVisible("ledTrigger", "clap");
+        if (hits.isEmpty())
+            firstSample = event.samplePosition;
+
+        auto hit = std::make_unique<juce::DynamicObject>();
+        hit->setProperty("led", Drum808NoteMap::getInstrumentName(event.voice));    // LED ids match the state names
+        hit->setProperty("velocity", event.velocity);
+        hit->setProperty("delay", static_cast<double>(event.samplePosition - firstSample) * millisecondsPerSample);
+        hits.add(juce::var(hit.release()));
     }
 
-    if (processorRef.closedHatTriggered.load(std::memory_order_relaxed))
-    {
-        processorRef.closedHatTriggered.store(false, std::memory_order_relaxed);
-        webView->emitEventIfBrowserIsVisible("ledTrigger", "closedhat");
-    }
-
-    if (processorRef.openHatTriggered.load(std::memory_order_relaxed))
-    {
-        processorRef.openHatTriggered.store(false, std::memory_order_relaxed);
-        webView->emitEventIfBrowserIsVisible("ledTrigger", "openhat");
-    }
+    if (!hits.isEmpty())
+        webView->emitEventIfBrowserIsVisible("ledTriggers", juce::var(std::move(hits)));
 }
 
 std::optional<juce::WebBrowserComponent::Resource>
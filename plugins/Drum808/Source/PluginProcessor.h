@@ -1,6 +1,11 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "Drum808HitCache.h"
+#include "Drum808NoteMap.h"
+#include "Drum808Voices.h"
+#include "Parameters.h"
+#include "Telemetry.h"
 
 class Drum808AudioProcessor : public juce::AudioProcessor
 {
@@ -13,7 +18,7 @@ public:
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override { return true; }
+    bool hasEditor() const override;
 
     const juce::String getName() const override { return "Drum808"; }
     bool acceptsMidi() const override { return true; }
@@ -32,134 +37,44 @@ public:
 
     juce::AudioProcessorValueTreeState parameters;
 
-    // LED trigger flags (audio thread → UI thread communication)
-    std::atomic<bool> kickTriggered{false};
-    std::atomic<bool> lowTomTriggered{false};
-    std::atomic<bool> midTomTriggered{false};
-    std::atomic<bool> clapTriggered{false};
-    std::atomic<bool> closedHatTriggered{false};
-    std::atomic<bool> openHatTriggered{false};
+    // MIDI note → instrument assignment and choke groups (edited on the message thread, saved in the state)
+    Drum808NoteMap noteMap;
 
-private:
-    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+    // LED trigger telemetry (audio thread → editor timer, wait-free SPSC ring)
+    using TriggeredVoice = Drum808Instrument;
 
-    // Tom Voice structure (used for both Low Tom and Mid Tom)
-    struct TomVoice
+    struct TriggerEvent
     {
-        juce::dsp::Oscillator<float> oscillator;
-        juce::dsp::StateVariableTPTFilter<float> filter;
-
-        bool isPlaying = false;
-        float envelopeTime = 0.0f;
-        float velocity = 0.0f;
-
-        void trigger(float velocityGain, float baseFreq)
-        {
-            isPlaying = true;
-            envelopeTime = 0.0f;
-            velocity = velocityGain;
-            oscillator.setFrequency(baseFreq);
-            filter.setCutoffFrequency(baseFreq);
-        }
-
-        void stop()
-        {
-            isPlaying = false;
-            envelopeTime = 0.0f;
-        }
+        TriggeredVoice voice;
+        float velocity;
+        juce::int64 samplePosition;     // on the processor's sample clock (samples rendered since prepareToPlay)
     };
 
-    // Kick Voice structure
-    struct KickVoice
-    {
-        juce::dsp::Oscillator<float> bodyOscillator;
-        juce::Random noiseGenerator;
-
-        bool isPlaying = false;
-        float envelopeTime = 0.0f;
-        float velocity = 0.0f;
-
-        void trigger(float velocityGain)
-        {
-            isPlaying = true;
-            envelopeTime = 0.0f;
-            velocity = velocityGain;
-        }
-
-        void stop()
-        {
-            isPlaying = false;
-            envelopeTime = 0.0f;
-        }
-    };
+    pfs::SpscRing<TriggerEvent, 128> triggerEvents;
 
-    // Hi-Hat Voice structure (shared by Closed and Open)
-    struct HiHatVoice
-    {
-        // 6 square wave oscillators for metallic inharmonic spectrum
-        juce::dsp::Oscillator<float> oscillators[6];
-        juce::dsp::StateVariableTPTFilter<float> filter;
-
-        bool isPlaying = false;
-        float envelopeTime = 0.0f;
-        float velocity = 0.0f;
-
-        void trigger(float velocityGain)
-        {
-            isPlaying = true;
-            envelopeTime = 0.0f;
-            velocity = velocityGain;
-        }
-
-        void stop()
-        {
-            isPlaying = false;
-            envelopeTime = 0.0f;
-        }
-    };
+private:
+    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-    // Clap Voice structure (multi-trigger envelope + filtered noise)
-    enum class ClapEnvelopeState { Spike1, Spike2, Spike3, Decay, Idle };
+    void writeOutputBuses(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
 
-    struct ClapVoice
-    {
-        juce::dsp::StateVariableTPTFilter<float> bandpassFilter;
-        ClapEnvelopeState envelopeState = ClapEnvelopeState::Idle;
-        int envelopeSample = 0;
-        float velocity = 0.0f;
-        bool isPlaying = false;
-
-        // Sample-rate independent timing (calculated in prepareToPlay)
-        int spike2StartSample = 0;
-        int spike3StartSample = 0;
-        int decayStartSample = 0;
-
-        void trigger(float velocityGain)
-        {
-            isPlaying = true;
-            envelopeState = ClapEnvelopeState::Spike1;
-            envelopeSample = 0;
-            velocity = velocityGain;
-        }
-
-        void stop()
-        {
-            isPlaying = false;
-            envelopeState = ClapEnvelopeState::Idle;
-            envelopeSample = 0;
-        }
-    };
+    // Voice engine: all six instruments as SIMD lanes of one structure-of-arrays bank
+    Drum808VoiceBank voices;
+
+    // Per-instrument mono render target, sized in prepareToPlay (larger host blocks render in slices)
+    juce::AudioBuffer<float> instrumentBuffer;
+
+    // Sample clock for TriggerEvent::samplePosition (audio thread only)
+    juce::int64 samplesRendered = 0;
+
+    // Cached parameter pointers (declared after parameters - resolved from it)
+    Drum808ParameterCache parameterCache;
 
-    // DSP Components (BEFORE APVTS for initialization order)
-    juce::dsp::ProcessSpec spec;
-    TomVoice lowTom;
-    TomVoice midTom;
-    KickVoice kick;
-    HiHatVoice closedHat;
-    HiHatVoice openHat;
-    ClapVoice clap;
+    // Binary get/setStateInformation (same table, resolved once)
+    Drum808StateCodec stateCodec;
 
-    double currentSampleRate = 44100.0;
+    // "Cached voices" mode: pre-rendered hits, re-rendered on a background thread (reads parameterCache,
+    // listens to the mode parameter)
+    Drum808HitCache hitCache { parameters, parameterCache };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Drum808AudioProcessor)
 };
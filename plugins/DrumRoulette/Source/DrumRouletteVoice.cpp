@@ -65,6 +65,10 @@ void DrumRouletteVoice::setCurrentPlaybackSampleRate(double newRate)
     spec.maximumBlockSize = 512;  // Reasonable default for per-voice processing
     spec.numChannels = 1;  // Per-voice is mono
 
+    // Second-order coefficient storage, rewritten in place by startNote (set before prepare)
+    lowShelfFilter.coefficients = pfs::BiquadCoefficients().makeStorage();
+    highShelfFilter.coefficients = pfs::BiquadCoefficients().makeStorage();
+
     lowShelfFilter.prepare(spec);
     highShelfFilter.prepare(spec);
     volumeGain.prepare(spec);
@@ -122,14 +126,12 @@ void DrumRouletteVoice::startNote(int midiNoteNumber, float velocity, juce::Synt
         float tiltGain = juce::Decibels::decibelsToGain(tiltDb);
 
         // Low-shelf (below 1kHz): Same polarity as tilt value
-        auto lowShelfCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowShelf(
-            voiceSampleRate, 1000.0f, 0.707f, tiltGain);
-        *lowShelfFilter.coefficients = *lowShelfCoeffs;
+        pfs::BiquadCoefficients::lowShelf(voiceSampleRate, 1000.0f, 0.707f, tiltGain)
+            .copyTo(*lowShelfFilter.coefficients);
 
         // High-shelf (above 1kHz): Opposite polarity (inverse gain)
-        auto highShelfCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighShelf(
-            voiceSampleRate, 1000.0f, 0.707f, 1.0f / tiltGain);
-        *highShelfFilter.coefficients = *highShelfCoeffs;
+        pfs::BiquadCoefficients::highShelf(voiceSampleRate, 1000.0f, 0.707f, 1.0f / tiltGain)
+            .copyTo(*highShelfFilter.coefficients);
     }
 }
 
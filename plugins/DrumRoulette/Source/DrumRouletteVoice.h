@@ -1,6 +1,7 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "BiquadDesigner.h"
 
 class DrumRouletteVoice : public juce::SynthesiserVoice
 {
@@ -0,0 +1,66 @@
+#pragma once
+#include "ParameterTable.h"
+#include "StateCodec.h"
+
+// Parameter table - single source of truth for IDs, ranges and defaults.
+// Layout: RANDOMIZE_ALL, then the nine per-slot parameters for slots 1-8
+// (slot-major, same order as the host parameter list).
+inline constexpr int drumRouletteNumSlots = 8;
+
+enum class DrumRouletteSlotParam
+{
+    Randomize, Lock, Volume, Decay, Attack, TiltFilter, Pitch, Solo, Mute,
+    Count
+};
+
+enum class DrumRouletteParam
+{
+    RandomizeAll,
+    FirstSlotParam,
+    Count = FirstSlotParam + drumRouletteNumSlots * static_cast<int>(DrumRouletteSlotParam::Count)
+};
+
+// Table index of a per-slot parameter (slotIndex is 0-based)
+constexpr size_t drumRouletteSlotParamIndex(int slotIndex, DrumRouletteSlotParam parameter)
+{
+    return static_cast<size_t>(DrumRouletteParam::FirstSlotParam)
+         + static_cast<size_t>(slotIndex) * static_cast<size_t>(DrumRouletteSlotParam::Count)
+         + static_cast<size_t>(parameter);
+}
+
+#define DRUM_ROULETTE_SLOT_PARAMETERS(n) \
+    pfs::boolParameter("RANDOMIZE_" #n, "Randomize " #n, false),                                  /* Button trigger */ \
+    pfs::boolParameter("LOCK_" #n, "Lock " #n, false),                                            /* Toggle */ \
+    pfs::floatParameter("VOLUME_" #n, "Volume " #n, -60.0f, 6.0f, 0.1f, 2.0f, 0.0f, "dB"),        /* Fader, skew 2.0 */ \
+    pfs::floatParameter("DECAY_" #n, "Decay " #n, 10.0f, 2000.0f, 0.1f, 0.5f, 500.0f, "ms"),      /* Rotary, skew 0.5 */ \
+    pfs::floatParameter("ATTACK_" #n, "Attack " #n, 0.0f, 50.0f, 0.1f, 0.5f, 1.0f, "ms"),         /* Rotary, skew 0.5 */ \
+    pfs::floatParameter("TILT_FILTER_" #n, "Tilt " #n, -12.0f, 12.0f, 0.1f, 1.0f, 0.0f, "dB"),    /* Rotary, linear */ \
+    pfs::floatParameter("PITCH_" #n, "Pitch " #n, -12.0f, 12.0f, 0.1f, 1.0f, 0.0f, "st"),         /* Rotary, semitones */ \
+    pfs::boolParameter("SOLO_" #n, "Solo " #n, false),                                            /* Toggle */ \
+    pfs::boolParameter("MUTE_" #n, "Mute " #n, false)                                             /* Toggle */
+
+inline constexpr std::array drumRouletteParameterTable
+{
+    // Global parameter: RANDOMIZE_ALL (1 parameter)
+    pfs::boolParameter("RANDOMIZE_ALL", "Randomize All", false),
+
+    // Per-slot parameters (9 × 8 = 72 parameters)
+    DRUM_ROULETTE_SLOT_PARAMETERS(1),
+    DRUM_ROULETTE_SLOT_PARAMETERS(2),
+    DRUM_ROULETTE_SLOT_PARAMETERS(3),
+    DRUM_ROULETTE_SLOT_PARAMETERS(4),
+    DRUM_ROULETTE_SLOT_PARAMETERS(5),
+    DRUM_ROULETTE_SLOT_PARAMETERS(6),
+    DRUM_ROULETTE_SLOT_PARAMETERS(7),
+    DRUM_ROULETTE_SLOT_PARAMETERS(8),
+};
+
+#undef DRUM_ROULETTE_SLOT_PARAMETERS
+
+static_assert(drumRouletteParameterTable.size() == static_cast<size_t>(DrumRouletteParam::Count));
+static_assert(pfs::isValidParameterTable(drumRouletteParameterTable));
+static_assert(pfs::hasUniqueStateHashes(drumRouletteParameterTable));
+
+using DrumRouletteParameterCache = pfs::ParameterCache<DrumRouletteParam, drumRouletteParameterTable.size()>;
+using DrumRouletteParameterSnapshot = DrumRouletteParameterCache::Snapshot;
+using DrumRouletteStateCodec = pfs::StateCodec<drumRouletteParameterTable.size()>;
@@ -1,97 +1,12 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+
+#if ! PLUGIN_DSP_ONLY
+ #include "PluginEditor.h"
+#endif
 
 juce::AudioProcessorValueTreeState::ParameterLayout DrumRouletteAudioProcessor::createParameterLayout()
 {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-
-    // Global parameter: RANDOMIZE_ALL (1 parameter)
-    layout.add(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { "RANDOMIZE_ALL", 1 },
-        "Randomize All",
-        false
-    ));
-
-    // Per-slot parameters (9 × 8 = 72 parameters)
-    for (int slot = 1; slot <= 8; ++slot)
-    {
-        juce::String slotNum = juce::String(slot);
-
-        // RANDOMIZE_N - Button trigger
-        layout.add(std::make_unique<juce::AudioParameterBool>(
-            juce::ParameterID { "RANDOMIZE_" + slotNum, 1 },
-            "Randomize " + slotNum,
-            false
-        ));
-
-        // LOCK_N - Toggle
-        layout.add(std::make_unique<juce::AudioParameterBool>(
-            juce::ParameterID { "LOCK_" + slotNum, 1 },
-            "Lock " + slotNum,
-            false
-        ));
-
-        // VOLUME_N - Fader (-60.0 to +6.0 dB, skew 2.0)
-        layout.add(std::make_unique<juce::AudioParameterFloat>(
-            juce::ParameterID { "VOLUME_" + slotNum, 1 },
-            "Volume " + slotNum,
-            juce::NormalisableRange<float>(-60.0f, 6.0f, 0.1f, 2.0f),
-            0.0f,
-            "dB"
-        ));
-
-        // DECAY_N - Rotary (10.0 to 2000.0 ms, skew 0.5)
-        layout.add(std::make_unique<juce::AudioParameterFloat>(
-            juce::ParameterID { "DECAY_" + slotNum, 1 },
-            "Decay " + slotNum,
-            juce::NormalisableRange<float>(10.0f, 2000.0f, 0.1f, 0.5f),
-            500.0f,
-            "ms"
-        ));
-
-        // ATTACK_N - Rotary (0.0 to 50.0 ms, skew 0.5)
-        layout.add(std::make_unique<juce::AudioParameterFloat>(
-            juce::ParameterID { "ATTACK_" + slotNum, 1 },
-            "Attack " + slotNum,
-            juce::NormalisableRange<float>(0.0f, 50.0f, 0.1f, 0.5f),
-            1.0f,
-            "ms"
-        ));
-
-        // TILT_FILTER_N - Rotary (-12.0 to +12.0 dB, linear)
-        layout.add(std::make_unique<juce::AudioParameterFloat>(
-            juce::ParameterID { "TILT_FILTER_" + slotNum, 1 },
-            "Tilt " + slotNum,
-            juce::NormalisableRange<float>(-12.0f, 12.0f, 0.1f, 1.0f),
-            0.0f,
-            "dB"
-        ));
-
-        // PITCH_N - Rotary (-12.0 to +12.0 semitones, linear)
-        layout.add(std::make_unique<juce::AudioParameterFloat>(
-            juce::ParameterID { "PITCH_" + slotNum, 1 },
-            "Pitch " + slotNum,
-            juce::NormalisableRange<float>(-12.0f, 12.0f, 0.1f, 1.0f),
-            0.0f,
-            "st"
-        ));
-
-        // SOLO_N - Toggle
-        layout.add(std::make_unique<juce::AudioParameterBool>(
-            juce::ParameterID { "SOLO_" + slotNum, 1 },
-            "Solo " + slotNum,
-            false
-        ));
-
-        // MUTE_N - Toggle
-        layout.add(std::make_unique<juce::AudioParameterBool>(
-            juce::ParameterID { "MUTE_" + slotNum, 1 },
-            "Mute " + slotNum,
-            false
-        ));
-    }
-
-    return layout;
+    return pfs::createParameterLayout(drumRouletteParameterTable);
 }
 
 juce::AudioProcessor::BusesProperties DrumRouletteAudioProcessor::createBusesLayout()
@@ -114,6 +29,8 @@ juce::AudioProcessor::BusesProperties DrumRouletteAudioProcessor::createBusesLay
 DrumRouletteAudioProcessor::DrumRouletteAudioProcessor()
     : AudioProcessor(createBusesLayout())
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, drumRouletteParameterTable)
+    , stateCodec(parameters, drumRouletteParameterTable)
 {
     // Register audio formats (WAV, AIFF, MP3, AAC)
     formatManager.registerBasicFormats();
@@ -126,27 +43,31 @@ DrumRouletteAudioProcessor::DrumRouletteAudioProcessor()
         synthesiser.addVoice(voice);
 
         // Pass parameter pointers to voice (Phase 4.2 + 4.3)
-        juce::String slotNum = juce::String(static_cast<int>(slot + 1));
-        auto* attackParam = parameters.getRawParameterValue("ATTACK_" + slotNum);
-        auto* decayParam = parameters.getRawParameterValue("DECAY_" + slotNum);
-        auto* pitchParam = parameters.getRawParameterValue("PITCH_" + slotNum);
-        auto* tiltParam = parameters.getRawParameterValue("TILT_FILTER_" + slotNum);
-        auto* volumeParam = parameters.getRawParameterValue("VOLUME_" + slotNum);
+        auto slotParam = [this, slot](DrumRouletteSlotParam parameter)
+        {
+            return &parameterCache[drumRouletteSlotParamIndex(static_cast<int>(slot), parameter)];
+        };
+
+        auto* attackParam = slotParam(DrumRouletteSlotParam::Attack);
+        auto* decayParam = slotParam(DrumRouletteSlotParam::Decay);
+        auto* pitchParam = slotParam(DrumRouletteSlotParam::Pitch);
+        auto* tiltParam = slotParam(DrumRouletteSlotParam::TiltFilter);
+        auto* volumeParam = slotParam(DrumRouletteSlotParam::Volume);
 
         voice->setParameterPointers(attackParam, decayParam, pitchParam, tiltParam, volumeParam);
 
         // Phase 4.4: Get parameter pointers for solo/mute/lock/randomize
-        lockParams[slot] = parameters.getRawParameterValue("LOCK_" + slotNum);
-        soloParams[slot] = parameters.getRawParameterValue("SOLO_" + slotNum);
-        muteParams[slot] = parameters.getRawParameterValue("MUTE_" + slotNum);
-        randomizeParams[slot] = parameters.getRawParameterValue("RANDOMIZE_" + slotNum);
+        lockParams[slot] = slotParam(DrumRouletteSlotParam::Lock);
+        soloParams[slot] = slotParam(DrumRouletteSlotParam::Solo);
+        muteParams[slot] = slotParam(DrumRouletteSlotParam::Mute);
+        randomizeParams[slot] = slotParam(DrumRouletteSlotParam::Randomize);
 
         // Pass solo/mute pointers to voice
         voice->setSoloMutePointers(soloParams[slot], muteParams[slot], &anySoloActive);
     }
 
     // Phase 4.4: Get global randomize parameter
-    randomizeAllParam = parameters.getRawParameterValue("RANDOMIZE_ALL");
+    randomizeAllParam = &parameterCache[DrumRouletteParam::RandomizeAll];
 
     // Phase 4.4: Register parameter listeners for button triggers
     for (int slot = 1; slot <= 8; ++slot)
@@ -383,45 +304,53 @@ void DrumRouletteAudioProcessor::randomizeAllUnlockedSlots()
     }
 }
 
+#if PLUGIN_DSP_ONLY
+bool DrumRouletteAudioProcessor::hasEditor() const
+{
+    return false;
+}
+
+juce::AudioProcessorEditor* DrumRouletteAudioProcessor::createEditor()
+{
+    return nullptr;
+}
+#else
+bool DrumRouletteAudioProcessor::hasEditor() const
+{
+    return true;
+}
+
 juce::AudioProcessorEditor* DrumRouletteAudioProcessor::createEditor()
 {
     return new DrumRouletteAudioProcessorEditor(*this);
 }
+#endif
+
+// Phase 4.4: Folder paths are stored next to the parameters, one string per slot
+static constexpr const char* folderPathStateKeys[8] =
+{
+    "folderPath1", "folderPath2", "folderPath3", "folderPath4",
+    "folderPath5", "folderPath6", "folderPath7", "folderPath8"
+};
 
 void DrumRouletteAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = parameters.copyState();
+    std::array<pfs::StateString, 8> strings;
 
-    // Phase 4.4: Add folder paths to state tree
-    for (int slot = 0; slot < 8; ++slot)
-    {
-        juce::String propName = "folderPath" + juce::String(slot + 1);
-        state.setProperty(propName, folderPaths[slot], nullptr);
-    }
+    for (size_t slot = 0; slot < strings.size(); ++slot)
+        strings[slot] = { folderPathStateKeys[slot], folderPaths[slot] };
 
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    stateCodec.save(destData, strings.data(), static_cast<int>(strings.size()));
 }
 
 void DrumRouletteAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState != nullptr && xmlState->hasTagName(parameters.state.getType()))
+    stateCodec.load(data, sizeInBytes, [this](const juce::String& key, const juce::String& value)
     {
-        auto state = juce::ValueTree::fromXml(*xmlState);
-        parameters.replaceState(state);
-
-        // Phase 4.4: Restore folder paths from state tree
         for (int slot = 0; slot < 8; ++slot)
-        {
-            juce::String propName = "folderPath" + juce::String(slot + 1);
-            if (state.hasProperty(propName))
-            {
-                folderPaths[slot] = state.getProperty(propName).toString();
-            }
-        }
-    }
+            if (key == folderPathStateKeys[slot])
+                folderPaths[slot] = value;
+    });
 }
 
 // Factory function
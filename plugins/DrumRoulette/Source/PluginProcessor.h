@@ -2,6 +2,7 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_audio_formats/juce_audio_formats.h>
 #include "DrumRouletteVoice.h"
+#include "Parameters.h"
 
 class DrumRouletteAudioProcessor : public juce::AudioProcessor,
                                     public juce::AudioProcessorValueTreeState::Listener
@@ -15,7 +16,7 @@ public:
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override { return true; }
+    bool hasEditor() const override;
 
     const juce::String getName() const override { return "DrumRoulette"; }
     bool acceptsMidi() const override { return true; }
@@ -69,5 +70,11 @@ private:
     // Phase 4.4: Solo/mute state tracking
     bool anySoloActive = false;
 
+    // Cached parameter pointers (declared after parameters - resolved from it)
+    DrumRouletteParameterCache parameterCache;
+
+    // Binary get/setStateInformation (same table, resolved once)
+    DrumRouletteStateCodec stateCodec;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DrumRouletteAudioProcessor)
 };
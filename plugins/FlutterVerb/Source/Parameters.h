@@ -0,0 +1,44 @@
+#pragma once
+#include "ParameterTable.h"
+#include "StateCodec.h"
+
+// Parameter table - single source of truth for IDs, ranges and defaults.
+// Order must match FlutterVerbParam (it is also the host parameter order).
+enum class FlutterVerbParam
+{
+    Size, Decay, Mix, Age, Drive, Tone, ModMode,
+    Count
+};
+
+inline constexpr std::array flutterVerbParameterTable
+{
+    // SIZE - Room dimensions
+    pfs::floatParameter("SIZE", "Size", 0.0f, 100.0f, 0.1f, 1.0f, 50.0f, "%"),
+
+    // DECAY - Reverb tail length
+    pfs::floatParameter("DECAY", "Decay", 0.1f, 10.0f, 0.01f, 1.0f, 2.5f, "s"),
+
+    // MIX - Dry/wet blend
+    pfs::floatParameter("MIX", "Mix", 0.0f, 100.0f, 0.1f, 1.0f, 25.0f, "%"),
+
+    // AGE - Tape character intensity
+    pfs::floatParameter("AGE", "Age", 0.0f, 100.0f, 0.1f, 1.0f, 20.0f, "%"),
+
+    // DRIVE - Tape saturation
+    pfs::floatParameter("DRIVE", "Drive", 0.0f, 100.0f, 0.1f, 1.0f, 20.0f, "%"),
+
+    // TONE - DJ-style filter
+    pfs::floatParameter("TONE", "Tone", -100.0f, 100.0f, 0.1f, 1.0f, 0.0f),
+
+    // MOD_MODE - Modulation routing
+    pfs::boolParameter("MOD_MODE", "Mod Mode", false),
+};
+
+static_assert(flutterVerbParameterTable.size() == static_cast<size_t>(FlutterVerbParam::Count));
+static_assert(pfs::isValidParameterTable(flutterVerbParameterTable));
+static_assert(pfs::hasUniqueStateHashes(flutterVerbParameterTable));
+
+using FlutterVerbParameterCache = pfs::ParameterCache<FlutterVerbParam, flutterVerbParameterTable.size()>;
+using FlutterVerbParameterSnapshot = FlutterVerbParameterCache::Snapshot;
+using FlutterVerbStateCodec = pfs::StateCodec<flutterVerbParameterTable.size()>;
+
@@ -1,72 +1,13 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+#include "Saturation.h"
+
+#if ! PLUGIN_DSP_ONLY
+ #include "PluginEditor.h"
+#endif
 
 juce::AudioProcessorValueTreeState::ParameterLayout FlutterVerbAudioProcessor::createParameterLayout()
 {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-
-    // SIZE - Room dimensions
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "SIZE", 1 },
-        "Size",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        50.0f,
-        "%"
-    ));
-
-    // DECAY - Reverb tail length
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "DECAY", 1 },
-        "Decay",
-        juce::NormalisableRange<float>(0.1f, 10.0f, 0.01f, 1.0f),
-        2.5f,
-        "s"
-    ));
-
-    // MIX - Dry/wet blend
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "MIX", 1 },
-        "Mix",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        25.0f,
-        "%"
-    ));
-
-    // AGE - Tape character intensity
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "AGE", 1 },
-        "Age",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        20.0f,
-        "%"
-    ));
-
-    // DRIVE - Tape saturation
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "DRIVE", 1 },
-        "Drive",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        20.0f,
-        "%"
-    ));
-
-    // TONE - DJ-style filter
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "TONE", 1 },
-        "Tone",
-        juce::NormalisableRange<float>(-100.0f, 100.0f, 0.1f, 1.0f),
-        0.0f,
-        ""
-    ));
-
-    // MOD_MODE - Modulation routing
-    layout.add(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { "MOD_MODE", 1 },
-        "Mod Mode",
-        false  // Default: WET ONLY (0)
-    ));
-
-    return layout;
+    return pfs::createParameterLayout(flutterVerbParameterTable);
 }
 
 FlutterVerbAudioProcessor::FlutterVerbAudioProcessor()
@@ -74,6 +15,8 @@ FlutterVerbAudioProcessor::FlutterVerbAudioProcessor()
                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, flutterVerbParameterTable)
+    , stateCodec(parameters, flutterVerbParameterTable)
 {
 }
 
@@ -114,6 +57,8 @@ void FlutterVerbAudioProcessor::prepareToPlay(double sampleRate, int samplesPerB
     flutterPhase.resize(spec.numChannels, 0.0f);
 
     // Phase 4.3: Prepare filter
+    // Second-order coefficient storage, rewritten in place by processBlock (set before prepare)
+    toneFilter.state = pfs::BiquadCoefficients().makeStorage();
     toneFilter.prepare(spec);
     toneFilter.reset();
     currentFilterType = FilterType::None;
@@ -134,26 +79,26 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
         buffer.clear(i, 0, buffer.getNumSamples());
 
     // Phase 4.1: Read SIZE, DECAY, MIX parameters (atomic, real-time safe)
-    auto* sizeParam = parameters.getRawParameterValue("SIZE");
-    auto* decayParam = parameters.getRawParameterValue("DECAY");
-    auto* mixParam = parameters.getRawParameterValue("MIX");
+    auto* sizeParam = &parameterCache[FlutterVerbParam::Size];
+    auto* decayParam = &parameterCache[FlutterVerbParam::Decay];
+    auto* mixParam = &parameterCache[FlutterVerbParam::Mix];
 
     float sizeValue = sizeParam->load() / 100.0f;  // 0-100% → 0.0-1.0
     float decayValue = decayParam->load();          // 0.1-10.0 seconds
     float mixValue = mixParam->load() / 100.0f;     // 0-100% → 0.0-1.0
 
     // Phase 4.2: Read AGE parameter for modulation depth
-    auto* ageParam = parameters.getRawParameterValue("AGE");
+    auto* ageParam = &parameterCache[FlutterVerbParam::Age];
     float ageValue = ageParam->load() / 100.0f;  // 0-100% → 0.0-1.0
 
     // Phase 4.3: Read DRIVE and TONE parameters
-    auto* driveParam = parameters.getRawParameterValue("DRIVE");
-    auto* toneParam = parameters.getRawParameterValue("TONE");
+    auto* driveParam = &parameterCache[FlutterVerbParam::Drive];
+    auto* toneParam = &parameterCache[FlutterVerbParam::Tone];
     float driveValue = driveParam->load() / 100.0f;  // 0-100% → 0.0-1.0
     float toneValue = toneParam->load();  // -100 to +100
 
     // Phase 4.4: Read MOD_MODE parameter for routing control
-    auto* modModeParam = parameters.getRawParameterValue("MOD_MODE");
+    auto* modModeParam = &parameterCache[FlutterVerbParam::ModMode];
     bool wetDryMode = modModeParam->load() > 0.5f;  // 0=WET_ONLY, 1=WET_DRY
 
     // Configure reverb parameters with true SIZE/DECAY independence
@@ -262,13 +207,8 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
 
             for (int channel = 0; channel < numChannels; ++channel)
             {
-                auto* channelData = buffer.getWritePointer(channel);
-
-                for (int sample = 0; sample < numSamples; ++sample)
-                {
-                    // Apply tanh saturation
-                    channelData[sample] = std::tanh(gain * channelData[sample]);
-                }
+                // Apply tanh saturation (vectorised block kernel)
+                pfs::saturation::tanhBlock(buffer.getWritePointer(channel), numSamples, gain);
             }
         }
     };
@@ -296,9 +236,9 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
                 float cutoffHz = 20000.0f * std::pow(10.0f, -normalizedValue * std::log10(100.0f));
                 cutoffHz = juce::jlimit(200.0f, 20000.0f, cutoffHz);
 
-                *toneFilter.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
+                pfs::BiquadCoefficients::lowPass(
                     sampleRate, cutoffHz, 0.707f  // Q = 0.707 (Butterworth)
-                );
+                ).copyTo(*toneFilter.state);
             }
             else
             {
@@ -308,9 +248,9 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
                 float cutoffHz = 20.0f * std::pow(10.0f, normalizedValue * std::log10(500.0f));
                 cutoffHz = juce::jlimit(20.0f, 10000.0f, cutoffHz);
 
-                *toneFilter.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
+                pfs::BiquadCoefficients::highPass(
                     sampleRate, cutoffHz, 0.707f  // Q = 0.707 (Butterworth)
-                );
+                ).copyTo(*toneFilter.state);
             }
 
             // Process buffer through filter
@@ -375,24 +315,36 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
     outputLevel.store(peakDb, std::memory_order_relaxed);
 }
 
+#if PLUGIN_DSP_ONLY
+bool FlutterVerbAudioProcessor::hasEditor() const
+{
+    return false;
+}
+
+juce::AudioProcessorEditor* FlutterVerbAudioProcessor::createEditor()
+{
+    return nullptr;
+}
+#else
+bool FlutterVerbAudioProcessor::hasEditor() const
+{
+    return true;
+}
+
 juce::AudioProcessorEditor* FlutterVerbAudioProcessor::createEditor()
 {
     return new FlutterVerbAudioProcessorEditor(*this);
 }
+#endif
 
 void FlutterVerbAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    stateCodec.save(destData);
 }
 
 void FlutterVerbAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState != nullptr && xmlState->hasTagName(parameters.state.getType()))
-        parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    stateCodec.load(data, sizeInBytes);
 }
 
 // Factory function
@@ -1,6 +1,8 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "Parameters.h"
+#include "BiquadDesigner.h"
 
 class FlutterVerbAudioProcessor : public juce::AudioProcessor
 {
@@ -13,7 +15,7 @@ public:
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override { return true; }
+    bool hasEditor() const override;
 
     const juce::String getName() const override { return "FlutterVerb"; }
     bool acceptsMidi() const override { return false; }
@@ -68,5 +70,11 @@ public:
     float getCurrentOutputLevel() const { return outputLevel.load(std::memory_order_relaxed); }
 
 private:
+    // Cached parameter pointers (declared after parameters - resolved from it)
+    FlutterVerbParameterCache parameterCache;
+
+    // Binary get/setStateInformation (same table, resolved once)
+    FlutterVerbStateCodec stateCodec;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FlutterVerbAudioProcessor)
 };
@@ -0,0 +1,33 @@
+#pragma once
+#include "ParameterTable.h"
+#include "StateCodec.h"
+
+// Parameter table - single source of truth for IDs, ranges and defaults.
+// Order must match GainKnobParam (it is also the host parameter order).
+enum class GainKnobParam
+{
+    Gain, Pan, Filter,
+    Count
+};
+
+inline constexpr std::array gainKnobParameterTable
+{
+    // GAIN - Float parameter (-60.0 to 0.0 dB)
+    pfs::floatParameter("GAIN", "Gain", -60.0f, 0.0f, 0.1f, 1.0f, 0.0f, "dB"),
+
+    // PAN - Float parameter (-100.0 to 100.0, center at 0.0)
+    pfs::floatParameter("PAN", "Pan", -100.0f, 100.0f, 0.1f, 1.0f, 0.0f, "%"),
+
+    // FILTER - Float parameter (-100.0 to 100.0, center at 0.0)
+    // 0 = bypass, negative = low-pass, positive = high-pass
+    pfs::floatParameter("FILTER", "Filter", -100.0f, 100.0f, 0.1f, 1.0f, 0.0f, "%"),
+};
+
+static_assert(gainKnobParameterTable.size() == static_cast<size_t>(GainKnobParam::Count));
+static_assert(pfs::isValidParameterTable(gainKnobParameterTable));
+static_assert(pfs::hasUniqueStateHashes(gainKnobParameterTable));
+
+using GainKnobParameterCache = pfs::ParameterCache<GainKnobParam, gainKnobParameterTable.size()>;
+using GainKnobParameterSnapshot = GainKnobParameterCache::Snapshot;
+using GainKnobStateCodec = pfs::StateCodec<gainKnobParameterTable.size()>;
+
@@ -1,39 +1,12 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+
+#if ! PLUGIN_DSP_ONLY
+ #include "PluginEditor.h"
+#endif
 
 juce::AudioProcessorValueTreeState::ParameterLayout GainKnobAudioProcessor::createParameterLayout()
 {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-
-    // GAIN - Float parameter (-60.0 to 0.0 dB)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "GAIN", 1 },
-        "Gain",
-        juce::NormalisableRange<float>(-60.0f, 0.0f, 0.1f, 1.0f),
-        0.0f,
-        "dB"
-    ));
-
-    // PAN - Float parameter (-100.0 to 100.0, center at 0.0)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "PAN", 1 },
-        "Pan",
-        juce::NormalisableRange<float>(-100.0f, 100.0f, 0.1f, 1.0f),
-        0.0f,
-        "%"
-    ));
-
-    // FILTER - Float parameter (-100.0 to 100.0, center at 0.0)
-    // 0 = bypass, negative = low-pass, positive = high-pass
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "FILTER", 1 },
-        "Filter",
-        juce::NormalisableRange<float>(-100.0f, 100.0f, 0.1f, 1.0f),
-        0.0f,
-        "%"
-    ));
-
-    return layout;
+    return pfs::createParameterLayout(gainKnobParameterTable);
 }
 
 GainKnobAudioProcessor::GainKnobAudioProcessor()
@@ -41,6 +14,8 @@ GainKnobAudioProcessor::GainKnobAudioProcessor()
                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, gainKnobParameterTable)
+    , stateCodec(parameters, gainKnobParameterTable)
 {
 }
 
@@ -56,6 +31,9 @@ void GainKnobAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBloc
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
     spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
 
+    // Second-order coefficient storage, shared by both channels and rewritten in place
+    // by processBlock (must be set before prepare() hands it to the per-channel filters)
+    filterProcessor.state = pfs::BiquadCoefficients().makeStorage();
     filterProcessor.prepare(spec);
     filterProcessor.reset();
 }
@@ -71,15 +49,15 @@ void GainKnobAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
     juce::ignoreUnused(midiMessages);
 
     // Read GAIN parameter (atomic read, real-time safe)
-    auto* gainParam = parameters.getRawParameterValue("GAIN");
+    auto* gainParam = &parameterCache[GainKnobParam::Gain];
     float gainDb = gainParam->load();
 
     // Read PAN parameter (atomic read, real-time safe)
-    auto* panParam = parameters.getRawParameterValue("PAN");
+    auto* panParam = &parameterCache[GainKnobParam::Pan];
     float panPercent = panParam->load();
 
     // Read FILTER parameter (atomic read, real-time safe)
-    auto* filterParam = parameters.getRawParameterValue("FILTER");
+    auto* filterParam = &parameterCache[GainKnobParam::Filter];
     float filterPercent = filterParam->load();
 
     // Apply DJ-style filter (if not at center position)
@@ -101,9 +79,9 @@ void GainKnobAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
             float normalizedValue = std::abs(filterPercent) / 100.0f; // 0.0 to 1.0
             float cutoffHz = 20000.0f * std::pow(10.0f, -normalizedValue * std::log10(20000.0f / 200.0f));
 
-            *filterProcessor.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
+            pfs::BiquadCoefficients::lowPass(
                 sampleRate, juce::jlimit(200.0f, 20000.0f, cutoffHz), 0.707f
-            );
+            ).copyTo(*filterProcessor.state);
         } else {
             // High-pass filter (positive values)
             // Exponential mapping: 0% = 20Hz (bypass), +100% = 10kHz (heavy treble)
@@ -111,9 +89,9 @@ void GainKnobAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
             float normalizedValue = filterPercent / 100.0f; // 0.0 to 1.0
             float cutoffHz = 20.0f * std::pow(10.0f, normalizedValue * std::log10(10000.0f / 20.0f));
 
-            *filterProcessor.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
+            pfs::BiquadCoefficients::highPass(
                 sampleRate, juce::jlimit(20.0f, 10000.0f, cutoffHz), 0.707f
-            );
+            ).copyTo(*filterProcessor.state);
         }
 
         // Process buffer through filter
@@ -160,24 +138,36 @@ void GainKnobAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
         buffer.applyGain(1, 0, buffer.getNumSamples(), rightGain);
 }
 
+#if PLUGIN_DSP_ONLY
+bool GainKnobAudioProcessor::hasEditor() const
+{
+    return false;
+}
+
+juce::AudioProcessorEditor* GainKnobAudioProcessor::createEditor()
+{
+    return nullptr;
+}
+#else
+bool GainKnobAudioProcessor::hasEditor() const
+{
+    return true;
+}
+
 juce::AudioProcessorEditor* GainKnobAudioProcessor::createEditor()
 {
     return new GainKnobAudioProcessorEditor(*this);
 }
+#endif
 
 void GainKnobAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    stateCodec.save(destData);
 }
 
 void GainKnobAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState != nullptr && xmlState->hasTagName(parameters.state.getType()))
-        parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    stateCodec.load(data, sizeInBytes);
 }
 
 // Factory function
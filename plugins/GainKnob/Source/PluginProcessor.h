@@ -1,6 +1,8 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "Parameters.h"
+#include "BiquadDesigner.h"
 
 class GainKnobAudioProcessor : public juce::AudioProcessor
 {
@@ -13,7 +15,7 @@ public:
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override { return true; }
+    bool hasEditor() const override;
 
     const juce::String getName() const override { return "GainKnob"; }
     bool acceptsMidi() const override { return false; }
@@ -42,5 +44,11 @@ private:
     // Track previous filter type to detect transitions
     bool previousWasLowPass = false;
 
+    // Cached parameter pointers (declared after parameters - resolved from it)
+    GainKnobParameterCache parameterCache;
+
+    // Binary get/setStateInformation (same table, resolved once)
+    GainKnobStateCodec stateCodec;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GainKnobAudioProcessor)
 };
@@ -0,0 +1,32 @@
+#pragma once
+#include "ParameterTable.h"
+#include "StateCodec.h"
+
+// Parameter table - single source of truth for IDs, ranges and defaults.
+// Order must match LushPadParam (it is also the host parameter order).
+enum class LushPadParam
+{
+    Timbre, FilterCutoff, ReverbAmount,
+    Count
+};
+
+inline constexpr std::array lushPadParameterTable
+{
+    // timbre - Float (0.0 to 1.0, default: 0.35, linear)
+    pfs::floatParameter("timbre", "Timbre", 0.0f, 1.0f, 0.01f, 1.0f, 0.35f),
+
+    // filter_cutoff - Float (20.0 to 20000.0 Hz, default: 2000.0, skew: 0.3 logarithmic)
+    pfs::floatParameter("filter_cutoff", "Filter Cutoff", 20.0f, 20000.0f, 0.1f, 0.3f, 2000.0f, "Hz"),
+
+    // reverb_amount - Float (0.0 to 1.0, default: 0.4, linear)
+    pfs::floatParameter("reverb_amount", "Reverb Amount", 0.0f, 1.0f, 0.01f, 1.0f, 0.4f),
+};
+
+static_assert(lushPadParameterTable.size() == static_cast<size_t>(LushPadParam::Count));
+static_assert(pfs::isValidParameterTable(lushPadParameterTable));
+static_assert(pfs::hasUniqueStateHashes(lushPadParameterTable));
+
+using LushPadParameterCache = pfs::ParameterCache<LushPadParam, lushPadParameterTable.size()>;
+using LushPadParameterSnapshot = LushPadParameterCache::Snapshot;
+using LushPadStateCodec = pfs::StateCodec<lushPadParameterTable.size()>;
+
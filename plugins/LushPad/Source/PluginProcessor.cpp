@@ -1,42 +1,22 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+#include "MidiBlockSplitter.h"
+#include "Saturation.h"
+
+#if ! PLUGIN_DSP_ONLY
+ #include "PluginEditor.h"
+#endif
 
 juce::AudioProcessorValueTreeState::ParameterLayout LushPadAudioProcessor::createParameterLayout()
 {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-
-    // timbre - Float (0.0 to 1.0, default: 0.35, linear)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "timbre", 1 },
-        "Timbre",
-        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f, 1.0f),
-        0.35f
-    ));
-
-    // filter_cutoff - Float (20.0 to 20000.0 Hz, default: 2000.0, skew: 0.3 logarithmic)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "filter_cutoff", 1 },
-        "Filter Cutoff",
-        juce::NormalisableRange<float>(20.0f, 20000.0f, 0.1f, 0.3f),
-        2000.0f,
-        "Hz"
-    ));
-
-    // reverb_amount - Float (0.0 to 1.0, default: 0.4, linear)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "reverb_amount", 1 },
-        "Reverb Amount",
-        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f, 1.0f),
-        0.4f
-    ));
-
-    return layout;
+    return pfs::createParameterLayout(lushPadParameterTable);
 }
 
 LushPadAudioProcessor::LushPadAudioProcessor()
     : AudioProcessor(BusesProperties()
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, lushPadParameterTable)
+    , stateCodec(parameters, lushPadParameterTable)
 {
 }
 
@@ -67,17 +47,10 @@ void LushPadAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
     reverbParams.freezeMode = 0.0f;   // No freeze
     reverb.setParameters(reverbParams);
 
-    // Prepare DSP spec for mono per-voice filtering
-    juce::dsp::ProcessSpec voiceSpec;
-    voiceSpec.sampleRate = sampleRate;
-    voiceSpec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
-    voiceSpec.numChannels = 1;  // Mono per-voice
-
-    // Initialize all voices with filter preparation
+    // Initialize all voices (per-voice filters are designed on the audio thread, allocation-free)
     for (auto& voice : voices)
     {
         voice.adsr.setSampleRate(sampleRate);
-        voice.filter.prepare(voiceSpec);
         voice.reset();
     }
 }
@@ -159,11 +132,14 @@ void LushPadAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     // Clear output buffer
     buffer.clear();
 
-    // Handle MIDI events (sample-accurate timing)
-    for (const auto metadata : midiMessages)
-    {
-        auto message = metadata.getMessage();
+    // Read parameters (atomic, done once per buffer for efficiency)
+    float timbreValue = parameterCache.load(LushPadParam::Timbre);
+    float filterCutoffValue = parameterCache.load(LushPadParam::FilterCutoff);
+    float reverbAmountValue = parameterCache.load(LushPadParam::ReverbAmount);
 
+    // Handle MIDI events (sample-accurate: applied at each event's sample position)
+    auto handleMidiMessage = [&](const juce::MidiMessage& message)
+    {
         if (message.isNoteOn())
         {
             int note = message.getNoteNumber();
@@ -175,138 +151,123 @@ void LushPadAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
             int note = message.getNoteNumber();
             releaseVoice(note);
         }
-    }
-
-    // Read parameters (atomic, done once per buffer for efficiency)
-    float timbreValue = parameters.getRawParameterValue("timbre")->load();
-    float filterCutoffValue = parameters.getRawParameterValue("filter_cutoff")->load();
-    float reverbAmountValue = parameters.getRawParameterValue("reverb_amount")->load();
+    };
 
-    // Generate audio per-sample
-    const int numSamples = buffer.getNumSamples();
-
-    for (int sample = 0; sample < numSamples; ++sample)
+    // Generate audio per-sample for the span between two MIDI events
+    auto renderVoices = [&](int startSample, int numSubSamples)
     {
-        float mixL = 0.0f;
-        float mixR = 0.0f;
+        updateVoiceFilters(filterCutoffValue, numSubSamples);
 
-        // Process all active voices
-        for (auto& voice : voices)
+        for (int sample = startSample; sample < startSample + numSubSamples; ++sample)
         {
-            if (!voice.active)
-                continue;
-
-            // Update nested LFO system
-            updateVoiceLFOs(voice);
-
-            // Get LFO modulation values
-            float panModulation = voice.lfoSmoothed[0];    // LFO1: -1 to +1 (panning)
-            float fmModulation = voice.lfoSmoothed[1];     // LFO2: -1 to +1 (FM depth)
-            float satModulation = voice.lfoSmoothed[2];    // LFO3: -1 to +1 (saturation)
-
-            // Calculate modulated FM feedback depth
-            float baseFeedbackDepth = timbreValue * 0.4f;
-            float modulatedFeedback = baseFeedbackDepth * (1.0f + fmModulation * 0.2f);  // ±20%
-            modulatedFeedback = juce::jlimit(0.0f, 0.4f, modulatedFeedback);
-
-            // Calculate modulated saturation gain
-            float baseSaturationGain = 1.0f + (timbreValue * 2.0f);
-            float modulatedSaturation = baseSaturationGain * (1.0f + satModulation * 0.15f);  // ±15%
-            modulatedSaturation = juce::jlimit(1.0f, 3.0f, modulatedSaturation);
-
-            // Calculate pan position (0.0 = left, 0.5 = center, 1.0 = right)
-            float panValue = 0.5f + (panModulation * 0.3f);  // ±30% from center
-            panValue = juce::jlimit(0.0f, 1.0f, panValue);
-
-            // Calculate base frequency for this MIDI note
-            // f = 440 * 2^((note - 69) / 12)
-            float baseFreq = 440.0f * std::pow(2.0f, (voice.currentNote - 69) / 12.0f);
-
-            // Detuning ratios
-            // +7 cents: 2^(7/1200) ≈ 1.00407
-            // -7 cents: 2^(-7/1200) ≈ 0.99593
-            float ratio1 = 1.0f;       // Base frequency
-            float ratio2 = 1.00407f;   // +7 cents
-            float ratio3 = 0.99593f;   // -7 cents
-
-            // Generate 3 detuned sine oscillators WITH modulated FM feedback
-            // Formula: sin(phase + modulatedFeedback * previousOutput)
-            float osc1 = std::sin(voice.phase1 + modulatedFeedback * voice.previousOutput1);
-            float osc2 = std::sin(voice.phase2 + modulatedFeedback * voice.previousOutput2);
-            float osc3 = std::sin(voice.phase3 + modulatedFeedback * voice.previousOutput3);
-
-            // Store outputs for next sample's feedback
-            voice.previousOutput1 = osc1;
-            voice.previousOutput2 = osc2;
-            voice.previousOutput3 = osc3;
-
-            // Sum oscillators (average to prevent clipping)
-            float voiceOutput = (osc1 + osc2 + osc3) / 3.0f;
-
-            // Apply modulated harmonic saturation using tanh waveshaping
-            voiceOutput = std::tanh(modulatedSaturation * voiceOutput);
-
-            // Calculate velocity-scaled filter cutoff
-            // Soft notes (low velocity): darker sound (cutoff reduced by 50%)
-            // Hard notes (high velocity): brighter sound (cutoff at parameter value)
-            float velocityScaledCutoff = filterCutoffValue * (0.5f + 0.5f * voice.currentVelocity);
-
-            // Clamp to valid range
-            velocityScaledCutoff = juce::jlimit(20.0f, 20000.0f, velocityScaledCutoff);
-
-            // Update filter coefficients (12dB/octave low-pass, Q=0.35)
-            auto coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(
-                currentSampleRate,
-                velocityScaledCutoff,
-                0.35f  // Fixed resonance
-            );
-            *voice.filter.coefficients = *coefficients;
-
-            // Process through filter
-            voiceOutput = voice.filter.processSample(voiceOutput);
-
-            // Apply ADSR envelope
-            float envelope = voice.adsr.getNextSample();
-            voiceOutput *= envelope * voice.currentVelocity;
-
-            // Apply LFO-modulated panning
-            float leftGain = 1.0f - panValue;
-            float rightGain = panValue;
-
-            mixL += voiceOutput * leftGain;
-            mixR += voiceOutput * rightGain;
-
-            // Update oscillator phases
-            float phaseIncrement1 = (baseFreq * ratio1 * juce::MathConstants<float>::twoPi) / static_cast<float>(currentSampleRate);
-            float phaseIncrement2 = (baseFreq * ratio2 * juce::MathConstants<float>::twoPi) / static_cast<float>(currentSampleRate);
-            float phaseIncrement3 = (baseFreq * ratio3 * juce::MathConstants<float>::twoPi) / static_cast<float>(currentSampleRate);
-
-            voice.phase1 += phaseIncrement1;
-            voice.phase2 += phaseIncrement2;
-            voice.phase3 += phaseIncrement3;
-
-            // Wrap phases to [0, 2π] to prevent denormals
-            while (voice.phase1 >= juce::MathConstants<float>::twoPi)
-                voice.phase1 -= juce::MathConstants<float>::twoPi;
-            while (voice.phase2 >= juce::MathConstants<float>::twoPi)
-                voice.phase2 -= juce::MathConstants<float>::twoPi;
-            while (voice.phase3 >= juce::MathConstants<float>::twoPi)
-                voice.phase3 -= juce::MathConstants<float>::twoPi;
-
-            // Mark voice inactive if envelope has finished
-            if (!voice.adsr.isActive())
+            float mixL = 0.0f;
+            float mixR = 0.0f;
+
+            // Process all active voices
+            for (auto& voice : voices)
             {
-                voice.active = false;
+                if (!voice.active)
+                    continue;
+
+                // Update nested LFO system
+                updateVoiceLFOs(voice);
+
+                // Get LFO modulation values
+                float panModulation = voice.lfoSmoothed[0];    // LFO1: -1 to +1 (panning)
+                float fmModulation = voice.lfoSmoothed[1];     // LFO2: -1 to +1 (FM depth)
+                float satModulation = voice.lfoSmoothed[2];    // LFO3: -1 to +1 (saturation)
+
+                // Calculate modulated FM feedback depth
+                float baseFeedbackDepth = timbreValue * 0.4f;
+                float modulatedFeedback = baseFeedbackDepth * (1.0f + fmModulation * 0.2f);  // ±20%
+                modulatedFeedback = juce::jlimit(0.0f, 0.4f, modulatedFeedback);
+
+                // Calculate modulated saturation gain
+                float baseSaturationGain = 1.0f + (timbreValue * 2.0f);
+                float modulatedSaturation = baseSaturationGain * (1.0f + satModulation * 0.15f);  // ±15%
+                modulatedSaturation = juce::jlimit(1.0f, 3.0f, modulatedSaturation);
+
+                // Calculate pan position (0.0 = left, 0.5 = center, 1.0 = right)
+                float panValue = 0.5f + (panModulation * 0.3f);  // ±30% from center
+                panValue = juce::jlimit(0.0f, 1.0f, panValue);
+
+                // Calculate base frequency for this MIDI note
+                // f = 440 * 2^((note - 69) / 12)
+                float baseFreq = 440.0f * std::pow(2.0f, (voice.currentNote - 69) / 12.0f);
+
+                // Detuning ratios
+                // +7 cents: 2^(7/1200) ≈ 1.00407
+                // -7 cents: 2^(-7/1200) ≈ 0.99593
+                float ratio1 = 1.0f;       // Base frequency
+                float ratio2 = 1.00407f;   // +7 cents
+                float ratio3 = 0.99593f;   // -7 cents
+
+                // Generate 3 detuned sine oscillators WITH modulated FM feedback
+                // Formula: sin(phase + modulatedFeedback * previousOutput)
+                float osc1 = std::sin(voice.phase1 + modulatedFeedback * voice.previousOutput1);
+                float osc2 = std::sin(voice.phase2 + modulatedFeedback * voice.previousOutput2);
+                float osc3 = std::sin(voice.phase3 + modulatedFeedback * voice.previousOutput3);
+
+                // Store outputs for next sample's feedback
+                voice.previousOutput1 = osc1;
+                voice.previousOutput2 = osc2;
+                voice.previousOutput3 = osc3;
+
+                // Sum oscillators (average to prevent clipping)
+                float voiceOutput = (osc1 + osc2 + osc3) / 3.0f;
+
+                // Apply modulated harmonic saturation using tanh waveshaping
+                voiceOutput = pfs::saturation::tanh(modulatedSaturation * voiceOutput);
+
+                // Process through filter (coefficients set per span, see updateVoiceFilters)
+                voiceOutput = voice.filter.processSample(voiceOutput);
+
+                // Apply ADSR envelope
+                float envelope = voice.adsr.getNextSample();
+                voiceOutput *= envelope * voice.currentVelocity;
+
+                // Apply LFO-modulated panning
+                float leftGain = 1.0f - panValue;
+                float rightGain = panValue;
+
+                mixL += voiceOutput * leftGain;
+                mixR += voiceOutput * rightGain;
+
+                // Update oscillator phases
+                float phaseIncrement1 = (baseFreq * ratio1 * juce::MathConstants<float>::twoPi) / static_cast<float>(currentSampleRate);
+                float phaseIncrement2 = (baseFreq * ratio2 * juce::MathConstants<float>::twoPi) / static_cast<float>(currentSampleRate);
+                float phaseIncrement3 = (baseFreq * ratio3 * juce::MathConstants<float>::twoPi) / static_cast<float>(currentSampleRate);
+
+                voice.phase1 += phaseIncrement1;
+                voice.phase2 += phaseIncrement2;
+                voice.phase3 += phaseIncrement3;
+
+                // Wrap phases to [0, 2π] to prevent denormals
+                while (voice.phase1 >= juce::MathConstants<float>::twoPi)
+                    voice.phase1 -= juce::MathConstants<float>::twoPi;
+                while (voice.phase2 >= juce::MathConstants<float>::twoPi)
+                    voice.phase2 -= juce::MathConstants<float>::twoPi;
+                while (voice.phase3 >= juce::MathConstants<float>::twoPi)
+                    voice.phase3 -= juce::MathConstants<float>::twoPi;
+
+                // Mark voice inactive if envelope has finished
+                if (!voice.adsr.isActive())
+                {
+                    voice.active = false;
+                }
             }
-        }
 
-        // Write to output buffer (reduce gain to prevent clipping with 8 voices)
-        buffer.setSample(0, sample, mixL * 0.3f);
-        if (totalNumOutputChannels > 1)
-        {
-            buffer.setSample(1, sample, mixR * 0.3f);
+            // Write to output buffer (reduce gain to prevent clipping with 8 voices)
+            buffer.setSample(0, sample, mixL * 0.3f);
+            if (totalNumOutputChannels > 1)
+            {
+                buffer.setSample(1, sample, mixR * 0.3f);
+            }
         }
-    }
+    };
+
+    // Split the block at every MIDI event so notes start on their exact sample
+    pfs::renderWithSampleAccurateMidi(midiMessages, buffer.getNumSamples(), handleMidiMessage, renderVoices);
 
     // Apply global reverb with reverb_amount parameter controlling wet/dry
     juce::dsp::AudioBlock<float> block(buffer);
@@ -325,24 +286,36 @@ void LushPadAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     reverb.process(context);
 }
 
+#if PLUGIN_DSP_ONLY
+bool LushPadAudioProcessor::hasEditor() const
+{
+    return false;
+}
+
+juce::AudioProcessorEditor* LushPadAudioProcessor::createEditor()
+{
+    return nullptr;
+}
+#else
+bool LushPadAudioProcessor::hasEditor() const
+{
+    return true;
+}
+
 juce::AudioProcessorEditor* LushPadAudioProcessor::createEditor()
 {
     return new LushPadAudioProcessorEditor(*this);
 }
+#endif
 
 void LushPadAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    stateCodec.save(destData);
 }
 
 void LushPadAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState != nullptr && xmlState->hasTagName(parameters.state.getType()))
-        parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    stateCodec.load(data, sizeInBytes);
 }
 
 // Voice allocation helper methods
@@ -384,11 +357,44 @@ void LushPadAudioProcessor::releaseVoice(int note)
     }
 }
 
+void LushPadAudioProcessor::updateVoiceFilters(float filterCutoffValue, int numSamples)
+{
+    for (auto& voice : voices)
+    {
+        if (!voice.active)
+            continue;
+
+        // Calculate velocity-scaled filter cutoff
+        // Soft notes (low velocity): darker sound (cutoff reduced by 50%)
+        // Hard notes (high velocity): brighter sound (cutoff at parameter value)
+        float velocityScaledCutoff = filterCutoffValue * (0.5f + 0.5f * voice.currentVelocity);
+
+        // Clamp to valid range
+        velocityScaledCutoff = juce::jlimit(20.0f, 20000.0f, velocityScaledCutoff);
+
+        if (velocityScaledCutoff == voice.filterCutoff)
+            continue;
+
+        // 12dB/octave low-pass, Q=0.35 - designed in place (no allocation)
+        const auto coefficients = pfs::BiquadCoefficients::lowPass(
+            currentSampleRate, velocityScaledCutoff, 0.35f, pfs::TanMode::Fast);
+
+        // New note: start on the exact response. Cutoff moves: glide across the span.
+        if (voice.filterCutoff <= 0.0f)
+            voice.filter.setCoefficients(coefficients);
+        else
+            voice.filter.rampTo(coefficients, numSamples);
+
+        voice.filterCutoff = velocityScaledCutoff;
+    }
+}
+
 void LushPadAudioProcessor::startVoice(SynthVoice& voice, int note, float velocity)
 {
     voice.active = true;
     voice.currentNote = note;
     voice.currentVelocity = velocity;
+    voice.filterCutoff = 0.0f;  // Redesign the filter for the new velocity
     voice.timestamp = voiceCounter++;
     voice.phase1 = voice.phase2 = voice.phase3 = 0.0f;
 
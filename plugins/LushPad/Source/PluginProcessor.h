@@ -1,6 +1,8 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "Parameters.h"
+#include "BiquadDesigner.h"
 
 class LushPadAudioProcessor : public juce::AudioProcessor
 {
@@ -13,7 +15,7 @@ public:
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override { return true; }
+    bool hasEditor() const override;
 
     const juce::String getName() const override { return "LushPad"; }
     bool acceptsMidi() const override { return true; }  // Synth accepts MIDI
@@ -55,7 +57,8 @@ private:
         float previousOutput3 = 0.0f;
 
         // Low-pass filter per voice
-        juce::dsp::IIR::Filter<float> filter;
+        pfs::Biquad filter;
+        float filterCutoff = 0.0f;  // Cutoff the filter was designed for (0 = not yet designed)
 
         // Random LFO system (9 per voice)
         // Indices 0-2: Primary LFOs (panning, FM depth, saturation)
@@ -78,6 +81,7 @@ private:
             phase1 = phase2 = phase3 = 0.0f;
             previousOutput1 = previousOutput2 = previousOutput3 = 0.0f;
             filter.reset();
+            filterCutoff = 0.0f;
             adsr.reset();
 
             // Reset LFOs
@@ -109,6 +113,13 @@ private:
 
     // LFO update (nested modulation)
     void updateVoiceLFOs(SynthVoice& voice);
+    void updateVoiceFilters(float filterCutoffValue, int numSamples);
+
+    // Cached parameter pointers (declared after parameters - resolved from it)
+    LushPadParameterCache parameterCache;
+
+    // Binary get/setStateInformation (same table, resolved once)
+    LushPadStateCodec stateCodec;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LushPadAudioProcessor)
 };
@@ -0,0 +1,38 @@
+#pragma once
+#include "ParameterTable.h"
+#include "StateCodec.h"
+
+// Parameter table - single source of truth for IDs, ranges and defaults.
+// Order must match MinimalKickParam (it is also the host parameter order).
+enum class MinimalKickParam
+{
+    Sweep, Time, Attack, Decay, Drive,
+    Count
+};
+
+inline constexpr std::array minimalKickParameterTable
+{
+    // sweep - Pitch envelope amount (0.0 to 24.0 semitones, linear)
+    pfs::floatParameter("sweep", "Sweep", 0.0f, 24.0f, 0.1f, 1.0f, 12.0f, "st"),
+
+    // time - Pitch envelope decay time (5.0 to 500.0 ms, logarithmic)
+    pfs::floatParameter("time", "Time", 5.0f, 500.0f, 0.1f, 0.3f, 50.0f, "ms"),
+
+    // attack - Amplitude envelope attack time (0.0 to 50.0 ms, linear)
+    pfs::floatParameter("attack", "Attack", 0.0f, 50.0f, 0.1f, 1.0f, 5.0f, "ms"),
+
+    // decay - Amplitude envelope decay time (50.0 to 2000.0 ms, logarithmic)
+    pfs::floatParameter("decay", "Decay", 50.0f, 2000.0f, 1.0f, 0.3f, 400.0f, "ms"),
+
+    // drive - Saturation/distortion amount (0.0 to 100.0%, linear)
+    pfs::floatParameter("drive", "Drive", 0.0f, 100.0f, 0.1f, 1.0f, 20.0f, "%"),
+};
+
+static_assert(minimalKickParameterTable.size() == static_cast<size_t>(MinimalKickParam::Count));
+static_assert(pfs::isValidParameterTable(minimalKickParameterTable));
+static_assert(pfs::hasUniqueStateHashes(minimalKickParameterTable));
+
+using MinimalKickParameterCache = pfs::ParameterCache<MinimalKickParam, minimalKickParameterTable.size()>;
+using MinimalKickParameterSnapshot = MinimalKickParameterCache::Snapshot;
+using MinimalKickStateCodec = pfs::StateCodec<minimalKickParameterTable.size()>;
+
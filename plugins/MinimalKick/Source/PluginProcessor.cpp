@@ -1,62 +1,22 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+#include "MidiBlockSplitter.h"
+#include "Saturation.h"
+
+#if ! PLUGIN_DSP_ONLY
+ #include "PluginEditor.h"
+#endif
 
 juce::AudioProcessorValueTreeState::ParameterLayout MinimalKickAudioProcessor::createParameterLayout()
 {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-
-    // sweep - Pitch envelope amount (0.0 to 24.0 semitones, linear)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "sweep", 1 },
-        "Sweep",
-        juce::NormalisableRange<float>(0.0f, 24.0f, 0.1f),
-        12.0f,
-        "st"
-    ));
-
-    // time - Pitch envelope decay time (5.0 to 500.0 ms, logarithmic)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "time", 1 },
-        "Time",
-        juce::NormalisableRange<float>(5.0f, 500.0f, 0.1f, 0.3f),
-        50.0f,
-        "ms"
-    ));
-
-    // attack - Amplitude envelope attack time (0.0 to 50.0 ms, linear)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "attack", 1 },
-        "Attack",
-        juce::NormalisableRange<float>(0.0f, 50.0f, 0.1f),
-        5.0f,
-        "ms"
-    ));
-
-    // decay - Amplitude envelope decay time (50.0 to 2000.0 ms, logarithmic)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "decay", 1 },
-        "Decay",
-        juce::NormalisableRange<float>(50.0f, 2000.0f, 1.0f, 0.3f),
-        400.0f,
-        "ms"
-    ));
-
-    // drive - Saturation/distortion amount (0.0 to 100.0%, linear)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "drive", 1 },
-        "Drive",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
-        20.0f,
-        "%"
-    ));
-
-    return layout;
+    return pfs::createParameterLayout(minimalKickParameterTable);
 }
 
 MinimalKickAudioProcessor::MinimalKickAudioProcessor()
     : AudioProcessor(BusesProperties()
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, minimalKickParameterTable)
+    , stateCodec(parameters, minimalKickParameterTable)
 {
     // Initialize oscillator with sine wave
     oscillator.initialise([](float x) { return std::sin(x); }, 128);
@@ -96,11 +56,11 @@ void MinimalKickAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
     buffer.clear();
 
     // Read parameters (atomic, real-time safe)
-    auto* attackParam = parameters.getRawParameterValue("attack");
-    auto* decayParam = parameters.getRawParameterValue("decay");
-    auto* sweepParam = parameters.getRawParameterValue("sweep");
-    auto* timeParam = parameters.getRawParameterValue("time");
-    auto* driveParam = parameters.getRawParameterValue("drive");
+    auto* attackParam = &parameterCache[MinimalKickParam::Attack];
+    auto* decayParam = &parameterCache[MinimalKickParam::Decay];
+    auto* sweepParam = &parameterCache[MinimalKickParam::Sweep];
+    auto* timeParam = &parameterCache[MinimalKickParam::Time];
+    auto* driveParam = &parameterCache[MinimalKickParam::Drive];
 
     float attackMs = attackParam->load();
     float decayMs = decayParam->load();
@@ -108,11 +68,15 @@ void MinimalKickAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
     float pitchDecayMs = timeParam->load();
     float drivePercent = driveParam->load();
 
-    // Process MIDI messages
-    for (const auto metadata : midiMessages)
-    {
-        auto message = metadata.getMessage();
+    // Calculate pitch envelope decay rate
+    // Formula: decayRate = -log(0.001) / decayTimeSeconds
+    // This makes the envelope decay to 0.1% of initial value in the specified time
+    float pitchDecaySeconds = pitchDecayMs / 1000.0f;
+    float pitchDecayRate = -std::log(0.001f) / pitchDecaySeconds;
 
+    // MIDI handling, applied at each event's exact sample position
+    auto handleMidiMessage = [&](const juce::MidiMessage& message)
+    {
         if (message.isNoteOn())
         {
             // Store note and convert to frequency
@@ -143,21 +107,16 @@ void MinimalKickAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
             // Note-off can be ignored (sustain=0, envelope decays naturally)
             isNoteOn = false;
         }
-    }
-
-    // Generate audio if envelope is active
-    const int numSamples = buffer.getNumSamples();
+    };
 
-    if (envelope.isActive())
+    // Generate audio for the span between two MIDI events (if envelope is active)
+    auto renderKick = [&](int startSample, int numSubSamples)
     {
-        // Calculate pitch envelope decay rate
-        // Formula: decayRate = -log(0.001) / decayTimeSeconds
-        // This makes the envelope decay to 0.1% of initial value in the specified time
-        float pitchDecaySeconds = pitchDecayMs / 1000.0f;
-        float pitchDecayRate = -std::log(0.001f) / pitchDecaySeconds;
+        if (! envelope.isActive())
+            return;
 
         // Process mono (oscillator generates single channel)
-        for (int sample = 0; sample < numSamples; ++sample)
+        for (int sample = startSample; sample < startSample + numSubSamples; ++sample)
         {
             // Update pitch envelope (exponential decay)
             float elapsedSeconds = pitchEnvelopeSampleCount / static_cast<float>(sampleRate);
@@ -184,7 +143,7 @@ void MinimalKickAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
             // Apply saturation/drive (tanh waveshaping)
             float driveNormalized = drivePercent / 100.0f;  // 0.0 to 1.0
             float gain = 1.0f + (driveNormalized * 9.0f);   // 1.0 to 10.0
-            float outputSample = std::tanh(gain * envelopedSample);
+            float outputSample = pfs::saturation::tanh(gain * envelopedSample);
 
             // Write to both channels (mono to stereo)
             for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
@@ -192,27 +151,42 @@ void MinimalKickAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
                 buffer.setSample(channel, sample, outputSample);
             }
         }
-    }
+    };
+
+    // Split the block at every MIDI event so the kick starts on its exact sample
+    pfs::renderWithSampleAccurateMidi(midiMessages, buffer.getNumSamples(), handleMidiMessage, renderKick);
+}
+
+#if PLUGIN_DSP_ONLY
+bool MinimalKickAudioProcessor::hasEditor() const
+{
+    return false;
+}
+
+juce::AudioProcessorEditor* MinimalKickAudioProcessor::createEditor()
+{
+    return nullptr;
+}
+#else
+bool MinimalKickAudioProcessor::hasEditor() const
+{
+    return true;
 }
 
 juce::AudioProcessorEditor* MinimalKickAudioProcessor::createEditor()
 {
     return new MinimalKickAudioProcessorEditor(*this);
 }
+#endif
 
 void MinimalKickAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    stateCodec.save(destData);
 }
 
 void MinimalKickAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState != nullptr && xmlState->hasTagName(parameters.state.getType()))
-        parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    stateCodec.load(data, sizeInBytes);
 }
 
 // Factory function
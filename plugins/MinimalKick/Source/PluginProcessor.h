@@ -1,6 +1,7 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "Parameters.h"
 
 class MinimalKickAudioProcessor : public juce::AudioProcessor
 {
@@ -13,7 +14,7 @@ public:
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override { return true; }
+    bool hasEditor() const override;
 
     const juce::String getName() const override { return "MinimalKick"; }
     bool acceptsMidi() const override { return true; }  // Instrument - accepts MIDI
@@ -50,5 +51,11 @@ private:
 
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // Cached parameter pointers (declared after parameters - resolved from it)
+    MinimalKickParameterCache parameterCache;
+
+    // Binary get/setStateInformation (same table, resolved once)
+    MinimalKickStateCodec stateCodec;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MinimalKickAudioProcessor)
 };
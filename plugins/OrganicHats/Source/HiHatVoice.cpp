@@ -1,7 +1,7 @@
 #include "HiHatVoice.h"
 
-HiHatVoice::HiHatVoice(juce::AudioProcessorValueTreeState& apvts)
-    : parameters(apvts)
+HiHatVoice::HiHatVoice(const OrganicHatsParameterCache& parameterCache)
+    : parameters(parameterCache)
 {
 }
 
@@ -14,8 +14,6 @@ void HiHatVoice::prepareToPlay(double sampleRate, int samplesPerBlock)
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
     spec.numChannels = 1;  // Per-voice mono processing
 
-    toneFilter.prepare(spec);
-    noiseColorFilter.prepare(spec);
     toneFilter.reset();
     noiseColorFilter.reset();
 
@@ -26,9 +24,10 @@ void HiHatVoice::prepareToPlay(double sampleRate, int samplesPerBlock)
 
     for (int i = 0; i < 3; ++i)
     {
+        // Coefficients before prepare() so the filter state is sized for second order
+        resonators[i].coefficients = pfs::BiquadCoefficients::peak(
+            sampleRate, peakFreqs[i], Q, juce::Decibels::decibelsToGain(gainDB)).makeStorage();
         resonators[i].prepare(spec);
-        *resonators[i].coefficients = *juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-            sampleRate, peakFreqs[i], Q, juce::Decibels::decibelsToGain(gainDB));
         resonators[i].reset();
     }
 }
@@ -46,14 +45,14 @@ void HiHatVoice::startNote(int midiNoteNumber, float velocity,
 
     // Store velocity as linear gain (0.0-1.0)
     velocityGain = velocity;
+    snapFilterCoefficients = true;
 
     // Configure ADSR based on note type
     if (isClosed)
     {
         // Closed hi-hat: Short decay, no sustain
         // Read CLOSED_DECAY parameter (20-200ms)
-        auto* decayParam = parameters.getRawParameterValue("CLOSED_DECAY");
-        float decayMs = decayParam->load();
+        float decayMs = parameters.load(OrganicHatsParam::ClosedDecay);
 
         juce::ADSR::Parameters adsrParams;
         adsrParams.attack = 0.0001f;   // 0.1ms attack
@@ -67,8 +66,7 @@ void HiHatVoice::startNote(int midiNoteNumber, float velocity,
     {
         // Open hi-hat: No decay, full sustain, long release
         // Read OPEN_RELEASE parameter (100-1000ms)
-        auto* releaseParam = parameters.getRawParameterValue("OPEN_RELEASE");
-        float releaseMs = releaseParam->load();
+        float releaseMs = parameters.load(OrganicHatsParam::OpenRelease);
 
         juce::ADSR::Parameters adsrParams;
         adsrParams.attack = 0.0001f;   // 0.1ms attack
@@ -111,11 +109,49 @@ void HiHatVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
         return;
 
     // Read parameters once per block (atomic reads)
-    const char* toneParamID = isClosed ? "CLOSED_TONE" : "OPEN_TONE";
-    const char* colorParamID = isClosed ? "CLOSED_NOISE_COLOR" : "OPEN_NOISE_COLOR";
+    const auto toneParam = isClosed ? OrganicHatsParam::ClosedTone : OrganicHatsParam::OpenTone;
+    const auto colorParam = isClosed ? OrganicHatsParam::ClosedNoiseColor : OrganicHatsParam::OpenNoiseColor;
 
-    float toneValue = parameters.getRawParameterValue(toneParamID)->load() / 100.0f;  // Normalize to 0.0-1.0
-    float colorValue = parameters.getRawParameterValue(colorParamID)->load() / 100.0f;
+    float toneValue = parameters.load(toneParam) / 100.0f;  // Normalize to 0.0-1.0
+    float colorValue = parameters.load(colorParam) / 100.0f;
+
+    // Filter coefficients are constant across the block: design them once, allocation-free.
+    // A fresh note starts on the exact response; later blocks glide across the block.
+    auto applyCoefficients = [this, numSamples](pfs::Biquad& filter, const pfs::BiquadCoefficients& coefficients)
+    {
+        if (snapFilterCoefficients)
+            filter.setCoefficients(coefficients);
+        else
+            filter.rampTo(coefficients, numSamples);
+    };
+
+    // Tone Filter - exponential frequency mapping: 3kHz-15kHz
+    float velocityToneMod = velocityGain * 0.3f;  // Up to +30% cutoff modulation
+    float baseFreq = 3000.0f * std::pow(5.0f, toneValue);
+    float finalCutoff = baseFreq * (1.0f + velocityToneMod);
+    finalCutoff = juce::jlimit(20.0f, 20000.0f, finalCutoff);
+
+    // LP below 50%, HP above 50%
+    applyCoefficients(toneFilter, toneValue < 0.5f
+                                      ? pfs::BiquadCoefficients::lowPass(currentSampleRate, finalCutoff, 0.707f)
+                                      : pfs::BiquadCoefficients::highPass(currentSampleRate, finalCutoff, 0.707f));
+
+    // Noise Color Filter - bypass zone at 50% ±2%
+    const bool colorFilterActive = std::abs(colorValue - 0.5f) > 0.02f;
+
+    if (colorFilterActive)
+    {
+        // Exponential frequency mapping: 5kHz-10kHz
+        float colorFreq = 5000.0f * std::pow(2.0f, (colorValue - 0.5f) * 2.0f);
+        colorFreq = juce::jlimit(20.0f, 20000.0f, colorFreq);
+
+        // LP below 50%, HP above 50%
+        applyCoefficients(noiseColorFilter, colorValue < 0.5f
+                                                ? pfs::BiquadCoefficients::lowPass(currentSampleRate, colorFreq, 0.707f)
+                                                : pfs::BiquadCoefficients::highPass(currentSampleRate, colorFreq, 0.707f));
+    }
+
+    snapFilterCoefficients = false;
 
     for (int sample = 0; sample < numSamples; ++sample)
     {
@@ -123,51 +159,11 @@ void HiHatVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
         float noiseSample = (noiseGenerator.nextFloat() * 2.0f) - 1.0f;
 
         // 2. Apply Tone Filter (brightness control)
-        // Exponential frequency mapping: 3kHz-15kHz
-        float velocityToneMod = velocityGain * 0.3f;  // Up to +30% cutoff modulation
-        float baseFreq = 3000.0f * std::pow(5.0f, toneValue);
-        float finalCutoff = baseFreq * (1.0f + velocityToneMod);
-        finalCutoff = juce::jlimit(20.0f, 20000.0f, finalCutoff);
-
-        // Update Tone Filter coefficients (LP below 50%, HP above 50%)
-        if (toneValue < 0.5f)
-        {
-            *toneFilter.coefficients = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
-                currentSampleRate, finalCutoff, 0.707f);
-        }
-        else
-        {
-            *toneFilter.coefficients = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
-                currentSampleRate, finalCutoff, 0.707f);
-        }
-
-        // Process through Tone Filter
         noiseSample = toneFilter.processSample(noiseSample);
 
-        // 3. Apply Noise Color Filter (warmth control)
-        // Bypass zone at 50% ±2%
-        if (std::abs(colorValue - 0.5f) > 0.02f)
-        {
-            // Exponential frequency mapping: 5kHz-10kHz
-            float colorFreq = 5000.0f * std::pow(2.0f, (colorValue - 0.5f) * 2.0f);
-            colorFreq = juce::jlimit(20.0f, 20000.0f, colorFreq);
-
-            // Update Noise Color Filter coefficients (LP below 50%, HP above 50%)
-            if (colorValue < 0.5f)
-            {
-                *noiseColorFilter.coefficients = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
-                    currentSampleRate, colorFreq, 0.707f);
-            }
-            else
-            {
-                *noiseColorFilter.coefficients = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
-                    currentSampleRate, colorFreq, 0.707f);
-            }
-
-            // Process through Noise Color Filter
+        // 3. Apply Noise Color Filter (warmth control) - bypass zone at 50% ±2%
+        if (colorFilterActive)
             noiseSample = noiseColorFilter.processSample(noiseSample);
-        }
-        // else: bypass (no filtering at 50%)
 
         // 4. Apply resonators (Phase 4.3) - Fixed peaks for organic body
         for (auto& resonator : resonators)
@@ -2,11 +2,13 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include "HiHatSound.h"
+#include "Parameters.h"
+#include "BiquadDesigner.h"
 
 class HiHatVoice : public juce::SynthesiserVoice
 {
 public:
-    HiHatVoice(juce::AudioProcessorValueTreeState& apvts);
+    HiHatVoice(const OrganicHatsParameterCache& parameterCache);
 
     bool canPlaySound(juce::SynthesiserSound* sound) override;
 
@@ -24,7 +26,7 @@ public:
     void prepareToPlay(double sampleRate, int samplesPerBlock);
 
 private:
-    juce::AudioProcessorValueTreeState& parameters;
+    const OrganicHatsParameterCache& parameters;
 
     // Noise generation
     juce::Random noiseGenerator;
@@ -32,9 +34,10 @@ private:
     // Envelope shaping
     juce::ADSR envelope;
 
-    // Filtering (Phase 4.2)
-    juce::dsp::IIR::Filter<float> toneFilter;
-    juce::dsp::IIR::Filter<float> noiseColorFilter;
+    // Filtering (Phase 4.2) - coefficients designed per block, no allocation
+    pfs::Biquad toneFilter;
+    pfs::Biquad noiseColorFilter;
+    bool snapFilterCoefficients = true;  // First block of a note: no glide from the previous note
 
     // Resonators (Phase 4.3) - Fixed peaks for organic body
     std::array<juce::dsp::IIR::Filter<float>, 3> resonators;
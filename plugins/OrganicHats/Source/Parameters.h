@@ -0,0 +1,33 @@
+#pragma once
+#include "ParameterTable.h"
+#include "StateCodec.h"
+
+// Parameter table - single source of truth for IDs, ranges and defaults.
+// Order must match OrganicHatsParam (it is also the host parameter order).
+enum class OrganicHatsParam
+{
+    ClosedTone, ClosedDecay, ClosedNoiseColor, OpenTone, OpenRelease, OpenNoiseColor,
+    Count
+};
+
+inline constexpr std::array organicHatsParameterTable
+{
+    // Closed Hi-Hat parameters
+    pfs::floatParameter("CLOSED_TONE", "Closed Tone", 0.0f, 100.0f, 0.01f, 1.0f, 50.0f, "%"),
+    pfs::floatParameter("CLOSED_DECAY", "Closed Decay", 20.0f, 200.0f, 0.1f, 1.0f, 80.0f, "ms"),
+    pfs::floatParameter("CLOSED_NOISE_COLOR", "Closed Noise Color", 0.0f, 100.0f, 0.01f, 1.0f, 50.0f, "%"),
+
+    // Open Hi-Hat parameters
+    pfs::floatParameter("OPEN_TONE", "Open Tone", 0.0f, 100.0f, 0.01f, 1.0f, 50.0f, "%"),
+    pfs::floatParameter("OPEN_RELEASE", "Open Release", 100.0f, 1000.0f, 0.1f, 1.0f, 400.0f, "ms"),
+    pfs::floatParameter("OPEN_NOISE_COLOR", "Open Noise Color", 0.0f, 100.0f, 0.01f, 1.0f, 50.0f, "%"),
+};
+
+static_assert(organicHatsParameterTable.size() == static_cast<size_t>(OrganicHatsParam::Count));
+static_assert(pfs::isValidParameterTable(organicHatsParameterTable));
+static_assert(pfs::hasUniqueStateHashes(organicHatsParameterTable));
+
+using OrganicHatsParameterCache = pfs::ParameterCache<OrganicHatsParam, organicHatsParameterTable.size()>;
+using OrganicHatsParameterSnapshot = OrganicHatsParameterCache::Snapshot;
+using OrganicHatsStateCodec = pfs::StateCodec<organicHatsParameterTable.size()>;
+
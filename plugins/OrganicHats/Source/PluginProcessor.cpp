@@ -1,5 +1,8 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+
+#if ! PLUGIN_DSP_ONLY
+ #include "PluginEditor.h"
+#endif
 #include "HiHatVoice.h"
 #include "HiHatSound.h"
 
@@ -7,10 +10,12 @@ OrganicHatsAudioProcessor::OrganicHatsAudioProcessor()
     : AudioProcessor(BusesProperties()
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "PARAMETERS", createParameterLayout())
+    , parameterCache(parameters, organicHatsParameterTable)
+    , stateCodec(parameters, organicHatsParameterTable)
 {
     // Add 16 voices for polyphony (8 closed + 8 open typical use)
     for (int i = 0; i < 16; ++i)
-        synth.addVoice(new HiHatVoice(parameters));
+        synth.addVoice(new HiHatVoice(parameterCache));
 
     // Add hi-hat sound descriptor
     synth.addSound(new HiHatSound());
@@ -18,59 +23,7 @@ OrganicHatsAudioProcessor::OrganicHatsAudioProcessor()
 
 juce::AudioProcessorValueTreeState::ParameterLayout OrganicHatsAudioProcessor::createParameterLayout()
 {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-
-    // Closed Hi-Hat parameters
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "CLOSED_TONE", 1 },
-        "Closed Tone",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.01f),
-        50.0f,
-        "%"
-    ));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "CLOSED_DECAY", 1 },
-        "Closed Decay",
-        juce::NormalisableRange<float>(20.0f, 200.0f, 0.1f),
-        80.0f,
-        "ms"
-    ));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "CLOSED_NOISE_COLOR", 1 },
-        "Closed Noise Color",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.01f),
-        50.0f,
-        "%"
-    ));
-
-    // Open Hi-Hat parameters
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "OPEN_TONE", 1 },
-        "Open Tone",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.01f),
-        50.0f,
-        "%"
-    ));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "OPEN_RELEASE", 1 },
-        "Open Release",
-        juce::NormalisableRange<float>(100.0f, 1000.0f, 0.1f),
-        400.0f,
-        "ms"
-    ));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "OPEN_NOISE_COLOR", 1 },
-        "Open Noise Color",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.01f),
-        50.0f,
-        "%"
-    ));
-
-    return layout;
+    return pfs::createParameterLayout(organicHatsParameterTable);
 }
 
 OrganicHatsAudioProcessor::~OrganicHatsAudioProcessor()
@@ -131,24 +84,36 @@ void OrganicHatsAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
     synth.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
 }
 
+#if PLUGIN_DSP_ONLY
+bool OrganicHatsAudioProcessor::hasEditor() const
+{
+    return false;
+}
+
+juce::AudioProcessorEditor* OrganicHatsAudioProcessor::createEditor()
+{
+    return nullptr;
+}
+#else
+bool OrganicHatsAudioProcessor::hasEditor() const
+{
+    return true;
+}
+
 juce::AudioProcessorEditor* OrganicHatsAudioProcessor::createEditor()
 {
     return new OrganicHatsAudioProcessorEditor(*this);
 }
+#endif
 
 void OrganicHatsAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    stateCodec.save(destData);
 }
 
 void OrganicHatsAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState != nullptr && xmlState->hasTagName(parameters.state.getType()))
-        parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    stateCodec.load(data, sizeInBytes);
 }
 
 // Factory function
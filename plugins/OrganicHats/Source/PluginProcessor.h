@@ -1,5 +1,6 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "Parameters.h"
 
 class OrganicHatsAudioProcessor : public juce::AudioProcessor
 {
@@ -12,7 +13,7 @@ public:
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override { return true; }
+    bool hasEditor() const override;
 
     const juce::String getName() const override { return "OrganicHats"; }
     bool acceptsMidi() const override { return true; }
@@ -37,5 +38,11 @@ private:
     // Synthesiser for hi-hat voice management
     juce::Synthesiser synth;
 
+    // Cached parameter pointers (declared after parameters - resolved from it)
+    OrganicHatsParameterCache parameterCache;
+
+    // Binary get/setStateInformation (same table, resolved once)
+    OrganicHatsStateCodec stateCodec;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OrganicHatsAudioProcessor)
 };
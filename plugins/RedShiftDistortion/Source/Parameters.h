@@ -0,0 +1,72 @@
+#pragma once
+#include "ParameterTable.h"
+#include "StateCodec.h"
+
+// Parameter table - single source of truth for IDs, ranges and defaults.
+// Order must match RedShiftDistortionParam (it is also the host parameter order).
+enum class RedShiftDistortionParam
+{
+    DelayTime,
+    PingPongAmount,
+    Feedback,
+    FilterBandLow,
+    FilterBandHigh,
+    Saturation,
+    MasterOutput,
+    BypassPingPong,
+    BypassDelay,
+    BypassSaturation,
+    BypassFilters,
+    BypassFeedback,
+    Count
+};
+
+inline constexpr std::array redShiftDistortionParameterTable
+{
+    // Main Controls (renamed/repurposed for tape delay architecture)
+    // delayTime - Tape delay time (user-controllable, replaces dopplerShift)
+    pfs::floatParameter("delayTime", "Delay Time", 10.0f, 2000.0f, 0.1f, 0.4f, 260.0f, "ms"),
+
+    // pingPongAmount - Ping-pong feedback amount (replaces stereoWidth)
+    pfs::floatParameter("pingPongAmount", "Ping Pong", 0.0f, 100.0f, 0.1f, 1.0f, 0.0f, "%"),
+
+    // feedback - Delay feedback amount (0-95%)
+    pfs::floatParameter("feedback", "Feedback", 0.0f, 95.0f, 0.1f, 1.0f, 0.0f, "%"),
+
+    // filterBandLow - Highpass cutoff in feedback loop
+    pfs::floatParameter("filterBandLow", "Lo-Cut", 20.0f, 20000.0f, 0.1f, 0.3f, 100.0f, "Hz"),
+
+    // filterBandHigh - Lowpass cutoff in feedback loop
+    pfs::floatParameter("filterBandHigh", "Hi-Cut", 20.0f, 20000.0f, 0.1f, 0.3f, 8000.0f, "Hz"),
+
+    // saturation - Tube saturation drive (in feedback loop)
+    pfs::floatParameter("saturation", "Saturation", -12.0f, 24.0f, 0.1f, 1.0f, 0.0f, "dB"),
+
+    // masterOutput - Final output level control
+    pfs::floatParameter("masterOutput", "Master Output", -60.0f, 12.0f, 0.1f, 2.0f, 0.0f, "dB"),
+
+    // Bypass Controls (4 bool parameters for tape delay architecture)
+    // bypassPingPong - Bypass ping-pong mode (replaces bypassStereoWidth)
+    pfs::boolParameter("bypassPingPong", "Bypass Ping Pong", false),
+
+    // bypassDelay - Bypass entire delay + feedback loop
+    pfs::boolParameter("bypassDelay", "Bypass Delay", false),
+
+    // bypassSaturation - Bypass tube saturation stage
+    pfs::boolParameter("bypassSaturation", "Bypass Saturation", false),
+
+    // bypassFilters - Bypass hi-cut and lo-cut filters
+    pfs::boolParameter("bypassFilters", "Bypass Filters", false),
+
+    // bypassFeedback - Bypass feedback loop
+    pfs::boolParameter("bypassFeedback", "Bypass Feedback", false),
+};
+
+static_assert(redShiftDistortionParameterTable.size() == static_cast<size_t>(RedShiftDistortionParam::Count));
+static_assert(pfs::isValidParameterTable(redShiftDistortionParameterTable));
+static_assert(pfs::hasUniqueStateHashes(redShiftDistortionParameterTable));
+
+using RedShiftDistortionParameterCache = pfs::ParameterCache<RedShiftDistortionParam, redShiftDistortionParameterTable.size()>;
+using RedShiftDistortionParameterSnapshot = RedShiftDistortionParameterCache::Snapshot;
+using RedShiftDistortionStateCodec = pfs::StateCodec<redShiftDistortionParameterTable.size()>;
+
@@ -1,116 +1,14 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+#include "Saturation.h"
+
+#if ! PLUGIN_DSP_ONLY
+ #include "PluginEditor.h"
+#endif
 
 // Parameter layout creation (BEFORE constructor)
 juce::AudioProcessorValueTreeState::ParameterLayout RedShiftDistortionAudioProcessor::createParameterLayout()
 {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-
-    // Main Controls (renamed/repurposed for tape delay architecture)
-
-    // delayTime - Tape delay time (user-controllable, replaces dopplerShift)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "delayTime", 1 },
-        "Delay Time",
-        juce::NormalisableRange<float>(10.0f, 2000.0f, 0.1f, 0.4f),  // Logarithmic skew
-        260.0f,  // Default matches old base delay
-        "ms"
-    ));
-
-    // pingPongAmount - Ping-pong feedback amount (replaces stereoWidth)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "pingPongAmount", 1 },
-        "Ping Pong",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        0.0f,  // Default: no ping-pong
-        "%"
-    ));
-
-    // feedback - Delay feedback amount (0-95%)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "feedback", 1 },
-        "Feedback",
-        juce::NormalisableRange<float>(0.0f, 95.0f, 0.1f, 1.0f),
-        0.0f,
-        "%"
-    ));
-
-    // filterBandLow - Highpass cutoff in feedback loop
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "filterBandLow", 1 },
-        "Lo-Cut",
-        juce::NormalisableRange<float>(20.0f, 20000.0f, 0.1f, 0.3f),  // Logarithmic skew
-        100.0f,
-        "Hz"
-    ));
-
-    // filterBandHigh - Lowpass cutoff in feedback loop
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "filterBandHigh", 1 },
-        "Hi-Cut",
-        juce::NormalisableRange<float>(20.0f, 20000.0f, 0.1f, 0.3f),  // Logarithmic skew
-        8000.0f,
-        "Hz"
-    ));
-
-    // saturation - Tube saturation drive (in feedback loop)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "saturation", 1 },
-        "Saturation",
-        juce::NormalisableRange<float>(-12.0f, 24.0f, 0.1f, 1.0f),
-        0.0f,
-        "dB"
-    ));
-
-    // masterOutput - Final output level control
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "masterOutput", 1 },
-        "Master Output",
-        juce::NormalisableRange<float>(-60.0f, 12.0f, 0.1f, 2.0f),  // Logarithmic skew
-        0.0f,
-        "dB"
-    ));
-
-    // Bypass Controls (4 bool parameters for tape delay architecture)
-
-    // bypassPingPong - Bypass ping-pong mode (replaces bypassStereoWidth)
-    layout.add(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { "bypassPingPong", 1 },
-        "Bypass Ping Pong",
-        false
-    ));
-
-    // bypassDelay - Bypass entire delay + feedback loop
-    layout.add(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { "bypassDelay", 1 },
-        "Bypass Delay",
-        false
-    ));
-
-    // bypassSaturation - Bypass tube saturation stage
-    layout.add(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { "bypassSaturation", 1 },
-        "Bypass Saturation",
-        false
-    ));
-
-    // bypassFilters - Bypass hi-cut and lo-cut filters
-    layout.add(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { "bypassFilters", 1 },
-        "Bypass Filters",
-        false
-    ));
-
-    // bypassFeedback - Bypass feedback loop
-    layout.add(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { "bypassFeedback", 1 },
-        "Bypass Feedback",
-        false
-    ));
-
-    // Note: Granular-specific parameters (grainSize, grainOverlap) removed for tape delay architecture
-
-    return layout;
+    return pfs::createParameterLayout(redShiftDistortionParameterTable);
 }
 
 RedShiftDistortionAudioProcessor::RedShiftDistortionAudioProcessor()
@@ -118,6 +16,8 @@ RedShiftDistortionAudioProcessor::RedShiftDistortionAudioProcessor()
                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, redShiftDistortionParameterTable)
+    , stateCodec(parameters, redShiftDistortionParameterTable)
 {
 }
 
@@ -149,13 +49,20 @@ void RedShiftDistortionAudioProcessor::prepareToPlay(double sampleRate, int samp
 
     // Prepare saturation waveshapers
     saturationL.prepare(spec);
-    saturationL.functionToUse = [](float x) { return std::tanh(x); };
+    saturationL.functionToUse = [](float x) { return pfs::saturation::tanh(x); };
     saturationL.reset();
 
     saturationR.prepare(spec);
-    saturationR.functionToUse = [](float x) { return std::tanh(x); };
+    saturationR.functionToUse = [](float x) { return pfs::saturation::tanh(x); };
     saturationR.reset();
 
+    // Allocate second-order coefficient storage once (processBlock rewrites it in place) -
+    // set before prepare() so the filter state is sized for it up front
+    hiPassFilterL.coefficients = pfs::BiquadCoefficients::highPass(sampleRate, 100.0f, 0.707f).makeStorage();
+    hiPassFilterR.coefficients = pfs::BiquadCoefficients::highPass(sampleRate, 100.0f, 0.707f).makeStorage();
+    loPassFilterL.coefficients = pfs::BiquadCoefficients::lowPass(sampleRate, 8000.0f, 0.707f).makeStorage();
+    loPassFilterR.coefficients = pfs::BiquadCoefficients::lowPass(sampleRate, 8000.0f, 0.707f).makeStorage();
+
     // Phase 2.2: Prepare dual-band filters
     hiPassFilterL.prepare(spec);
     hiPassFilterL.reset();
@@ -169,12 +76,6 @@ void RedShiftDistortionAudioProcessor::prepareToPlay(double sampleRate, int samp
     loPassFilterR.prepare(spec);
     loPassFilterR.reset();
 
-    // Initialize filter coefficients (will be updated in processBlock when parameters change)
-    *hiPassFilterL.coefficients = *juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, 100.0, 0.707);
-    *hiPassFilterR.coefficients = *juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, 100.0, 0.707);
-    *loPassFilterL.coefficients = *juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, 8000.0, 0.707);
-    *loPassFilterR.coefficients = *juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, 8000.0, 0.707);
-
     // Reset feedback state
     feedbackStateL = 0.0f;
     feedbackStateR = 0.0f;
@@ -200,20 +101,20 @@ void RedShiftDistortionAudioProcessor::processBlock(juce::AudioBuffer<float>& bu
         buffer.clear(i, 0, buffer.getNumSamples());
 
     // Read parameters for one-sided tape delay architecture
-    auto* delayTimeParam = parameters.getRawParameterValue("delayTime");
-    auto* pingPongAmountParam = parameters.getRawParameterValue("pingPongAmount");
-    auto* bypassDelayParam = parameters.getRawParameterValue("bypassDelay");
-    auto* bypassPingPongParam = parameters.getRawParameterValue("bypassPingPong");
-    auto* masterOutputParam = parameters.getRawParameterValue("masterOutput");
+    auto* delayTimeParam = &parameterCache[RedShiftDistortionParam::DelayTime];
+    auto* pingPongAmountParam = &parameterCache[RedShiftDistortionParam::PingPongAmount];
+    auto* bypassDelayParam = &parameterCache[RedShiftDistortionParam::BypassDelay];
+    auto* bypassPingPongParam = &parameterCache[RedShiftDistortionParam::BypassPingPong];
+    auto* masterOutputParam = &parameterCache[RedShiftDistortionParam::MasterOutput];
 
     // Feedback loop parameters (unchanged from granular version)
-    auto* feedbackParam = parameters.getRawParameterValue("feedback");
-    auto* saturationParam = parameters.getRawParameterValue("saturation");
-    auto* filterBandLowParam = parameters.getRawParameterValue("filterBandLow");
-    auto* filterBandHighParam = parameters.getRawParameterValue("filterBandHigh");
-    auto* bypassSaturationParam = parameters.getRawParameterValue("bypassSaturation");
-    auto* bypassFiltersParam = parameters.getRawParameterValue("bypassFilters");
-    auto* bypassFeedbackParam = parameters.getRawParameterValue("bypassFeedback");
+    auto* feedbackParam = &parameterCache[RedShiftDistortionParam::Feedback];
+    auto* saturationParam = &parameterCache[RedShiftDistortionParam::Saturation];
+    auto* filterBandLowParam = &parameterCache[RedShiftDistortionParam::FilterBandLow];
+    auto* filterBandHighParam = &parameterCache[RedShiftDistortionParam::FilterBandHigh];
+    auto* bypassSaturationParam = &parameterCache[RedShiftDistortionParam::BypassSaturation];
+    auto* bypassFiltersParam = &parameterCache[RedShiftDistortionParam::BypassFilters];
+    auto* bypassFeedbackParam = &parameterCache[RedShiftDistortionParam::BypassFeedback];
 
     // Load parameter values
     float delayTimeMs = delayTimeParam->load();
@@ -262,10 +163,13 @@ void RedShiftDistortionAudioProcessor::processBlock(juce::AudioBuffer<float>& bu
     actualFilterBandLow = juce::jlimit(20.0f, 20000.0f, actualFilterBandLow);
     actualFilterBandHigh = juce::jlimit(20.0f, 20000.0f, actualFilterBandHigh);
 
-    *hiPassFilterL.coefficients = *juce::dsp::IIR::Coefficients<float>::makeHighPass(currentSampleRate, actualFilterBandLow, 0.707);
-    *hiPassFilterR.coefficients = *juce::dsp::IIR::Coefficients<float>::makeHighPass(currentSampleRate, actualFilterBandLow, 0.707);
-    *loPassFilterL.coefficients = *juce::dsp::IIR::Coefficients<float>::makeLowPass(currentSampleRate, actualFilterBandHigh, 0.707);
-    *loPassFilterR.coefficients = *juce::dsp::IIR::Coefficients<float>::makeLowPass(currentSampleRate, actualFilterBandHigh, 0.707);
+    // Designed in place: the second-order storage was allocated in prepareToPlay
+    const auto hiPassCoefficients = pfs::BiquadCoefficients::highPass(currentSampleRate, actualFilterBandLow, 0.707f);
+    const auto loPassCoefficients = pfs::BiquadCoefficients::lowPass(currentSampleRate, actualFilterBandHigh, 0.707f);
+    hiPassCoefficients.copyTo(*hiPassFilterL.coefficients);
+    hiPassCoefficients.copyTo(*hiPassFilterR.coefficients);
+    loPassCoefficients.copyTo(*loPassFilterL.coefficients);
+    loPassCoefficients.copyTo(*loPassFilterR.coefficients);
 
     // Calculate saturation gain
     float saturationGain = std::pow(10.0f, saturationDB / 20.0f);
@@ -274,24 +178,9 @@ void RedShiftDistortionAudioProcessor::processBlock(juce::AudioBuffer<float>& bu
     auto* leftChannel = buffer.getWritePointer(0);
     auto* rightChannel = buffer.getWritePointer(1);
 
-    // Tube saturation function (asymmetrical)
+    // Tube saturation function (asymmetrical, shared kernel - per sample inside the feedback loop)
     auto tubeSaturation = [](float input, float gain) -> float {
-        float driven = input * gain;
-        const float asymmetry = 0.15f;
-
-        if (driven > 0.0f)
-        {
-            float positiveDrive = driven * (1.0f + asymmetry);
-            float saturated = std::tanh(positiveDrive);
-            float secondHarmonic = driven * driven * 0.1f;
-            return saturated + secondHarmonic * (1.0f - saturated);
-        }
-        else
-        {
-            float negativeDrive = driven * (1.0f - asymmetry);
-            float saturated = std::tanh(negativeDrive);
-            return saturated * 0.95f;
-        }
+        return pfs::saturation::asymmetricTube(input * gain);
     };
 
     // Process each sample - ONE-SIDED TAPE DELAY ARCHITECTURE
@@ -405,24 +294,36 @@ void RedShiftDistortionAudioProcessor::processBlock(juce::AudioBuffer<float>& bu
     buffer.applyGain(masterGain);
 }
 
+#if PLUGIN_DSP_ONLY
+bool RedShiftDistortionAudioProcessor::hasEditor() const
+{
+    return false;
+}
+
+juce::AudioProcessorEditor* RedShiftDistortionAudioProcessor::createEditor()
+{
+    return nullptr;
+}
+#else
+bool RedShiftDistortionAudioProcessor::hasEditor() const
+{
+    return true;
+}
+
 juce::AudioProcessorEditor* RedShiftDistortionAudioProcessor::createEditor()
 {
     return new RedShiftDistortionAudioProcessorEditor(*this);
 }
+#endif
 
 void RedShiftDistortionAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    stateCodec.save(destData);
 }
 
 void RedShiftDistortionAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState != nullptr && xmlState->hasTagName(parameters.state.getType()))
-        parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    stateCodec.load(data, sizeInBytes);
 }
 
 // Factory function
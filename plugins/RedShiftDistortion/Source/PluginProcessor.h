@@ -1,6 +1,8 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "Parameters.h"
+#include "BiquadDesigner.h"
 
 class RedShiftDistortionAudioProcessor : public juce::AudioProcessor
 {
@@ -13,7 +15,7 @@ public:
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override { return true; }
+    bool hasEditor() const override;
 
     const juce::String getName() const override { return "RedShiftDistortion"; }
     bool acceptsMidi() const override { return false; }  // Audio effect, not instrument
@@ -79,5 +81,11 @@ private:
     // Cached sample rate for delay time calculations
     double currentSampleRate = 44100.0;
 
+    // Cached parameter pointers (declared after parameters - resolved from it)
+    RedShiftDistortionParameterCache parameterCache;
+
+    // Binary get/setStateInformation (same table, resolved once)
+    RedShiftDistortionStateCodec stateCodec;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RedShiftDistortionAudioProcessor)
 };
@@ -0,0 +1,115 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+
+//==============================================================================
+/**
+    Scatter's grain source: a stereo ring buffer with one write head and
+    stateless fractional reads.
+
+    Positions are absolute sample indices (samples written since clear()), so
+    any number of grains can read anywhere in the last getCapacity() samples
+    without touching shared state - unlike juce::dsp::DelayLine::popSample,
+    which advances the line's read pointer on every call.
+
+    Reads are 4-point, 3rd-order Lagrange (the interpolation of the DelayLine
+    this replaces) over position - 1 .. position + 2. The capacity is a power
+    of two, so wrapping is a mask. Lane-parallel renderers fetch the points
+    with readPoints() and run interpolate() on vectors.
+*/
+class GrainBuffer
+{
+public:
+    static constexpr int numChannels = 2;
+
+    /** Message thread: allocates at least minimumCapacity samples per channel and clears. */
+    void prepare(int minimumCapacity)
+    {
+        const auto capacity = juce::nextPowerOfTwo(juce::jmax(4, minimumCapacity));
+        samples.setSize(numChannels, capacity);
+        mask = capacity - 1;
+        clear();
+    }
+
+    void clear() noexcept
+    {
+        samples.clear();
+        writePosition = 0;
+    }
+
+    int getCapacity() const noexcept                { return mask + 1; }
+
+    /** Absolute position of the next sample write() stores. */
+    juce::int64 getWritePosition() const noexcept   { return writePosition; }
+
+    //==============================================================================
+    /** Appends numSamples per channel (pass the same pointer twice for a mono source). */
+    void write(const float* left, const float* right, int numSamples) noexcept
+    {
+        jassert(numSamples <= getCapacity());
+
+        const float* sources[numChannels] = { left, right };
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* destination = samples.getWritePointer(channel);
+            const auto start = static_cast<int>(writePosition & mask);
+            const auto firstPart = juce::jmin(numSamples, getCapacity() - start);
+
+            juce::FloatVectorOperations::copy(destination + start, sources[channel], firstPart);
+            juce::FloatVectorOperations::copy(destination, sources[channel] + firstPart, numSamples - firstPart);
+        }
+
+        writePosition += numSamples;
+    }
+
+    /** Both channels at absolute position + fraction (0 <= fraction < 1). The
+        position must lie between 1 and getCapacity() - 3 samples behind the write head.
+    */
+    void read(juce::int64 position, float fraction, float& left, float& right) const noexcept
+    {
+        float l[4], r[4];
+        readPoints(position, l, r, 1);
+
+        left = interpolate(fraction, l[0], l[1], l[2], l[3]);
+        right = interpolate(fraction, r[0], r[1], r[2], r[3]);
+    }
+
+    /** The interpolation points of both channels for position (position - 1 .. position + 2),
+        written `stride` floats apart. Same position limits as read().
+    */
+    void readPoints(juce::int64 position, float* left, float* right, int stride) const noexcept
+    {
+        jassert(position + 2 < writePosition && writePosition - position < getCapacity() - 1);
+
+        const auto* l = samples.getReadPointer(0);
+        const auto* r = samples.getReadPointer(1);
+        auto index = static_cast<int>((position - 1) & mask);
+
+        for (int point = 0; point < 4; ++point)
+        {
+            left[point * stride] = l[index];
+            right[point * stride] = r[index];
+            index = (index + 1) & mask;
+        }
+    }
+
+    /** Lagrange interpolation between x0 and x1 (0 <= fraction < 1) from the points at -1, 0, 1, 2.
+        T is float or a SIMD register.
+    */
+    template <typename T>
+    static T interpolate(T fraction, T xMinus1, T x0, T x1, T x2) noexcept
+    {
+        const auto lowerPair = (fraction + 1.0f) * fraction;             // (t + 1) t
+        const auto upperPair = (fraction - 1.0f) * (fraction - 2.0f);    // (t - 1)(t - 2)
+
+        return xMinus1 * (fraction * upperPair * (-1.0f / 6.0f))
+             + x0 * ((fraction + 1.0f) * upperPair * 0.5f)
+             + x1 * (lowerPair * (fraction - 2.0f) * -0.5f)
+             + x2 * (lowerPair * (fraction - 1.0f) * (1.0f / 6.0f));
+    }
+
+private:
+    juce::AudioBuffer<float> samples;
+    int mask = 0;
+    juce::int64 writePosition = 0;
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include "ParameterTable.h"
+#include "StateCodec.h"
+
+// Parameter table - single source of truth for IDs, ranges and defaults.
+// Order must match ScatterParam (it is also the host parameter order).
+enum class ScatterParam
+{
+    DelayTime, GrainSize, Density, PitchRandom, Scale, RootNote, PanRandom, Feedback, Mix,
+    Count
+};
+
+inline constexpr const char* scatterScaleChoices[] { "Chromatic", "Major", "Minor", "Pentatonic", "Blues" };
+inline constexpr const char* scatterRootNoteChoices[] { "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B" };
+
+inline constexpr std::array scatterParameterTable
+{
+    // delay_time - Float (100.0 to 2000.0 ms, default: 500.0)
+    pfs::floatParameter("delay_time", "Delay Time", 100.0f, 2000.0f, 1.0f, 1.0f, 500.0f, "ms"),
+
+    // grain_size - Float (5.0 to 500.0 ms, default: 100.0)
+    pfs::floatParameter("grain_size", "Grain Size", 5.0f, 500.0f, 1.0f, 1.0f, 100.0f, "ms"),
+
+    // density - Float (0.0 to 100.0 %, default: 50.0): grain overlap, linear to 1 at 50%, then
+    // doubling every 5% up to the grain pool size (the largest pool at 100%)
+    pfs::floatParameter("density", "Density", 0.0f, 100.0f, 0.1f, 1.0f, 50.0f, "%"),
+
+    // pitch_random - Float (0.0 to 100.0 %, default: 30.0)
+    pfs::floatParameter("pitch_random", "Pitch Random", 0.0f, 100.0f, 0.1f, 1.0f, 30.0f, "%"),
+
+    // scale - Choice (Chromatic, Major, Minor, Pentatonic, Blues)
+    pfs::choiceParameter("scale", "Scale", scatterScaleChoices, 0),
+
+    // root_note - Choice (C, C#, D, D#, E, F, F#, G, G#, A, A#, B)
+    pfs::choiceParameter("root_note", "Root Note", scatterRootNoteChoices, 0),
+
+    // pan_random - Float (0.0 to 100.0 %, default: 75.0)
+    pfs::floatParameter("pan_random", "Pan Random", 0.0f, 100.0f, 0.1f, 1.0f, 75.0f, "%"),
+
+    // feedback - Float (0.0 to 100.0 %, default: 30.0)
+    pfs::floatParameter("feedback", "Feedback", 0.0f, 100.0f, 0.1f, 1.0f, 30.0f, "%"),
+
+    // mix - Float (0.0 to 100.0 %, default: 50.0)
+    pfs::floatParameter("mix", "Mix", 0.0f, 100.0f, 0.1f, 1.0f, 50.0f, "%"),
+};
+
+static_assert(scatterParameterTable.size() == static_cast<size_t>(ScatterParam::Count));
+static_assert(pfs::isValidParameterTable(scatterParameterTable));
+static_assert(pfs::hasUniqueStateHashes(scatterParameterTable));
+
+using ScatterParameterCache = pfs::ParameterCache<ScatterParam, scatterParameterTable.size()>;
+using ScatterParameterSnapshot = ScatterParameterCache::Snapshot;
+using ScatterStateCodec = pfs::StateCodec<scatterParameterTable.size()>;
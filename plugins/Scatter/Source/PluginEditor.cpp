@@ -130,21 +130,22 @@ ScatterAudioProcessorEditor::getResource(const juce::String& url)
 
 void ScatterAudioProcessorEditor::timerCallback()
 {
-    // Get active grain positions from processor (thread-safe read)
-    auto grainData = processorRef.getActiveGrainPositions();
+    // Latest grain snapshot published by the audio thread (lock-free triple buffer)
+    processorRef.grainSnapshots.update();
+    const auto& snapshot = processorRef.grainSnapshots.read();
 
     // Build JSON array for JavaScript
     juce::String jsonData = "[";
 
-    for (size_t i = 0; i < grainData.size(); ++i)
+    for (int i = 0; i < snapshot.numGrains; ++i)
     {
-        const auto& grain = grainData[i];
+        const auto& grain = snapshot.grains[static_cast<size_t>(i)];
 
         jsonData += "{\"x\":" + juce::String(grain.x, 4)
                  + ",\"y\":" + juce::String(grain.y, 4)
                  + ",\"pan\":" + juce::String(grain.pan, 4) + "}";
 
-        if (i < grainData.size() - 1)
+        if (i < snapshot.numGrains - 1)
             jsonData += ",";
     }
 
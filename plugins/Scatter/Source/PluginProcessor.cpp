@@ -1,91 +1,14 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+
+#if ! PLUGIN_DSP_ONLY
+ #include "PluginEditor.h"
+#endif
+#include <algorithm>
 #include <cmath>
 
 juce::AudioProcessorValueTreeState::ParameterLayout ScatterAudioProcessor::createParameterLayout()
 {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-
-    // delay_time - Float (100.0 to 2000.0 ms, default: 500.0)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "delay_time", 1 },
-        "Delay Time",
-        juce::NormalisableRange<float>(100.0f, 2000.0f, 1.0f, 1.0f),
-        500.0f,
-        "ms"
-    ));
-
-    // grain_size - Float (5.0 to 500.0 ms, default: 100.0)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "grain_size", 1 },
-        "Grain Size",
-        juce::NormalisableRange<float>(5.0f, 500.0f, 1.0f, 1.0f),
-        100.0f,
-        "ms"
-    ));
-
-    // density - Float (0.0 to 100.0 %, default: 50.0)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "density", 1 },
-        "Density",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        50.0f,
-        "%"
-    ));
-
-    // pitch_random - Float (0.0 to 100.0 %, default: 30.0)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "pitch_random", 1 },
-        "Pitch Random",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        30.0f,
-        "%"
-    ));
-
-    // scale - Choice (Chromatic, Major, Minor, Pentatonic, Blues)
-    layout.add(std::make_unique<juce::AudioParameterChoice>(
-        juce::ParameterID { "scale", 1 },
-        "Scale",
-        juce::StringArray { "Chromatic", "Major", "Minor", "Pentatonic", "Blues" },
-        0
-    ));
-
-    // root_note - Choice (C, C#, D, D#, E, F, F#, G, G#, A, A#, B)
-    layout.add(std::make_unique<juce::AudioParameterChoice>(
-        juce::ParameterID { "root_note", 1 },
-        "Root Note",
-        juce::StringArray { "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B" },
-        0
-    ));
-
-    // pan_random - Float (0.0 to 100.0 %, default: 75.0)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "pan_random", 1 },
-        "Pan Random",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        75.0f,
-        "%"
-    ));
-
-    // feedback - Float (0.0 to 100.0 %, default: 30.0)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "feedback", 1 },
-        "Feedback",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        30.0f,
-        "%"
-    ));
-
-    // mix - Float (0.0 to 100.0 %, default: 50.0)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "mix", 1 },
-        "Mix",
-        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f, 1.0f),
-        50.0f,
-        "%"
-    ));
-
-    return layout;
+    return pfs::createParameterLayout(scatterParameterTable);
 }
 
 ScatterAudioProcessor::ScatterAudioProcessor()
@@ -93,6 +16,8 @@ ScatterAudioProcessor::ScatterAudioProcessor()
                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, scatterParameterTable)
+    , stateCodec(parameters, scatterParameterTable)
 {
     // Phase 3.2: Initialize scale lookup tables
     initializeScaleTables();
@@ -112,12 +37,15 @@ void ScatterAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
     spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
 
-    // Prepare delay buffer (size for maximum delay time: 2000ms)
-    auto maxDelayTimeSamples = static_cast<int>(sampleRate * 2.0);  // 2 seconds max
-    currentDelayBufferSize = maxDelayTimeSamples;
-    delayBuffer.setMaximumDelayInSamples(maxDelayTimeSamples);
-    delayBuffer.prepare(spec);
-    delayBuffer.reset();
+    // Window tables for every grain length (no allocation, never rebuilt on the audio thread)
+    generateHannWindowTables();
+
+    // Prepare delay buffer: the longest delay, plus the furthest a grain can read back
+    // from there (a reversed grain at the highest rate) and one block written ahead of it
+    maxDelaySamples = static_cast<int>(sampleRate * maxDelaySeconds);
+    const auto maxGrainReachSamples = static_cast<int>(std::ceil(sampleRate * maxGrainSeconds * (maxPlaybackRate + 1.0)));
+    grainBuffer.prepare(maxDelaySamples + maxGrainReachSamples + samplesPerBlock + 8);
+    blockStartPosition = 0;
 
     // Phase 3.3: Prepare dry/wet mixer
     dryWetMixer.prepare(spec);
@@ -127,26 +55,24 @@ void ScatterAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
     feedbackBuffer.setSize(2, samplesPerBlock);
     feedbackBuffer.clear();
 
-    // Initialize grain scheduler
-    grainSpawnCounter = 0;
-    lastGrainSpawnInterval = 0;
+    // Initialize grain scheduler (first grain at the start of the first block)
+    samplesUntilNextGrain = 0.0;
 
-    // Clear all grain voices
-    for (auto& grain : grainVoices)
-    {
-        grain.active = false;
-        grain.readPosition = 0.0f;
-        grain.windowPosition = 0.0f;
-        grain.grainSizeSamples = 0;
-        grain.pan = 0.5f;
-        grain.reverse = false;
-    }
+    // Grain pool at the requested size; clear all grain voices
+    grainPoolSize = juce::jlimit(minGrainPoolSize, maxGrainPoolSize, requestedGrainPoolSize.load());
+    grainStealFadeSamples = juce::jmax(1, juce::roundToInt(sampleRate * grainStealFadeSeconds));
+    resetGrainPool();
 }
 
 void ScatterAudioProcessor::releaseResources()
 {
 }
 
+void ScatterAudioProcessor::setGrainPoolSize(int numGrains)
+{
+    requestedGrainPoolSize.store(juce::jlimit(minGrainPoolSize, maxGrainPoolSize, numGrains));
+}
+
 void ScatterAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -156,26 +82,18 @@ void ScatterAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     for (int i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
-    // Read parameters (atomic, real-time safe)
-    auto* delayTimeParam = parameters.getRawParameterValue("delay_time");
-    auto* grainSizeParam = parameters.getRawParameterValue("grain_size");
-    auto* densityParam = parameters.getRawParameterValue("density");
-    auto* pitchRandomParam = parameters.getRawParameterValue("pitch_random");
-    auto* scaleParam = parameters.getRawParameterValue("scale");
-    auto* rootNoteParam = parameters.getRawParameterValue("root_note");
-    auto* panRandomParam = parameters.getRawParameterValue("pan_random");
-    auto* feedbackParam = parameters.getRawParameterValue("feedback");
-    auto* mixParam = parameters.getRawParameterValue("mix");
-
-    float delayTimeMs = delayTimeParam->load();
-    float grainSizeMs = grainSizeParam->load();
-    float densityPercent = densityParam->load();
-    float pitchRandomPercent = pitchRandomParam->load();
-    int scaleIndex = static_cast<int>(scaleParam->load());
-    int rootNote = static_cast<int>(rootNoteParam->load());
-    float panRandomPercent = panRandomParam->load();
-    float feedbackGain = feedbackParam->load() / 100.0f * 0.95f;  // Map 0-100% to 0.0-0.95
-    float mixValue = mixParam->load() / 100.0f;  // Map 0-100% to 0.0-1.0
+    // Read parameters once per block (cached atomics, no ID lookups)
+    const auto params = parameterCache.snapshot();
+
+    float delayTimeMs = params[ScatterParam::DelayTime];
+    float grainSizeMs = params[ScatterParam::GrainSize];
+    float densityPercent = params[ScatterParam::Density];
+    float pitchRandomPercent = params[ScatterParam::PitchRandom];
+    int scaleIndex = static_cast<int>(params[ScatterParam::Scale]);
+    int rootNote = static_cast<int>(params[ScatterParam::RootNote]);
+    float panRandomPercent = params[ScatterParam::PanRandom];
+    float feedbackGain = params[ScatterParam::Feedback] / 100.0f * 0.95f;  // Map 0-100% to 0.0-0.95
+    float mixValue = params[ScatterParam::Mix] / 100.0f;  // Map 0-100% to 0.0-1.0
 
     const int numSamples = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
@@ -196,19 +114,12 @@ void ScatterAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
         }
     }
 
-    // Phase 3.3: Step 3 - Write input + feedback to delay buffer (stereo)
-    for (int channel = 0; channel < juce::jmin(2, numChannels); ++channel)
-    {
-        auto* channelData = buffer.getReadPointer(channel);
-
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            delayBuffer.pushSample(channel, channelData[sample]);
-        }
-    }
+    // Phase 3.3: Step 3 - Write input + feedback to delay buffer (stereo; a mono input fills both sides)
+    blockStartPosition = grainBuffer.getWritePosition();
+    grainBuffer.write(buffer.getReadPointer(0), buffer.getReadPointer(juce::jmin(1, numChannels - 1)), numSamples);
 
-    // Phase 3.3: Step 4 - Update grain scheduler and spawn grains
-    updateGrainScheduler(densityPercent, grainSizeMs, pitchRandomPercent, panRandomPercent, scaleIndex, rootNote);
+    // Phase 3.3: Step 4 - Update grain scheduler and spawn this block's grains at their sample offsets
+    updateGrainScheduler(numSamples, densityPercent, delayTimeMs, grainSizeMs, pitchRandomPercent, panRandomPercent, scaleIndex, rootNote);
 
     // Phase 3.3: Step 5 - Process active grain voices (stereo output)
     processGrainVoices(buffer);
@@ -229,26 +140,41 @@ void ScatterAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     // Phase 3.3: Step 7 - Blend with dry signal using dry/wet mixer
     dryWetMixer.setWetMixProportion(mixValue);
     dryWetMixer.mixWetSamples(block);
+
+    // Phase 4.2: Publish grain positions for the visualization
+    publishGrainSnapshot();
+}
+
+#if PLUGIN_DSP_ONLY
+bool ScatterAudioProcessor::hasEditor() const
+{
+    return false;
+}
+
+juce::AudioProcessorEditor* ScatterAudioProcessor::createEditor()
+{
+    return nullptr;
+}
+#else
+bool ScatterAudioProcessor::hasEditor() const
+{
+    return true;
 }
 
 juce::AudioProcessorEditor* ScatterAudioProcessor::createEditor()
 {
     return new ScatterAudioProcessorEditor(*this);
 }
+#endif
 
 void ScatterAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    stateCodec.save(destData);
 }
 
 void ScatterAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState != nullptr && xmlState->hasTagName(parameters.state.getType()))
-        parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    stateCodec.load(data, sizeInBytes);
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -257,58 +183,81 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 }
 
 // ============================================================================
-// Phase 4.2: Grain Visualization Data Accessor
+// Phase 4.2: Grain Visualization Snapshot (audio thread → editor)
 // ============================================================================
 
-std::vector<ScatterAudioProcessor::GrainVisualizationData> ScatterAudioProcessor::getActiveGrainPositions() const
+void ScatterAudioProcessor::publishGrainSnapshot()
 {
-    std::vector<GrainVisualizationData> data;
+    // Audio thread: fill the triple buffer's back snapshot, then hand it to the editor
+    auto& snapshot = grainSnapshots.getWriteBuffer();
+    snapshot.numGrains = 0;
 
-    // Copy active grain positions (thread-safe read - audio thread writes, message thread reads)
-    for (const auto& grain : grainVoices)
+    const auto writePosition = grainBuffer.getWritePosition();
+
+    for (int i = 0; i < juce::jmin(numActiveLanes, maxVisualizedGrains); ++i)
     {
-        if (grain.active)
-        {
-            GrainVisualizationData vizData;
+        const int lane = activeLanes[static_cast<size_t>(i)];
+        const float rate = grainLanes.rate[lane];
 
-            // X-axis: Normalized time position in delay buffer (0.0-1.0)
-            vizData.x = grain.readPosition / static_cast<float>(currentDelayBufferSize);
+        auto& vizData = snapshot.grains[static_cast<size_t>(snapshot.numGrains++)];
 
-            // Y-axis: Pitch shift normalized to -1.0 to +1.0 range
-            // playbackRate = 2^(semitones / 12)
-            // Reverse calculation: semitones = 12 * log2(playbackRate)
-            float semitones = 12.0f * std::log2(grain.playbackRate);
-            vizData.y = semitones / 7.0f;  // Normalize to -1.0 to +1.0 (-7 to +7 semitones)
+        // X-axis: Normalized time position in delay buffer (0.0-1.0): how far behind the
+        // write head the grain is reading, over the longest delay
+        const auto readPosition = static_cast<double>(grainLanes.startPosition[lane])
+                                + static_cast<double>(rate) * static_cast<double>(grainLanes.samplesPlayed[lane]);
+        vizData.x = static_cast<float>(juce::jlimit(0.0, 1.0, (static_cast<double>(writePosition) - readPosition) / maxDelaySamples));
 
-            // Pan position (already 0.0-1.0)
-            vizData.pan = grain.pan;
+        // Y-axis: Pitch shift normalized to -1.0 to +1.0 range
+        // playbackRate = 2^(semitones / 12)
+        // Reverse calculation: semitones = 12 * log2(playbackRate)
+        float semitones = 12.0f * std::log2(std::abs(rate));
+        vizData.y = semitones / 7.0f;  // Normalize to -1.0 to +1.0 (-7 to +7 semitones)
 
-            data.push_back(vizData);
-        }
+        // Pan position (0.0-1.0): the right gain's share of the grain's gain
+        vizData.pan = grainLanes.gainRight[lane] / (grainLanes.gainLeft[lane] + grainLanes.gainRight[lane]);
     }
 
-    return data;
+    grainSnapshots.publish();
 }
 
 // ============================================================================
 // Phase 3.1: Core Granular Engine Helper Methods
 // ============================================================================
 
-void ScatterAudioProcessor::generateHannWindow(int sizeInSamples)
+void ScatterAudioProcessor::generateHannWindowTables()
 {
-    hannWindow.resize(sizeInSamples);
-    windowTableSize = sizeInSamples;
-
-    // Generate Hann window: hann[n] = 0.5 * (1 - cos(2 * pi * n / N))
-    juce::dsp::WindowingFunction<float>::fillWindowingTables(
-        hannWindow.data(),
-        sizeInSamples,
-        juce::dsp::WindowingFunction<float>::hann,
-        false  // Not normalized (we want 0-1 range)
-    );
+    for (int order = minWindowTableOrder; order <= maxWindowTableOrder; ++order)
+    {
+        // hann[n] = 0.5 * (1 - cos(2 * pi * n / N)), n = 0..N: zero at both ends, the last point
+        // being the guard the interpolation reads at the end of the grain
+        const int tableSize = 1 << order;
+        auto* table = hannWindowTables.data() + getHannWindowTableOffset(order);
+
+        for (int n = 0; n <= tableSize; ++n)
+            table[n] = static_cast<float>(0.5 * (1.0 - std::cos(juce::MathConstants<double>::twoPi * n / tableSize)));
+    }
+
+    // Integral of hann^2 from x to 1, over its total (3/8):
+    // hann^2 = 3/8 - cos(2 pi x) / 2 + cos(4 pi x) / 8
+    for (int n = 0; n <= remainingEnergyTableSize; ++n)
+    {
+        const double x = static_cast<double>(n) / remainingEnergyTableSize;
+        const double remaining = 0.375 * (1.0 - x)
+                               + std::sin(juce::MathConstants<double>::twoPi * x) / (4.0 * juce::MathConstants<double>::pi)
+                               - std::sin(2.0 * juce::MathConstants<double>::twoPi * x) / (32.0 * juce::MathConstants<double>::pi);
+        hannRemainingEnergy[static_cast<size_t>(n)] = static_cast<float>(juce::jmax(0.0, remaining / 0.375));
+    }
 }
 
-void ScatterAudioProcessor::spawnNewGrain(float grainSizeMs, float pitchRandomPercent, float panRandomPercent, int scaleIndex, int rootNote)
+int ScatterAudioProcessor::getHannWindowTableOffset(int order)
+{
+    jassert(order >= minWindowTableOrder && order <= maxWindowTableOrder);
+
+    // Tables of 2^k + 1 points for k = minWindowTableOrder..order-1 come first
+    return (1 << order) - (1 << minWindowTableOrder) + (order - minWindowTableOrder);
+}
+
+void ScatterAudioProcessor::spawnNewGrain(int startOffset, float gain, float delayTimeMs, float grainSizeMs, float pitchRandomPercent, float panRandomPercent, int scaleIndex, int rootNote)
 {
     // Convert grain size from ms to samples
     int grainSizeSamples = static_cast<int>(currentSampleRate * grainSizeMs / 1000.0f);
@@ -316,26 +265,24 @@ void ScatterAudioProcessor::spawnNewGrain(float grainSizeMs, float pitchRandomPe
     // Clamp to valid range (avoid zero or negative sizes)
     grainSizeSamples = juce::jmax(1, grainSizeSamples);
 
-    // Find inactive voice (voice allocation)
-    GrainVoice* availableVoice = nullptr;
+    // Voice allocation. With the pool full, the grain with the least window energy left
+    // (nearly over, or short) fades out over grainStealFadeSeconds in a spare lane; if
+    // every spare lane is still fading, it is cut and its lane reused
+    int lane = -1;
 
-    for (auto& grain : grainVoices)
+    if (numActiveGrains >= grainPoolSize)
     {
-        if (!grain.active)
-        {
-            availableVoice = &grain;
-            break;
-        }
-    }
+        const int stolenLane = findGrainToSteal();
+        --numActiveGrains;
 
-    // If no voices available, steal the first voice (simple voice stealing)
-    if (availableVoice == nullptr)
-    {
-        availableVoice = &grainVoices[0];
+        if (firstFreeLane < 0)
+            lane = stolenLane;
+        else
+            grainLanes.releaseSamplesLeft[stolenLane] = grainStealFadeSamples;
     }
 
-    // Get random number generator
-    auto& random = juce::Random::getSystemRandom();
+    if (lane < 0)
+        lane = allocateGrainLane();
 
     // Phase 3.2: Generate random pitch and quantize to scale
     float randomPitch = (random.nextFloat() * 2.0f - 1.0f) * 7.0f * (pitchRandomPercent / 100.0f);
@@ -351,50 +298,65 @@ void ScatterAudioProcessor::spawnNewGrain(float grainSizeMs, float pitchRandomPe
     // Phase 3.3: Random reverse playback (50/50 probability)
     bool reverse = random.nextBool();
 
-    // Initialize grain voice
-    availableVoice->active = true;
-    availableVoice->grainSizeSamples = grainSizeSamples;
-    availableVoice->windowPosition = 0.0f;
-    availableVoice->playbackRate = playbackRate;
-    availableVoice->pan = pan;
-    availableVoice->reverse = reverse;
-
-    // Read position: Start at current delay buffer write position
-    availableVoice->readPosition = 0.0f;
-
-    // Generate Hann window for this grain size (if not already cached)
-    if (windowTableSize != grainSizeSamples)
-    {
-        generateHannWindow(grainSizeSamples);
-    }
+    // Initialize grain voice (reverse = negative rate)
+    grainLanes.active[lane] = true;
+    grainLanes.releaseSamplesLeft[lane] = 0;
+    grainLanes.startOffset[lane] = startOffset;
+    grainLanes.grainSizeSamples[lane] = grainSizeSamples;
+    grainLanes.samplesPlayed[lane] = 0;
+    grainLanes.rate[lane] = reverse ? -playbackRate : playbackRate;
+    grainLanes.gainLeft[lane] = (1.0f - pan) * gain;   // pan=0.0 → leftGain=gain, pan=1.0 → leftGain=0.0
+    grainLanes.gainRight[lane] = pan * gain;           // pan=0.0 → rightGain=0.0, pan=1.0 → rightGain=gain
+
+    // Read position: delay_time behind the write head at the grain's first sample. A
+    // forward grain faster than 1x gains on the write head, so it starts far enough back
+    // never to overtake it (the interpolator reads 2 samples ahead)
+    const double delaySamples = currentSampleRate * delayTimeMs / 1000.0;
+    const double minimumDelaySamples = reverse ? 3.0 : juce::jmax(0.0, (playbackRate - 1.0) * grainSizeSamples) + 3.0;
+    grainLanes.startPosition[lane] = blockStartPosition + startOffset
+                                  - static_cast<juce::int64>(std::ceil(juce::jmax(delaySamples, minimumDelaySamples)));
+    ++numActiveGrains;
+
+    // Window: the smallest table at least as long as the grain (the largest for longer
+    // grains), read at this grain's own rate - grains of different sizes never share a window
+    const int windowOrder = juce::jlimit(minWindowTableOrder, maxWindowTableOrder,
+                                         juce::findHighestSetBit(static_cast<juce::uint32>(juce::nextPowerOfTwo(grainSizeSamples))));
+    grainLanes.window[lane] = hannWindowTables.data() + getHannWindowTableOffset(windowOrder);
+    grainLanes.windowIncrement[lane] = static_cast<float>(1 << windowOrder) / static_cast<float>(grainSizeSamples);
 }
 
-void ScatterAudioProcessor::updateGrainScheduler(float densityPercent, float grainSizeMs, float pitchRandomPercent, float panRandomPercent, int scaleIndex, int rootNote)
+void ScatterAudioProcessor::updateGrainScheduler(int numSamples, float densityPercent, float delayTimeMs, float grainSizeMs, float pitchRandomPercent, float panRandomPercent, int scaleIndex, int rootNote)
 {
-    // Grain spawn interval calculation: grainSizeSamples / (density * overlapFactor)
-    // At 50% density, grains spawn at ~grainSize intervals (moderate overlap)
-    // At 100% density, grains spawn more frequently (dense cloud)
-
-    const float overlapFactor = 2.0f;  // Tuning constant for overlap behavior
-    int grainSizeSamples = static_cast<int>(currentSampleRate * grainSizeMs / 1000.0f);
-    grainSizeSamples = juce::jmax(1, grainSizeSamples);
-
-    // Calculate spawn interval (avoid division by zero)
-    float densityNormalized = juce::jmax(0.01f, densityPercent / 100.0f);
-    int spawnInterval = static_cast<int>(grainSizeSamples / (densityNormalized * overlapFactor));
-    spawnInterval = juce::jmax(1, spawnInterval);  // At least 1 sample
-
-    lastGrainSpawnInterval = spawnInterval;
-
-    // Increment sample counter
-    grainSpawnCounter++;
-
-    // Check if it's time to spawn a new grain
-    if (grainSpawnCounter >= spawnInterval)
+    // Density sets the overlap: how many grains sound at once on average. Up to 50% it
+    // rises linearly to 1 (grains back to back); above that it doubles every 5%, through
+    // 2 at 55% (Hann windows summing to a constant) to maxGrainPoolSize at 100%. It stops
+    // at the pool size: the pool then runs full and stealing absorbs the spawn jitter
+    // (spawning past it would only steal grains before their windows open)
+    const double grainSizeSamples = juce::jmax(1.0, currentSampleRate * grainSizeMs / 1000.0);
+    const double densityNormalized = juce::jmax(0.01, densityPercent / 100.0);
+    const double overlap = densityNormalized <= 0.5
+                               ? densityNormalized * 2.0
+                               : juce::jmin(static_cast<double>(grainPoolSize),
+                                            std::pow(static_cast<double>(maxGrainPoolSize), densityNormalized * 2.0 - 1.0));
+
+    // Spawn interval in samples (fractional, at least one)
+    const double spawnInterval = juce::jmax(1.0, grainSizeSamples / overlap);
+
+    // Overlapping windows sum to overlap / 2 on average: denser clouds are scaled back to
+    // the level of two, so the grains that read the delay in step stay at unity
+    const float grainGain = static_cast<float>(2.0 / juce::jmax(2.0, overlap));
+
+    // Spawn every grain due in this block at its own sample; the remainder of
+    // the interval carries over into the next block
+    while (samplesUntilNextGrain < numSamples)
     {
-        spawnNewGrain(grainSizeMs, pitchRandomPercent, panRandomPercent, scaleIndex, rootNote);
-        grainSpawnCounter = 0;  // Reset counter
+        spawnNewGrain(static_cast<int>(samplesUntilNextGrain), grainGain, delayTimeMs, grainSizeMs, pitchRandomPercent, panRandomPercent, scaleIndex, rootNote);
+
+        const auto jitter = 1.0 + grainSpawnJitter * (random.nextDouble() * 2.0 - 1.0);
+        samplesUntilNextGrain += spawnInterval * jitter;
     }
+
+    samplesUntilNextGrain -= numSamples;
 }
 
 void ScatterAudioProcessor::processGrainVoices(juce::AudioBuffer<float>& buffer)
@@ -405,89 +367,287 @@ void ScatterAudioProcessor::processGrainVoices(juce::AudioBuffer<float>& buffer)
     // Clear output buffer (grains will be summed into it)
     buffer.clear();
 
-    // Process each active grain voice
-    for (auto& grain : grainVoices)
+    for (int chunkStart = 0; chunkStart < numSamples; chunkStart += grainChunkSize)
     {
-        if (!grain.active)
-            continue;
+        const int numChunkSamples = juce::jmin(grainChunkSize, numSamples - chunkStart);
 
-        // For each sample in the buffer
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            // Check if grain has completed
-            if (grain.windowPosition >= 1.0f)
-            {
-                grain.active = false;
-                break;
-            }
+        // Live grains, grainLaneGroupSize at a time, add their lanes into the chunk's per-lane sums
+        juce::FloatVectorOperations::clear(grainChunk.mixLeft, numChunkSamples * grainLaneGroupSize);
+        juce::FloatVectorOperations::clear(grainChunk.mixRight, numChunkSamples * grainLaneGroupSize);
 
-            // Calculate window index (map 0.0-1.0 to 0..grainSizeSamples-1)
-            int windowIndex = static_cast<int>(grain.windowPosition * grain.grainSizeSamples);
-            windowIndex = juce::jlimit(0, grain.grainSizeSamples - 1, windowIndex);
+        bool anyGrainFinished = false;
 
-            // Get window envelope value (or 1.0 if table not generated yet)
-            float windowValue = 1.0f;
-            if (windowIndex < static_cast<int>(hannWindow.size()))
-            {
-                windowValue = hannWindow[windowIndex];
-            }
+        for (int firstActiveLane = 0; firstActiveLane < numActiveLanes; firstActiveLane += grainLaneGroupSize)
+        {
+            anyGrainFinished |= fillGrainChunk(firstActiveLane, chunkStart, numChunkSamples);
+            renderGrainChunk<pfs::simd::NativeLanes>(numChunkSamples);
+        }
 
-            // Phase 3.3: Read from delay buffer (stereo, with channel selection)
-            // Use channel 0 for mono-like grain source (could randomize per grain in future)
-            float delaySamples = grain.readPosition;
-            float delayedSample = delayBuffer.popSample(0, delaySamples);
+        if (anyGrainFinished)
+            removeFinishedGrains();
 
-            // Apply window envelope
-            float grainOutput = delayedSample * windowValue;
+        // Sum to output buffer (stereo)
+        for (int i = 0; i < numChunkSamples; ++i)
+        {
+            float left = 0.0f, right = 0.0f;
 
-            // Phase 3.3: Apply stereo panning
-            float leftGain = 1.0f - grain.pan;   // pan=0.0 → leftGain=1.0, pan=1.0 → leftGain=0.0
-            float rightGain = grain.pan;          // pan=0.0 → rightGain=0.0, pan=1.0 → rightGain=1.0
+            for (int lane = 0; lane < grainLaneGroupSize; ++lane)
+            {
+                left += grainChunk.mixLeft[i * grainLaneGroupSize + lane];
+                right += grainChunk.mixRight[i * grainLaneGroupSize + lane];
+            }
 
-            // Sum to output buffer (stereo)
             if (numChannels >= 2)
             {
-                auto* leftData = buffer.getWritePointer(0);
-                auto* rightData = buffer.getWritePointer(1);
-
-                leftData[sample] += grainOutput * leftGain;
-                rightData[sample] += grainOutput * rightGain;
+                buffer.getWritePointer(0)[chunkStart + i] = left;
+                buffer.getWritePointer(1)[chunkStart + i] = right;
             }
             else if (numChannels == 1)
             {
                 // Mono output: mix both channels
-                auto* outputData = buffer.getWritePointer(0);
-                outputData[sample] += grainOutput;
+                buffer.getWritePointer(0)[chunkStart + i] = left + right;
             }
+        }
+    }
 
-            // Advance grain window position (always at rate 1.0 - envelope progresses normally)
-            grain.windowPosition += 1.0f / grain.grainSizeSamples;
+    // Spawned grains play from the start of every following block
+    for (int i = 0; i < numActiveLanes; ++i)
+        grainLanes.startOffset[activeLanes[static_cast<size_t>(i)]] = 0;
+}
 
-            // Phase 3.3: Advance read position by playback rate (forward or reverse)
-            if (grain.reverse)
-            {
-                grain.readPosition -= grain.playbackRate;
+// Scalar pass over one group of live grains (activeLanes from firstActiveLane): for every
+// sample of the chunk a grain plays, its window value (faded if stolen), read fraction and
+// buffer points, and the group's pan gains; zeros elsewhere and in slots past the last
+// grain. Advances the grains; true when any of them finished (see removeFinishedGrains)
+bool ScatterAudioProcessor::fillGrainChunk(int firstActiveLane, int chunkStart, int numSamples) noexcept
+{
+    bool anyGrainFinished = false;
 
-                // Wrap around if negative
-                if (grain.readPosition < 0.0f)
-                {
-                    grain.readPosition += currentDelayBufferSize;
-                }
-            }
-            else
+    for (int groupLane = 0; groupLane < grainLaneGroupSize; ++groupLane)
+    {
+        const int activeIndex = firstActiveLane + groupLane;
+        const int lane = activeIndex < numActiveLanes ? activeLanes[static_cast<size_t>(activeIndex)] : -1;
+
+        // Samples [firstSample, endSample) of the chunk the grain plays
+        int firstSample = numSamples, endSample = numSamples;
+
+        if (lane < 0)
+        {
+            grainChunk.gainLeft[groupLane] = 0.0f;
+            grainChunk.gainRight[groupLane] = 0.0f;
+        }
+        else
+        {
+            grainChunk.gainLeft[groupLane] = grainLanes.gainLeft[lane];
+            grainChunk.gainRight[groupLane] = grainLanes.gainRight[lane];
+
+            firstSample = juce::jlimit(0, numSamples, grainLanes.startOffset[lane] - chunkStart);
+            endSample = firstSample + juce::jmin(numSamples - firstSample,
+                                                 grainLanes.grainSizeSamples[lane] - grainLanes.samplesPlayed[lane]);
+
+            if (grainLanes.releaseSamplesLeft[lane] > 0)
+                endSample = juce::jmin(endSample, firstSample + grainLanes.releaseSamplesLeft[lane]);
+        }
+
+        const float* window = lane < 0 ? nullptr : grainLanes.window[lane];
+        const float windowIncrement = lane < 0 ? 0.0f : grainLanes.windowIncrement[lane];
+        const double rate = lane < 0 ? 0.0 : grainLanes.rate[lane];
+        const juce::int64 startPosition = lane < 0 ? 0 : grainLanes.startPosition[lane];
+        int samplesPlayed = lane < 0 ? 0 : grainLanes.samplesPlayed[lane];
+        int releaseSamplesLeft = lane < 0 ? 0 : grainLanes.releaseSamplesLeft[lane];
+        const bool isReleasing = releaseSamplesLeft > 0;
+        const float releaseStep = 1.0f / static_cast<float>(grainStealFadeSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const int index = i * grainLaneGroupSize + groupLane;
+
+            if (i < firstSample || i >= endSample)
             {
-                grain.readPosition += grain.playbackRate;
+                grainChunk.window[index] = 0.0f;
+                grainChunk.fraction[index] = 0.0f;
 
-                // Wrap around if exceeds buffer size
-                if (grain.readPosition >= currentDelayBufferSize)
+                for (int point = 0; point < 4; ++point)
                 {
-                    grain.readPosition -= currentDelayBufferSize;
+                    grainChunk.pointsLeft[point * grainChunkLanes + index] = 0.0f;
+                    grainChunk.pointsRight[point * grainChunkLanes + index] = 0.0f;
                 }
+
+                continue;
             }
+
+            // Window envelope, linearly interpolated from the grain's table. The phase stays
+            // below the table size, so index + 1 is at most the guard point
+            const float windowPhase = static_cast<float>(samplesPlayed) * windowIncrement;
+            const int windowIndex = static_cast<int>(windowPhase);
+            const float windowFraction = windowPhase - static_cast<float>(windowIndex);
+            float windowValue = window[windowIndex] + windowFraction * (window[windowIndex + 1] - window[windowIndex]);
+
+            // Stolen grains: linear fade to silence over grainStealFadeSeconds
+            if (isReleasing)
+                windowValue *= static_cast<float>(releaseSamplesLeft--) * releaseStep;
+
+            grainChunk.window[index] = windowValue;
+
+            // Phase 3.3: Read position, forward or reverse by the sign of the rate. Split in
+            // double: a float offset thousands of samples in keeps only a few fraction bits
+            const double readOffset = rate * static_cast<double>(samplesPlayed);
+            const double readWhole = std::floor(readOffset);
+            grainChunk.fraction[index] = static_cast<float>(readOffset - readWhole);
+            grainBuffer.readPoints(startPosition + static_cast<juce::int64>(readWhole),
+                                   grainChunk.pointsLeft + index, grainChunk.pointsRight + index, grainChunkLanes);
+
+            // Advance grain window position (always at rate 1.0 - envelope progresses normally)
+            ++samplesPlayed;
+        }
+
+        if (lane < 0)
+            continue;
+
+        grainLanes.samplesPlayed[lane] = samplesPlayed;
+        grainLanes.releaseSamplesLeft[lane] = releaseSamplesLeft;
+
+        // Check if grain has completed (stolen grains left the sounding count when stolen)
+        if (samplesPlayed >= grainLanes.grainSizeSamples[lane] || (isReleasing && releaseSamplesLeft == 0))
+        {
+            grainLanes.active[lane] = false;
+            anyGrainFinished = true;
+
+            if (!isReleasing)
+                --numActiveGrains;
+        }
+    }
+
+    return anyGrainFinished;
+}
+
+// Vector pass over the group fillGrainChunk prepared: interpolates both channels, applies
+// window and pan gains, and adds each lane into the chunk's per-lane sums
+template <typename Lanes>
+void ScatterAudioProcessor::renderGrainChunk(int numSamples) noexcept
+{
+    using namespace pfs::simd;
+    constexpr int width = std::is_same_v<Lanes, float> ? 1 : laneWidth;
+
+    for (int groupLane = 0; groupLane < grainLaneGroupSize; groupLane += width)
+    {
+        const auto gainLeft = load<Lanes>(grainChunk.gainLeft + groupLane);
+        const auto gainRight = load<Lanes>(grainChunk.gainRight + groupLane);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const int index = i * grainLaneGroupSize + groupLane;
+            const auto fraction = load<Lanes>(grainChunk.fraction + index);
+            const auto window = load<Lanes>(grainChunk.window + index);
+            const auto* left = grainChunk.pointsLeft + index;
+            const auto* right = grainChunk.pointsRight + index;
+
+            const auto sourceLeft = GrainBuffer::interpolate(fraction, load<Lanes>(left), load<Lanes>(left + grainChunkLanes),
+                                                             load<Lanes>(left + 2 * grainChunkLanes), load<Lanes>(left + 3 * grainChunkLanes));
+            const auto sourceRight = GrainBuffer::interpolate(fraction, load<Lanes>(right), load<Lanes>(right + grainChunkLanes),
+                                                              load<Lanes>(right + 2 * grainChunkLanes), load<Lanes>(right + 3 * grainChunkLanes));
+
+            store(grainChunk.mixLeft + index, load<Lanes>(grainChunk.mixLeft + index) + sourceLeft * window * gainLeft);
+            store(grainChunk.mixRight + index, load<Lanes>(grainChunk.mixRight + index) + sourceRight * window * gainRight);
+        }
+    }
+}
+
+// ============================================================================
+// Grain pool: free list, live list, stealing
+// ============================================================================
+
+// Every lane free (lane 0 first), none live
+void ScatterAudioProcessor::resetGrainPool() noexcept
+{
+    numActiveLanes = 0;
+    numActiveGrains = 0;
+    firstFreeLane = -1;
+
+    // The pool's grains plus a quarter again of spare lanes for stolen grains fading out
+    const int numLanes = grainPoolSize + grainPoolSize / 4;
+
+    for (int lane = maxGrainLanes - 1; lane >= 0; --lane)
+    {
+        grainLanes.active[lane] = false;
+        grainLanes.releaseSamplesLeft[lane] = 0;
+        grainLanes.startOffset[lane] = 0;
+
+        if (lane < numLanes)
+        {
+            grainLanes.nextFreeLane[lane] = firstFreeLane;
+            firstFreeLane = lane;
         }
     }
 }
 
+// Pops a free lane and lists it as live. spawnNewGrain only allocates below the pool size,
+// or with a spare lane left, so the free list is never empty here
+int ScatterAudioProcessor::allocateGrainLane() noexcept
+{
+    jassert(firstFreeLane >= 0);
+
+    const int lane = firstFreeLane;
+    firstFreeLane = grainLanes.nextFreeLane[lane];
+    activeLanes[static_cast<size_t>(numActiveLanes++)] = lane;
+    return lane;
+}
+
+// The sounding (not already stolen) grain with the least window energy still to play:
+// its length times the share of the Hann window's energy left past its position
+int ScatterAudioProcessor::findGrainToSteal() const noexcept
+{
+    int quietestLane = -1;
+    float quietestEnergy = 0.0f;
+
+    for (int i = 0; i < numActiveLanes; ++i)
+    {
+        const int lane = activeLanes[static_cast<size_t>(i)];
+
+        if (grainLanes.releaseSamplesLeft[lane] > 0)
+            continue;
+
+        const float size = static_cast<float>(grainLanes.grainSizeSamples[lane]);
+        const float position = static_cast<float>(grainLanes.samplesPlayed[lane]) / size * remainingEnergyTableSize;
+        const int index = juce::jmin(static_cast<int>(position), remainingEnergyTableSize - 1);
+        const float fraction = position - static_cast<float>(index);
+        const float energy = size * (hannRemainingEnergy[static_cast<size_t>(index)]
+                                     + fraction * (hannRemainingEnergy[static_cast<size_t>(index + 1)] - hannRemainingEnergy[static_cast<size_t>(index)]));
+
+        if (quietestLane < 0 || energy < quietestEnergy)
+        {
+            quietestLane = lane;
+            quietestEnergy = energy;
+        }
+    }
+
+    jassert(quietestLane >= 0);
+    return quietestLane;
+}
+
+// Returns finished grains' lanes to the free list, keeping the live list in order
+void ScatterAudioProcessor::removeFinishedGrains() noexcept
+{
+    int numKept = 0;
+
+    for (int i = 0; i < numActiveLanes; ++i)
+    {
+        const int lane = activeLanes[static_cast<size_t>(i)];
+
+        if (grainLanes.active[lane])
+        {
+            activeLanes[static_cast<size_t>(numKept++)] = lane;
+        }
+        else
+        {
+            grainLanes.nextFreeLane[lane] = firstFreeLane;
+            firstFreeLane = lane;
+        }
+    }
+
+    numActiveLanes = numKept;
+}
+
 // ============================================================================
 // Phase 3.2: Pitch Shifting + Scale Quantization Helper Methods
 // ============================================================================
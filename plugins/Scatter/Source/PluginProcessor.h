@@ -1,7 +1,12 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "GrainBuffer.h"
+#include "Parameters.h"
+#include "SimdLanes.h"
+#include "Telemetry.h"
 #include <array>
+#include <atomic>
 #include <vector>
 
 class ScatterAudioProcessor : public juce::AudioProcessor
@@ -15,7 +20,7 @@ public:
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override { return true; }
+    bool hasEditor() const override;
 
     const juce::String getName() const override { return "Scatter"; }
     bool acceptsMidi() const override { return false; }
@@ -42,47 +47,124 @@ public:
         float pan;    // Pan position (0.0-1.0)
     };
 
-    // Phase 4.2: Public accessor for grain positions (thread-safe read)
-    std::vector<GrainVisualizationData> getActiveGrainPositions() const;
+    // Phase 4.2: Active grains, published by the audio thread once per block.
+    // Triple-buffered: the editor reads the latest complete snapshot without locking.
+    static constexpr int maxVisualizedGrains = 64;
+
+    struct GrainSnapshot
+    {
+        int numGrains = 0;
+        std::array<GrainVisualizationData, maxVisualizedGrains> grains;
+    };
+
+    pfs::TripleBuffer<GrainSnapshot> grainSnapshots;
+
+    // Grain pool size: the most grains sounding at once. Density reaches it at 80% (64
+    // grains) to 100% (1024) and then holds it, each spawn stealing the quietest grain.
+    // Message thread; takes effect at the next prepareToPlay
+    static constexpr int minGrainPoolSize = 64;
+    static constexpr int maxGrainPoolSize = 1024;
+    static constexpr int defaultGrainPoolSize = 256;
+
+    void setGrainPoolSize(int numGrains);
+    int getGrainPoolSize() const noexcept { return requestedGrainPoolSize.load(); }
 
 private:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
     // Phase 3.1: Core Granular Engine Components
 
-    // Grain voice structure
-    struct GrainVoice
+    // Grain voice pool: grainPoolSize grains may sound at once, plus a quarter again of
+    // spare lanes for stolen grains fading out. Free lanes form an intrusive list through
+    // nextFreeLane (O(1) allocation); live lanes (sounding or fading) are listed in
+    // activeLanes, which the renderer walks grainLaneGroupSize grains at a time
+    static constexpr int maxGrainLanes = maxGrainPoolSize + maxGrainPoolSize / 4;
+    static constexpr int grainLaneGroupSize = 8;
+    static constexpr double grainStealFadeSeconds = 0.005;
+    static_assert(grainLaneGroupSize % pfs::simd::laneWidth == 0, "A lane group is whole vectors");
+
+    // Grain state, structure-of-arrays (one entry per lane). Read position and window
+    // phase are both computed from samplesPlayed, so nothing accumulates
+    struct GrainLanes
     {
-        float readPosition = 0.0f;      // Position in delay buffer (fractional samples)
-        float windowPosition = 0.0f;    // Position in window envelope (0.0-1.0)
-        int grainSizeSamples = 0;       // Duration of this grain in samples
-        float playbackRate = 1.0f;      // Playback speed (pitch shift)
-        float pan = 0.5f;               // Phase 3.3: Pan position (0.0 = left, 1.0 = right)
-        bool reverse = false;           // Phase 3.3: Reverse playback flag
-        bool active = false;            // Is this voice currently playing?
+        juce::int64 startPosition[maxGrainLanes] {};   // Grain buffer position the read starts at (absolute samples)
+        float rate[maxGrainLanes] {};                  // Buffer samples per grain sample: playback speed (pitch shift), negative = reverse
+        int samplesPlayed[maxGrainLanes] {};           // Position in the grain (samples since it started)
+        int grainSizeSamples[maxGrainLanes] {};        // Duration of this grain in samples
+        const float* window[maxGrainLanes] {};         // Hann table for this grain's length (see hannWindowTables)
+        float windowIncrement[maxGrainLanes] {};       // Window table points per grain sample (table size / grain size)
+        float gainLeft[maxGrainLanes] {};              // Phase 3.3: Pan gains (1 - pan, pan)
+        float gainRight[maxGrainLanes] {};
+        int startOffset[maxGrainLanes] {};             // First sample it plays in the current block (spawned mid-block)
+        int releaseSamplesLeft[maxGrainLanes] {};      // Stolen: fade-out samples left (0 = not stolen)
+        int nextFreeLane[maxGrainLanes] {};            // Free list link (-1 = last)
+        bool active[maxGrainLanes] {};                 // Is this voice currently playing?
     };
 
-    // DSP components (declare BEFORE parameters for initialization order)
-    juce::dsp::ProcessSpec spec;
+    // One group's per-sample inputs for a chunk, interleaved [sample][grain], filled by a
+    // scalar pass (buffer points and window lookups are per-grain gathers), and the
+    // per-lane output sums over every group, added across lanes once per sample.
+    // Samples a grain does not play have a zero window
+    static constexpr int grainChunkSize = 64;
+    static constexpr int grainChunkLanes = grainChunkSize * grainLaneGroupSize;
 
-    // Granular delay buffer (Lagrange3rd interpolation for future pitch shifting)
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> delayBuffer;
-
-    // Grain voice pool (64 pre-allocated voices)
-    static constexpr int maxGrainVoices = 64;
-    std::array<GrainVoice, maxGrainVoices> grainVoices;
+    struct alignas(pfs::simd::laneAlignment) GrainChunk
+    {
+        float gainLeft[grainLaneGroupSize];           // the group's pan gains
+        float gainRight[grainLaneGroupSize];
+        float window[grainChunkLanes];
+        float fraction[grainChunkLanes];
+        float pointsLeft[4 * grainChunkLanes];         // interpolation points -1, 0, 1, 2, grainChunkLanes apart
+        float pointsRight[4 * grainChunkLanes];
+        float mixLeft[grainChunkLanes];
+        float mixRight[grainChunkLanes];
+    };
 
-    // Grain scheduler state
-    int grainSpawnCounter = 0;         // Sample counter for grain spawning
-    int lastGrainSpawnInterval = 0;    // Cached spawn interval
+    // DSP components (declare BEFORE parameters for initialization order)
+    juce::dsp::ProcessSpec spec;
 
-    // Window function lookup table (Hann window)
-    std::vector<float> hannWindow;
-    int windowTableSize = 0;
+    // Granular delay buffer: input + feedback written once per block, read by every grain
+    // at its own absolute position (stereo, Lagrange3rd). Sized so a grain started at
+    // the longest delay can play its longest length in reverse at the highest rate
+    static constexpr double maxDelaySeconds = 2.0;     // delay_time range
+    static constexpr double maxGrainSeconds = 0.5;     // grain_size range
+    static constexpr double maxPlaybackRate = 2.0;     // +12 semitones (quantizePitchToScale)
+    GrainBuffer grainBuffer;
+    juce::int64 blockStartPosition = 0;                 // grain buffer position of the block's first sample
+
+    GrainLanes grainLanes;
+    GrainChunk grainChunk;
+    std::array<int, maxGrainLanes> activeLanes {};
+    int numActiveLanes = 0;
+    int firstFreeLane = -1;
+    std::atomic<int> requestedGrainPoolSize { defaultGrainPoolSize };
+    int grainPoolSize = defaultGrainPoolSize;           // applied at prepareToPlay
+    int grainStealFadeSamples = 1;
+
+    // Grain scheduler state: spawn times are sample positions, carried over between blocks
+    // (fractional), so the grain rate is independent of the host block size
+    static constexpr float grainSpawnJitter = 0.25f;    // +-25% random variation of each spawn interval
+    double samplesUntilNextGrain = 0.0;
+    int numActiveGrains = 0;                            // sounding (not stolen) grains
+    juce::Random random;
+
+    // Window function lookup tables (Hann window), one per power-of-two size from
+    // 2^minWindowTableOrder to 2^maxWindowTableOrder points, back to back, each with a
+    // guard point for interpolation. Filled in prepareToPlay; never resized
+    static constexpr int minWindowTableOrder = 6;      // 64 points
+    static constexpr int maxWindowTableOrder = 12;     // 4096 points
+    static constexpr int numWindowTables = maxWindowTableOrder - minWindowTableOrder + 1;
+    static constexpr int windowTableStorageSize = (2 << maxWindowTableOrder) - (1 << minWindowTableOrder) + numWindowTables;
+    std::array<float, windowTableStorageSize> hannWindowTables {};
+
+    // Share of a Hann window's energy still to come, by how far through it a grain is
+    // (0 - 1, remainingEnergyTableSize steps, guard point at the end): the stealing order
+    static constexpr int remainingEnergyTableSize = 64;
+    std::array<float, remainingEnergyTableSize + 1> hannRemainingEnergy {};
 
     // Sample rate tracking
     double currentSampleRate = 44100.0;
-    int currentDelayBufferSize = 0;
+    int maxDelaySamples = 0;
 
     // Phase 3.2: Scale quantization lookup tables
     static constexpr int numScales = 5;
@@ -93,12 +175,26 @@ private:
     juce::AudioBuffer<float> feedbackBuffer;
 
     // Helper methods
-    void spawnNewGrain(float grainSizeMs, float pitchRandomPercent, float panRandomPercent, int scaleIndex, int rootNote);
-    void updateGrainScheduler(float densityPercent, float grainSizeMs, float pitchRandomPercent, float panRandomPercent, int scaleIndex, int rootNote);
+    void spawnNewGrain(int startOffset, float gain, float delayTimeMs, float grainSizeMs, float pitchRandomPercent, float panRandomPercent, int scaleIndex, int rootNote);
+    void updateGrainScheduler(int numSamples, float densityPercent, float delayTimeMs, float grainSizeMs, float pitchRandomPercent, float panRandomPercent, int scaleIndex, int rootNote);
     void processGrainVoices(juce::AudioBuffer<float>& buffer);
-    void generateHannWindow(int sizeInSamples);
+    bool fillGrainChunk(int firstActiveLane, int chunkStart, int numSamples) noexcept;
+    template <typename Lanes> void renderGrainChunk(int numSamples) noexcept;
+    void resetGrainPool() noexcept;
+    int allocateGrainLane() noexcept;
+    int findGrainToSteal() const noexcept;
+    void removeFinishedGrains() noexcept;
+    void publishGrainSnapshot();
+    void generateHannWindowTables();
+    static int getHannWindowTableOffset(int order);
     void initializeScaleTables();
     int quantizePitchToScale(float pitchSemitones, int scaleIndex, int rootNote);
 
+    // Cached parameter pointers (declared after parameters - resolved from it)
+    ScatterParameterCache parameterCache;
+
+    // Binary get/setStateInformation (same table, resolved once)
+    ScatterStateCodec stateCodec;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScatterAudioProcessor)
 };
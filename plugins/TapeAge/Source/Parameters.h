@@ -0,0 +1,38 @@
+#pragma once
+#include "ParameterTable.h"
+#include "StateCodec.h"
+
+// Parameter table - single source of truth for IDs, ranges and defaults.
+// Order must match TapeAgeParam (it is also the host parameter order).
+enum class TapeAgeParam
+{
+    Input, Drive, Age, Mix, Output,
+    Count
+};
+
+inline constexpr std::array tapeAgeParameterTable
+{
+    // input - Input gain trim (-12dB to +12dB)
+    pfs::floatParameter("input", "Input", -12.0f, 12.0f, 0.1f, 1.0f, 0.0f),
+
+    // drive - Tape saturation amount
+    pfs::floatParameter("drive", "Drive", 0.0f, 1.0f, 0.001f, 1.0f, 0.5f),
+
+    // age - Tape degradation amount
+    pfs::floatParameter("age", "Age", 0.0f, 1.0f, 0.001f, 1.0f, 0.25f),
+
+    // mix - Dry/wet blend
+    pfs::floatParameter("mix", "Mix", 0.0f, 1.0f, 0.001f, 1.0f, 1.0f),
+
+    // output - Output gain trim (-12dB to +12dB)
+    pfs::floatParameter("output", "Output", -12.0f, 12.0f, 0.1f, 1.0f, 0.0f),
+};
+
+static_assert(tapeAgeParameterTable.size() == static_cast<size_t>(TapeAgeParam::Count));
+static_assert(pfs::isValidParameterTable(tapeAgeParameterTable));
+static_assert(pfs::hasUniqueStateHashes(tapeAgeParameterTable));
+
+using TapeAgeParameterCache = pfs::ParameterCache<TapeAgeParam, tapeAgeParameterTable.size()>;
+using TapeAgeParameterSnapshot = TapeAgeParameterCache::Snapshot;
+using TapeAgeStateCodec = pfs::StateCodec<tapeAgeParameterTable.size()>;
+
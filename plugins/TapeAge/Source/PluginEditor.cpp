@@ -6,19 +6,17 @@ TapeAgeAudioProcessorEditor::TapeAgeAudioProcessorEditor(TapeAgeAudioProcessor&
     , processorRef(p)
 {
     // Debug logging
-    juce::File debugLog("/tmp/tapeage_debug.log");
-    debugLog.appendText(
-        juce::Time::getCurrentTime().toString(true, true) + " - Editor constructor started\n");
+    PFS_LOG_DEBUG("Editor constructor started");
 
     // Log current parameter values BEFORE creating attachments
     auto* driveParam = processorRef.parameters.getRawParameterValue("drive");
     auto* ageParam = processorRef.parameters.getRawParameterValue("age");
     auto* mixParam = processorRef.parameters.getRawParameterValue("mix");
 
-    debugLog.appendText(
-        "  Parameters at editor creation - Drive: " + juce::String(driveParam->load()) +
-        ", Age: " + juce::String(ageParam->load()) +
-        ", Mix: " + juce::String(mixParam->load()) + "\n");
+    PFS_LOG_DEBUG("  Parameters at editor creation - Drive: %.3f, Age: %.3f, Mix: %.3f",
+                  static_cast<double>(driveParam->load()),
+                  static_cast<double>(ageParam->load()),
+                  static_cast<double>(mixParam->load()));
 
     // Initialize relays with parameter IDs (MUST match APVTS IDs exactly)
     inputRelay = std::make_unique<juce::WebSliderRelay>("input");
@@ -39,17 +37,13 @@ TapeAgeAudioProcessorEditor::TapeAgeAudioProcessorEditor(TapeAgeAudioProcessor&
             .withOptionsFrom(*mixRelay)
             .withOptionsFrom(*outputRelay)
             .withEventListener("jsLog", [](const auto& var) {
-                // Log JavaScript messages to file
+                // Log JavaScript messages to the diagnostic log
                 if (var.isString())
-                {
-                    juce::File("/tmp/tapeage_debug.log").appendText(
-                        juce::Time::getCurrentTime().toString(true, true) +
-                        " [JS] " + var.toString() + "\n");
-                }
+                    PFS_LOG_DEBUG("[JS] %s", var.toString().toRawUTF8());
             })
     );
 
-    debugLog.appendText("  WebView created, about to create attachments\n");
+    PFS_LOG_DEBUG("  WebView created, about to create attachments");
 
     // Initialize attachments (connect parameters to relays)
     // NOTE: These immediately call sendInitialUpdate() which sends current values to WebView
@@ -64,7 +58,7 @@ TapeAgeAudioProcessorEditor::TapeAgeAudioProcessorEditor(TapeAgeAudioProcessor&
     outputAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
         *processorRef.parameters.getParameter("output"), *outputRelay, nullptr);
 
-    debugLog.appendText("  Attachments created (sendInitialUpdate called)\n");
+    PFS_LOG_DEBUG("  Attachments created (sendInitialUpdate called)");
 
     // Add WebView to editor
     addAndMakeVisible(*webView);
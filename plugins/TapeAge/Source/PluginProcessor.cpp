@@ -1,51 +1,13 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+#include "Saturation.h"
+
+#if ! PLUGIN_DSP_ONLY
+ #include "PluginEditor.h"
+#endif
 
 juce::AudioProcessorValueTreeState::ParameterLayout TapeAgeAudioProcessor::createParameterLayout()
 {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-
-    // input - Input gain trim (-12dB to +12dB)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "input", 1 },
-        "Input",
-        juce::NormalisableRange<float>(-12.0f, 12.0f, 0.1f, 1.0f),  // -12dB to +12dB, linear
-        0.0f  // Default: 0dB (unity gain)
-    ));
-
-    // drive - Tape saturation amount
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "drive", 1 },
-        "Drive",
-        juce::NormalisableRange<float>(0.0f, 1.0f, 0.001f, 1.0f),  // 0-100%, linear
-        0.5f  // Default: 50%
-    ));
-
-    // age - Tape degradation amount
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "age", 1 },
-        "Age",
-        juce::NormalisableRange<float>(0.0f, 1.0f, 0.001f, 1.0f),  // 0-100%, linear
-        0.25f  // Default: 25%
-    ));
-
-    // mix - Dry/wet blend
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "mix", 1 },
-        "Mix",
-        juce::NormalisableRange<float>(0.0f, 1.0f, 0.001f, 1.0f),  // 0-100%, linear
-        1.0f  // Default: 100% wet
-    ));
-
-    // output - Output gain trim (-12dB to +12dB)
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { "output", 1 },
-        "Output",
-        juce::NormalisableRange<float>(-12.0f, 12.0f, 0.1f, 1.0f),  // -12dB to +12dB, linear
-        0.0f  // Default: 0dB (unity gain)
-    ));
-
-    return layout;
+    return pfs::createParameterLayout(tapeAgeParameterTable);
 }
 
 TapeAgeAudioProcessor::TapeAgeAudioProcessor()
@@ -54,6 +16,8 @@ TapeAgeAudioProcessor::TapeAgeAudioProcessor()
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , oversampler(2, 1, juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple)  // 2x oversampling, 1 stage, FIR filters
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, tapeAgeParameterTable)
+    , stateCodec(parameters, tapeAgeParameterTable)
 {
 }
 
@@ -102,11 +66,12 @@ void TapeAgeAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
     // v1.1.0: Prepare age-dependent high-frequency rolloff filters
     for (int i = 0; i < 2; ++i)
     {
+        // Initialize with 20kHz lowpass (transparent at age=0) - per-channel first-order
+        // storage, rewritten in place by processBlock (set before prepare sizes the state)
+        ageFilter[i].coefficients = pfs::BiquadCoefficients::firstOrderLowPass(sampleRate, 20000.0f)
+                                        .makeStorage(true);
         ageFilter[i].prepare(currentSpec);
         ageFilter[i].reset();
-        // Initialize with 20kHz lowpass (transparent at age=0)
-        auto coefficients = juce::dsp::IIR::Coefficients<float>::makeFirstOrderLowPass(sampleRate, 20000.0f);
-        ageFilter[i].coefficients = coefficients;
     }
 
     // Phase 4.4: Prepare dry/wet mixer
@@ -139,7 +104,7 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
         buffer.clear(i, 0, buffer.getNumSamples());
 
     // INPUT GAIN: Apply input trim FIRST (before any processing)
-    auto* inputParam = parameters.getRawParameterValue("input");
+    auto* inputParam = &parameterCache[TapeAgeParam::Input];
     float inputDB = inputParam->load();
     float inputGain = juce::Decibels::decibelsToGain(inputDB);
 
@@ -153,7 +118,7 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     dryWetMixer.pushDrySamples(block);
 
     // Read mix parameter (0.0 = fully dry, 1.0 = fully wet)
-    auto* mixParam = parameters.getRawParameterValue("mix");
+    auto* mixParam = &parameterCache[TapeAgeParam::Mix];
     float mixValue = mixParam->load();
     dryWetMixer.setWetMixProportion(mixValue);
 
@@ -165,7 +130,7 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     // 4. Downsample
 
     // Read drive parameter (0.0 to 1.0)
-    auto* driveParam = parameters.getRawParameterValue("drive");
+    auto* driveParam = &parameterCache[TapeAgeParam::Drive];
     float drive = driveParam->load();
 
     // Progressive curve mapping (architecture.md):
@@ -200,11 +165,9 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
 
     for (size_t channel = 0; channel < oversampledBlock.getNumChannels(); ++channel)
     {
-        auto* channelData = oversampledBlock.getChannelPointer(channel);
-        for (size_t sample = 0; sample < oversampledBlock.getNumSamples(); ++sample)
-        {
-            channelData[sample] = std::tanh(gain * channelData[sample]) * makeupGain;
-        }
+        // tanh(gain * x) * makeupGain, vectorised over the whole oversampled block
+        pfs::saturation::tanhBlock(oversampledBlock.getChannelPointer(channel),
+                                   static_cast<int>(oversampledBlock.getNumSamples()), gain, makeupGain);
     }
 
     // Downsample back to original sample rate
@@ -213,7 +176,7 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     // Phase 4.2: Wow/Flutter Modulation
     // Processing chain: Apply pitch modulation via delay line after saturation
     // Read age parameter (0.0 to 1.0)
-    auto* ageParam = parameters.getRawParameterValue("age");
+    auto* ageParam = &parameterCache[TapeAgeParam::Age];
     float age = ageParam->load();
 
     // Calculate LFO modulation depth based on age
@@ -280,12 +243,12 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
         // Exponential mapping for musical response: 20kHz -> 8kHz
         float cutoffFrequency = 20000.0f * std::pow(0.4f, age);  // 0.4^1 = 0.4, so 20kHz * 0.4 = 8kHz at age=1
 
-        // Update filter coefficients if cutoff changed significantly
-        auto coefficients = juce::dsp::IIR::Coefficients<float>::makeFirstOrderLowPass(currentSampleRate, cutoffFrequency);
+        // Update filter coefficients in place (no allocation on the audio thread)
+        const auto coefficients = pfs::BiquadCoefficients::firstOrderLowPass(currentSampleRate, cutoffFrequency);
 
         for (int channel = 0; channel < numChannels; ++channel)
         {
-            ageFilter[channel].coefficients = coefficients;
+            coefficients.copyTo(*ageFilter[channel].coefficients);
             auto* channelData = buffer.getWritePointer(channel);
 
             for (int sample = 0; sample < numSamples; ++sample)
@@ -421,7 +384,7 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     dryWetMixer.mixWetSamples(block);
 
     // OUTPUT GAIN: Apply output trim LAST (after all processing and mixing)
-    auto* outputParam = parameters.getRawParameterValue("output");
+    auto* outputParam = &parameterCache[TapeAgeParam::Output];
     float outputDB = outputParam->load();
     float outputGain = juce::Decibels::decibelsToGain(outputDB);
 
@@ -445,44 +408,45 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     outputLevel.store(peakDb, std::memory_order_relaxed);
 }
 
+#if PLUGIN_DSP_ONLY
+bool TapeAgeAudioProcessor::hasEditor() const
+{
+    return false;
+}
+
+juce::AudioProcessorEditor* TapeAgeAudioProcessor::createEditor()
+{
+    return nullptr;
+}
+#else
+bool TapeAgeAudioProcessor::hasEditor() const
+{
+    return true;
+}
+
 juce::AudioProcessorEditor* TapeAgeAudioProcessor::createEditor()
 {
     return new TapeAgeAudioProcessorEditor(*this);
 }
+#endif
 
 void TapeAgeAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    // Debug logging
-    juce::File("/tmp/tapeage_debug.log").appendText(
-        juce::Time::getCurrentTime().toString(true, true) + " - getStateInformation called\n");
+    PFS_LOG_DEBUG("getStateInformation called");
 
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    stateCodec.save(destData);
 }
 
 void TapeAgeAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    // Debug logging
-    juce::File debugLog("/tmp/tapeage_debug.log");
-    debugLog.appendText(
-        juce::Time::getCurrentTime().toString(true, true) + " - setStateInformation called\n");
+    PFS_LOG_DEBUG("setStateInformation called (%d bytes)", sizeInBytes);
 
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState != nullptr && xmlState->hasTagName(parameters.state.getType()))
+    if (stateCodec.load(data, sizeInBytes))
     {
-        parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
-
-        // Log parameter values after restoration
-        auto* driveParam = parameters.getRawParameterValue("drive");
-        auto* ageParam = parameters.getRawParameterValue("age");
-        auto* mixParam = parameters.getRawParameterValue("mix");
-
-        debugLog.appendText(
-            "  Parameters after restore - Drive: " + juce::String(driveParam->load()) +
-            ", Age: " + juce::String(ageParam->load()) +
-            ", Mix: " + juce::String(mixParam->load()) + "\n");
+        PFS_LOG_DEBUG("  Parameters after restore - Drive: %.3f, Age: %.3f, Mix: %.3f",
+                      static_cast<double>(parameterCache.load(TapeAgeParam::Drive)),
+                      static_cast<double>(parameterCache.load(TapeAgeParam::Age)),
+                      static_cast<double>(parameterCache.load(TapeAgeParam::Mix)));
     }
 }
 
@@ -1,6 +1,9 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "Parameters.h"
+#include "BiquadDesigner.h"
+#include "DiagnosticLog.h"
 
 class TapeAgeAudioProcessor : public juce::AudioProcessor
 {
@@ -13,7 +16,7 @@ public:
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override { return true; }
+    bool hasEditor() const override;
 
     const juce::String getName() const override { return "TAPE AGE"; }
     bool acceptsMidi() const override { return false; }
@@ -37,6 +40,12 @@ public:
     std::atomic<float> outputLevel { -100.0f };  // Peak level in dB (initialized to silence)
 
 private:
+    // Debug trace (<temp dir>/TapeAge.log) - PFS_LOG_* only queue, a background thread writes.
+    // TapeAge only logs at debug level: below it the calls compile away, so no writer is started
+   #if PFS_LOG_LEVEL >= PFS_LOG_LEVEL_DEBUG
+    pfs::ScopedDiagnosticLog diagnosticLog { "TapeAge" };
+   #endif
+
     // DSP Components (declared BEFORE parameters for initialization order)
     juce::dsp::ProcessSpec currentSpec;
 
@@ -64,5 +73,11 @@ private:
     // Parameter layout creation
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // Cached parameter pointers (declared after parameters - resolved from it)
+    TapeAgeParameterCache parameterCache;
+
+    // Binary get/setStateInformation (same table, resolved once)
+    TapeAgeStateCodec stateCodec;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TapeAgeAudioProcessor)
 };
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <cmath>
+
+namespace pfs
+{
+
+//==============================================================================
+/** How design functions evaluate tan() for the bilinear prewarp. */
+enum class TanMode
+{
+    Exact,  // std::tan
+    Fast    // juce::dsp::FastMathApproximations::tan (Pade, ~1e-7 relative error below Nyquist)
+};
+
+//==============================================================================
+/**
+    Normalised (a0 = 1) second-order section, designed without touching the heap.
+
+    The formulas are the ones juce::dsp::IIR::Coefficients::make* uses, so a
+    migrated call site sounds identical. Those factories allocate a new
+    reference-counted object on every call; these return a plain value that
+    can be copied into storage allocated once in prepareToPlay (copyTo), or
+    fed to pfs::Biquad.
+
+    First-order designs leave b2 and a2 at zero.
+*/
+struct BiquadCoefficients
+{
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
+    float a1 = 0.0f, a2 = 0.0f;
+
+    //==============================================================================
+    static float prewarp(double sampleRate, float frequency, TanMode tanMode) noexcept
+    {
+        jassert(sampleRate > 0.0);
+        jassert(frequency > 0.0f && frequency <= static_cast<float>(sampleRate * 0.5));
+
+        const auto x = juce::MathConstants<float>::pi * frequency / static_cast<float>(sampleRate);
+        return tanMode == TanMode::Fast ? juce::dsp::FastMathApproximations::tan(x) : std::tan(x);
+    }
+
+    static BiquadCoefficients lowPass(double sampleRate, float frequency, float q,
+                                      TanMode tanMode = TanMode::Exact) noexcept
+    {
+        const auto n = 1.0f / prewarp(sampleRate, frequency, tanMode);
+        const auto nSquared = n * n;
+        const auto invQ = 1.0f / q;
+        const auto c1 = 1.0f / (1.0f + invQ * n + nSquared);
+
+        return { c1, c1 * 2.0f, c1,
+                 c1 * 2.0f * (1.0f - nSquared), c1 * (1.0f - invQ * n + nSquared) };
+    }
+
+    static BiquadCoefficients highPass(double sampleRate, float frequency, float q,
+                                       TanMode tanMode = TanMode::Exact) noexcept
+    {
+        const auto n = prewarp(sampleRate, frequency, tanMode);
+        const auto nSquared = n * n;
+        const auto invQ = 1.0f / q;
+        const auto c1 = 1.0f / (1.0f + invQ * n + nSquared);
+
+        return { c1, c1 * -2.0f, c1,
+                 c1 * 2.0f * (nSquared - 1.0f), c1 * (1.0f - invQ * n + nSquared) };
+    }
+
+    static BiquadCoefficients firstOrderLowPass(double sampleRate, float frequency,
+                                                TanMode tanMode = TanMode::Exact) noexcept
+    {
+        const auto n = prewarp(sampleRate, frequency, tanMode);
+        const auto invA0 = 1.0f / (n + 1.0f);
+
+        return { n * invA0, n * invA0, 0.0f, (n - 1.0f) * invA0, 0.0f };
+    }
+
+    static BiquadCoefficients peak(double sampleRate, float frequency, float q, float gainFactor) noexcept
+    {
+        const auto A = juce::jmax(0.0f, std::sqrt(gainFactor));
+        const auto omega = juce::MathConstants<float>::twoPi * frequency / static_cast<float>(sampleRate);
+        const auto alpha = std::sin(omega) / (q * 2.0f);
+        const auto c2 = -2.0f * std::cos(omega);
+        const auto alphaTimesA = alpha * A;
+        const auto alphaOverA = alpha / A;
+
+        return normalise(1.0f + alphaTimesA, c2, 1.0f - alphaTimesA,
+                         1.0f + alphaOverA, c2, 1.0f - alphaOverA);
+    }
+
+    static BiquadCoefficients lowShelf(double sampleRate, float frequency, float q, float gainFactor) noexcept
+    {
+        const auto A = juce::jmax(0.0f, std::sqrt(gainFactor));
+        const auto aMinus1 = A - 1.0f;
+        const auto aPlus1 = A + 1.0f;
+        const auto omega = juce::MathConstants<float>::twoPi * frequency / static_cast<float>(sampleRate);
+        const auto cosOmega = std::cos(omega);
+        const auto beta = std::sin(omega) * std::sqrt(A) / q;
+        const auto aMinus1TimesCos = aMinus1 * cosOmega;
+
+        return normalise(A * (aPlus1 - aMinus1TimesCos + beta),
+                         A * 2.0f * (aMinus1 - aPlus1 * cosOmega),
+                         A * (aPlus1 - aMinus1TimesCos - beta),
+                         aPlus1 + aMinus1TimesCos + beta,
+                         -2.0f * (aMinus1 + aPlus1 * cosOmega),
+                         aPlus1 + aMinus1TimesCos - beta);
+    }
+
+    static BiquadCoefficients highShelf(double sampleRate, float frequency, float q, float gainFactor) noexcept
+    {
+        const auto A = juce::jmax(0.0f, std::sqrt(gainFactor));
+        const auto aMinus1 = A - 1.0f;
+        const auto aPlus1 = A + 1.0f;
+        const auto omega = juce::MathConstants<float>::twoPi * frequency / static_cast<float>(sampleRate);
+        const auto cosOmega = std::cos(omega);
+        const auto beta = std::sin(omega) * std::sqrt(A) / q;
+        const auto aMinus1TimesCos = aMinus1 * cosOmega;
+
+        return normalise(A * (aPlus1 + aMinus1TimesCos + beta),
+                         A * -2.0f * (aMinus1 + aPlus1 * cosOmega),
+                         A * (aPlus1 + aMinus1TimesCos - beta),
+                         aPlus1 - aMinus1TimesCos + beta,
+                         2.0f * (aMinus1 - aPlus1 * cosOmega),
+                         aPlus1 - aMinus1TimesCos - beta);
+    }
+
+    //==============================================================================
+    /** Allocates a JUCE coefficient object with these values - prepareToPlay only.
+        Gives a juce::dsp::IIR::Filter storage of the right order for copyTo.
+    */
+    juce::dsp::IIR::Coefficients<float>::Ptr makeStorage(bool firstOrder = false) const
+    {
+        if (firstOrder)
+            return new juce::dsp::IIR::Coefficients<float>(b0, b1, 1.0f, a1);
+
+        return new juce::dsp::IIR::Coefficients<float>(b0, b1, b2, 1.0f, a1, a2);
+    }
+
+    /** Overwrites JUCE coefficient storage in place - no allocation, audio-thread safe.
+        The storage order must already match (see makeStorage).
+    */
+    void copyTo(juce::dsp::IIR::Coefficients<float>& target) const noexcept
+    {
+        auto* raw = target.getRawCoefficients();
+
+        if (target.getFilterOrder() == 1)
+        {
+            jassert(b2 == 0.0f && a2 == 0.0f);
+            raw[0] = b0;
+            raw[1] = b1;
+            raw[2] = a1;
+            return;
+        }
+
+        jassert(target.getFilterOrder() == 2);
+        raw[0] = b0;
+        raw[1] = b1;
+        raw[2] = b2;
+        raw[3] = a1;
+        raw[4] = a2;
+    }
+
+private:
+    static BiquadCoefficients normalise(float rawB0, float rawB1, float rawB2,
+                                        float rawA0, float rawA1, float rawA2) noexcept
+    {
+        const auto invA0 = 1.0f / rawA0;
+        return { rawB0 * invA0, rawB1 * invA0, rawB2 * invA0, rawA1 * invA0, rawA2 * invA0 };
+    }
+};
+
+//==============================================================================
+/**
+    Mono transposed direct form II biquad with optional per-sample coefficient
+    interpolation, for filters whose cutoff moves while they run (per-voice
+    filters, modulated tone controls).
+
+    rampTo() glides linearly from the current to the target coefficients over
+    a number of samples instead of jumping at a block boundary.
+*/
+class Biquad
+{
+public:
+    void reset() noexcept
+    {
+        s1 = s2 = 0.0f;
+    }
+
+    /** Sets coefficients immediately (cancels any ramp). */
+    void setCoefficients(const BiquadCoefficients& newCoefficients) noexcept
+    {
+        coefficients = newCoefficients;
+        rampSamplesRemaining = 0;
+    }
+
+    /** Interpolates towards target over numSamples (<= 0 sets it immediately). */
+    void rampTo(const BiquadCoefficients& newTarget, int numSamples) noexcept
+    {
+        if (numSamples <= 0)
+        {
+            setCoefficients(newTarget);
+            return;
+        }
+
+        const auto scale = 1.0f / static_cast<float>(numSamples);
+
+        step.b0 = (newTarget.b0 - coefficients.b0) * scale;
+        step.b1 = (newTarget.b1 - coefficients.b1) * scale;
+        step.b2 = (newTarget.b2 - coefficients.b2) * scale;
+        step.a1 = (newTarget.a1 - coefficients.a1) * scale;
+        step.a2 = (newTarget.a2 - coefficients.a2) * scale;
+
+        target = newTarget;
+        rampSamplesRemaining = numSamples;
+    }
+
+    const BiquadCoefficients& getCoefficients() const noexcept { return coefficients; }
+
+    float processSample(float input) noexcept
+    {
+        if (rampSamplesRemaining > 0)
+            advanceRamp();
+
+        const auto& c = coefficients;
+        const auto output = c.b0 * input + s1;
+
+        s1 = c.b1 * input - c.a1 * output + s2;
+        s2 = c.b2 * input - c.a2 * output;
+
+        return output;
+    }
+
+    /** Flushes denormal state - call once per block on long-decaying filters. */
+    void snapToZero() noexcept
+    {
+        juce::dsp::util::snapToZero(s1);
+        juce::dsp::util::snapToZero(s2);
+    }
+
+private:
+    void advanceRamp() noexcept
+    {
+        if (--rampSamplesRemaining == 0)
+        {
+            coefficients = target;  // land exactly, no accumulated rounding
+            return;
+        }
+
+        coefficients.b0 += step.b0;
+        coefficients.b1 += step.b1;
+        coefficients.b2 += step.b2;
+        coefficients.a1 += step.a1;
+        coefficients.a2 += step.a2;
+    }
+
+    BiquadCoefficients coefficients, target, step;
+    int rampSamplesRemaining = 0;
+    float s1 = 0.0f, s2 = 0.0f;
+};
+
+} // namespace pfs
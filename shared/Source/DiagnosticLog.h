@@ -0,0 +1,328 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+//==============================================================================
+/*
+    Asynchronous diagnostic log, safe to call from any thread - including the
+    audio thread and host state callbacks.
+
+        PFS_LOG_ERROR("sample load failed: %s", path.toRawUTF8());
+        PFS_LOG_DEBUG("setStateInformation: drive %.2f", drive);
+
+    A call formats into a fixed-size record on the caller's stack and pushes
+    it into a bounded lock-free queue: no allocation, no lock, no file access.
+    A background writer thread drains the queue every 50 ms and appends the
+    lines to the log file. When the queue is full the record is dropped and
+    counted; the writer reports the count.
+
+    Levels above PFS_LOG_LEVEL compile to nothing (arguments included).
+    Default: everything in debug builds, warnings and errors in release.
+
+    The writer runs while at least one pfs::ScopedDiagnosticLog exists - give
+    each processor one as a member.
+*/
+
+#define PFS_LOG_LEVEL_OFF       0
+#define PFS_LOG_LEVEL_ERROR     1
+#define PFS_LOG_LEVEL_WARNING   2
+#define PFS_LOG_LEVEL_INFO      3
+#define PFS_LOG_LEVEL_DEBUG     4
+
+#ifndef PFS_LOG_LEVEL
+ #if JUCE_DEBUG
+  #define PFS_LOG_LEVEL PFS_LOG_LEVEL_DEBUG
+ #else
+  #define PFS_LOG_LEVEL PFS_LOG_LEVEL_WARNING
+ #endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+ #define PFS_LOG_PRINTF_FORMAT __attribute__((format(printf, 2, 3)))
+#else
+ #define PFS_LOG_PRINTF_FORMAT
+#endif
+
+#define PFS_LOG_AT(levelValue, level, ...) \
+    do { if constexpr ((levelValue) <= PFS_LOG_LEVEL) ::pfs::logMessage(level, __VA_ARGS__); } while (false)
+
+#define PFS_LOG_ERROR(...)    PFS_LOG_AT(PFS_LOG_LEVEL_ERROR,   ::pfs::LogLevel::Error,   __VA_ARGS__)
+#define PFS_LOG_WARNING(...)  PFS_LOG_AT(PFS_LOG_LEVEL_WARNING, ::pfs::LogLevel::Warning, __VA_ARGS__)
+#define PFS_LOG_INFO(...)     PFS_LOG_AT(PFS_LOG_LEVEL_INFO,    ::pfs::LogLevel::Info,    __VA_ARGS__)
+#define PFS_LOG_DEBUG(...)    PFS_LOG_AT(PFS_LOG_LEVEL_DEBUG,   ::pfs::LogLevel::Debug,   __VA_ARGS__)
+
+namespace pfs
+{
+
+enum class LogLevel : std::uint8_t
+{
+    Error = PFS_LOG_LEVEL_ERROR,
+    Warning = PFS_LOG_LEVEL_WARNING,
+    Info = PFS_LOG_LEVEL_INFO,
+    Debug = PFS_LOG_LEVEL_DEBUG
+};
+
+//==============================================================================
+/**
+    Bounded lock-free multi-producer / single-consumer queue (Vyukov's
+    sequence-per-cell ring). Producers never block each other or the
+    consumer; push() returns false when full.
+*/
+template <typename T, size_t Capacity>
+class MpscRing
+{
+public:
+    static_assert(std::is_trivially_copyable_v<T>, "MpscRing items are copied with plain assignment");
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    MpscRing() noexcept
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /** Any thread: appends an item, or returns false (item dropped) when full. */
+    bool push(const T& item) noexcept
+    {
+        auto position = writePosition.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& cell = cells[position & indexMask];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+            if (difference == 0)
+            {
+                if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.item = item;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = writePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /** Consumer only: takes the oldest item, or returns false when empty. */
+    bool pop(T& item) noexcept
+    {
+        auto& cell = cells[readPosition & indexMask];
+
+        if (cell.sequence.load(std::memory_order_acquire) != readPosition + 1)
+            return false;
+
+        item = cell.item;
+        cell.sequence.store(readPosition + Capacity, std::memory_order_release);
+        ++readPosition;
+        return true;
+    }
+
+private:
+    static constexpr size_t indexMask = Capacity - 1;
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence { 0 };
+        T item;
+    };
+
+    alignas(64) std::atomic<size_t> writePosition { 0 };
+    alignas(64) size_t readPosition = 0;
+    alignas(64) std::array<Cell, Capacity> cells;
+};
+
+//==============================================================================
+struct LogRecord
+{
+    juce::int64 timeMs = 0;
+    LogLevel level = LogLevel::Debug;
+    char text[243];
+};
+
+class DiagnosticLog
+{
+public:
+    static DiagnosticLog& getInstance() noexcept
+    {
+        static DiagnosticLog instance;
+        return instance;
+    }
+
+    /** Any thread: queues a record, or counts it as dropped when the queue is full. */
+    void write(const LogRecord& record) noexcept
+    {
+        if (!records.push(record))
+            numDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //==============================================================================
+    /** Message thread: the first user starts the writer (later users share its file). */
+    void addUser(const juce::File& file)
+    {
+        const std::lock_guard<std::mutex> lock(userLock);
+
+        if (numUsers++ == 0)
+        {
+            writer = std::make_unique<Writer>(*this, file);
+            writer->startThread(juce::Thread::Priority::background);
+        }
+    }
+
+    /** Message thread: the last user stops the writer after it has written everything queued. */
+    void removeUser()
+    {
+        const std::lock_guard<std::mutex> lock(userLock);
+        jassert(numUsers > 0);
+
+        if (--numUsers == 0)
+        {
+            writer->stopThread(2000);
+            writer.reset();
+        }
+    }
+
+private:
+    DiagnosticLog() = default;
+
+    //==============================================================================
+    class Writer : public juce::Thread
+    {
+    public:
+        Writer(DiagnosticLog& logToDrain, const juce::File& file)
+            : juce::Thread("Diagnostic log writer"), owner(logToDrain), logFile(file)
+        {
+        }
+
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                drain();
+                wait(drainIntervalMs);
+            }
+
+            drain();
+        }
+
+    private:
+        static constexpr int drainIntervalMs = 50;
+
+        DiagnosticLog& owner;
+        juce::File logFile;
+        std::unique_ptr<juce::FileOutputStream> stream;
+
+        void drain()
+        {
+            LogRecord record;
+            bool wroteAny = false;
+
+            while (owner.records.pop(record))
+            {
+                writeLine(juce::Time(record.timeMs).formatted("%Y-%m-%d %H:%M:%S.")
+                          + juce::String(record.timeMs % 1000).paddedLeft('0', 3)
+                          + " [" + getLevelName(record.level) + "] " + juce::String::fromUTF8(record.text));
+                wroteAny = true;
+            }
+
+            if (const auto dropped = owner.numDropped.exchange(0, std::memory_order_relaxed); dropped > 0)
+            {
+                writeLine("[log] " + juce::String(dropped) + " message(s) dropped (queue full)");
+                wroteAny = true;
+            }
+
+            if (wroteAny && stream != nullptr)
+                stream->flush();
+        }
+
+        // Opened on the first line, so plugins that never log leave no file behind
+        void writeLine(const juce::String& line)
+        {
+            if (stream == nullptr)
+                stream = std::make_unique<juce::FileOutputStream>(logFile);
+
+            if (stream->openedOk())
+                *stream << line << juce::newLine;
+        }
+
+        static const char* getLevelName(LogLevel level) noexcept
+        {
+            switch (level)
+            {
+                case LogLevel::Error:   return "error";
+                case LogLevel::Warning: return "warning";
+                case LogLevel::Info:    return "info";
+                case LogLevel::Debug:   break;
+            }
+
+            return "debug";
+        }
+
+        JUCE_DECLARE_NON_COPYABLE(Writer)
+    };
+
+    MpscRing<LogRecord, 512> records;
+    std::atomic<std::uint32_t> numDropped { 0 };
+
+    std::mutex userLock;
+    int numUsers = 0;
+    std::unique_ptr<Writer> writer;
+
+    JUCE_DECLARE_NON_COPYABLE(DiagnosticLog)
+};
+
+//==============================================================================
+/** Use through the PFS_LOG_* macros so disabled levels compile away. */
+PFS_LOG_PRINTF_FORMAT inline void logMessage(LogLevel level, const char* format, ...) noexcept
+{
+    LogRecord record;
+    record.timeMs = juce::Time::currentTimeMillis();
+    record.level = level;
+
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(record.text, sizeof(record.text), format, args);
+    va_end(args);
+
+    DiagnosticLog::getInstance().write(record);
+}
+
+/**
+    Keeps the log writer running while it exists. Messages go to
+    <temp directory>/<name>.log (appended across sessions).
+*/
+class ScopedDiagnosticLog
+{
+public:
+    explicit ScopedDiagnosticLog(const char* name)
+    {
+        DiagnosticLog::getInstance().addUser(
+            juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile(juce::String(name) + ".log"));
+    }
+
+    ~ScopedDiagnosticLog()
+    {
+        DiagnosticLog::getInstance().removeUser();
+    }
+
+private:
+    JUCE_DECLARE_NON_COPYABLE(ScopedDiagnosticLog)
+};
+
+} // namespace pfs
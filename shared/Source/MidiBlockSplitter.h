@@ -0,0 +1,68 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+namespace pfs
+{
+
+//==============================================================================
+/**
+    Sample-accurate MIDI for one slice of a block: [startSample, startSample + numSamples),
+    given the slice's events as [begin, end) of the block's MidiBuffer. Event
+    positions are taken relative to startSample (and clamped into the slice);
+    renderRange receives slice-relative positions.
+
+    Lets a processor whose scratch buffers hold fewer samples than the host
+    block render it in slices, e.g. with MidiBuffer::findNextSamplePosition()
+    at each slice end. The whole-block overload below is the common case.
+*/
+template <typename MessageHandler, typename RangeRenderer>
+void renderWithSampleAccurateMidi(juce::MidiBufferIterator begin, juce::MidiBufferIterator end,
+                                  int startSample, int numSamples,
+                                  MessageHandler&& handleMessage, RangeRenderer&& renderRange)
+{
+    const int lastSample = juce::jmax(0, numSamples - 1);
+    int position = 0;
+
+    for (auto it = begin; it != end; ++it)
+    {
+        const auto metadata = *it;
+        const int eventPosition = juce::jlimit(position, lastSample, metadata.samplePosition - startSample);
+
+        if (eventPosition > position)
+        {
+            renderRange(position, eventPosition - position);
+            position = eventPosition;
+        }
+
+        handleMessage(metadata.getMessage());
+    }
+
+    if (position < numSamples)
+        renderRange(position, numSamples - position);
+}
+
+/**
+    Sample-accurate MIDI for per-sample synth loops.
+
+    Splits a block at every MIDI event's sample position: renderRange renders
+    the voices up to the event, handleMessage applies it, and rendering resumes
+    on the exact sample the host scheduled it for. Note timing is therefore
+    independent of the host buffer size.
+
+    @param midi            the block's MIDI, in time order (as the host delivers it)
+    @param numSamples      block length
+    @param handleMessage   void (const juce::MidiMessage&)
+    @param renderRange     void (int startSample, int numSamples) - never called with 0 samples
+
+    Events stamped outside the block (misbehaving hosts) are clamped into it.
+    Events sharing a position are applied back to back, in buffer order.
+*/
+template <typename MessageHandler, typename RangeRenderer>
+void renderWithSampleAccurateMidi(const juce::MidiBuffer& midi, int numSamples,
+                                  MessageHandler&& handleMessage, RangeRenderer&& renderRange)
+{
+    renderWithSampleAccurateMidi(midi.cbegin(), midi.cend(), 0, numSamples, handleMessage, renderRange);
+}
+
+} // namespace pfs
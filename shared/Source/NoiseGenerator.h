@@ -0,0 +1,73 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+
+namespace pfs
+{
+
+//==============================================================================
+/**
+    White noise for the audio thread: eight independent xorshift32 generators
+    side by side, advanced together so fill() vectorises.
+
+    Unlike juce::Random::getSystemRandom() it is owned by whoever uses it - no
+    shared state between plugin instances or threads - and it is seeded
+    explicitly, so the same seed and the same calls render the same noise.
+*/
+class NoiseGenerator
+{
+public:
+    static constexpr int numLanes = 8;
+
+    explicit NoiseGenerator(juce::uint32 seed = 1) noexcept    { setSeed(seed); }
+
+    /** Restarts the sequence. Different seeds give unrelated sequences. */
+    void setSeed(juce::uint32 seed) noexcept
+    {
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            // Each lane's state is a hash of (seed, lane); xorshift must not start at 0
+            const auto hashed = hash(seed + 0x9e3779b9u * static_cast<juce::uint32>(lane + 1));
+            state[static_cast<size_t>(lane)] = hashed != 0 ? hashed : 0x6d2b79f5u;
+        }
+    }
+
+    /** Writes numSamples uniform values in [-1, 1). */
+    void fill(float* destination, int numSamples) noexcept
+    {
+        int i = 0;
+
+        for (; i + numLanes <= numSamples; i += numLanes)
+            for (int lane = 0; lane < numLanes; ++lane)
+                destination[i + lane] = next(state[static_cast<size_t>(lane)]);
+
+        for (int lane = 0; lane < numSamples - i; ++lane)
+            destination[i + lane] = next(state[static_cast<size_t>(lane)]);
+    }
+
+private:
+    static juce::uint32 hash(juce::uint32 x) noexcept
+    {
+        x ^= x >> 16;
+        x *= 0x7feb352du;
+        x ^= x >> 15;
+        x *= 0x846ca68bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    // Marsaglia xorshift32 step, top 24 bits mapped to [-1, 1)
+    static float next(juce::uint32& s) noexcept
+    {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+
+        return static_cast<float>(static_cast<juce::int32>(s) >> 8) * (1.0f / 8388608.0f);
+    }
+
+    std::array<juce::uint32, numLanes> state {};
+};
+
+} // namespace pfs
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <array>
+#include <atomic>
+#include <memory>
+
+namespace pfs
+{
+
+//==============================================================================
+/**
+    Compile-time description of one plugin parameter.
+
+    Each plugin declares a constexpr table of these (Source/Parameters.h) in the
+    same order as its parameter enum. The table is the single source of truth:
+    it generates the APVTS layout and resolves the raw value pointers once, so
+    the audio thread never looks a parameter up by its string ID.
+*/
+struct ParameterSpec
+{
+    enum class Type { Float, Int, Bool, Choice };
+
+    Type type = Type::Float;
+    const char* id = "";
+    const char* name = "";
+    float minValue = 0.0f;
+    float maxValue = 1.0f;
+    float interval = 0.0f;
+    float skew = 1.0f;
+    float defaultValue = 0.0f;
+    const char* label = "";
+    const char* const* choices = nullptr;
+    int numChoices = 0;
+    int version = 1;
+};
+
+constexpr ParameterSpec floatParameter(const char* id, const char* name,
+                                       float minValue, float maxValue, float interval, float skew,
+                                       float defaultValue, const char* label = "")
+{
+    return { ParameterSpec::Type::Float, id, name, minValue, maxValue, interval, skew,
+             defaultValue, label, nullptr, 0, 1 };
+}
+
+constexpr ParameterSpec intParameter(const char* id, const char* name,
+                                     int minValue, int maxValue, int defaultValue, const char* label = "")
+{
+    return { ParameterSpec::Type::Int, id, name, static_cast<float>(minValue), static_cast<float>(maxValue),
+             1.0f, 1.0f, static_cast<float>(defaultValue), label, nullptr, 0, 1 };
+}
+
+constexpr ParameterSpec boolParameter(const char* id, const char* name, bool defaultValue)
+{
+    return { ParameterSpec::Type::Bool, id, name, 0.0f, 1.0f, 1.0f, 1.0f,
+             defaultValue ? 1.0f : 0.0f, "", nullptr, 0, 1 };
+}
+
+template <size_t NumChoices>
+constexpr ParameterSpec choiceParameter(const char* id, const char* name,
+                                        const char* const (&choices)[NumChoices], int defaultIndex)
+{
+    return { ParameterSpec::Type::Choice, id, name, 0.0f, static_cast<float>(NumChoices - 1), 1.0f, 1.0f,
+             static_cast<float>(defaultIndex), "", choices, static_cast<int>(NumChoices), 1 };
+}
+
+//==============================================================================
+namespace detail
+{
+    constexpr bool idsEqual(const char* a, const char* b)
+    {
+        while (*a != 0 && *a == *b)
+        {
+            ++a;
+            ++b;
+        }
+
+        return *a == *b;
+    }
+}
+
+/** Compile-time sanity check for a table: IDs present and unique, ranges and
+    defaults consistent. Use with static_assert next to the table.
+*/
+template <size_t NumParameters>
+constexpr bool isValidParameterTable(const std::array<ParameterSpec, NumParameters>& table)
+{
+    for (size_t i = 0; i < NumParameters; ++i)
+    {
+        const auto& spec = table[i];
+
+        if (spec.id[0] == 0 || spec.name[0] == 0)
+            return false;
+
+        if (! (spec.minValue < spec.maxValue)
+            || spec.defaultValue < spec.minValue || spec.defaultValue > spec.maxValue)
+            return false;
+
+        for (size_t j = i + 1; j < NumParameters; ++j)
+            if (detail::idsEqual(spec.id, table[j].id))
+                return false;
+    }
+
+    return true;
+}
+
+//==============================================================================
+inline std::unique_ptr<juce::RangedAudioParameter> createParameter(const ParameterSpec& spec)
+{
+    const juce::ParameterID parameterID { spec.id, spec.version };
+
+    switch (spec.type)
+    {
+        case ParameterSpec::Type::Bool:
+            return std::make_unique<juce::AudioParameterBool>(
+                parameterID, spec.name, spec.defaultValue >= 0.5f,
+                juce::AudioParameterBoolAttributes().withLabel(spec.label));
+
+        case ParameterSpec::Type::Choice:
+            return std::make_unique<juce::AudioParameterChoice>(
+                parameterID, spec.name, juce::StringArray(spec.choices, spec.numChoices),
+                juce::roundToInt(spec.defaultValue));
+
+        case ParameterSpec::Type::Int:
+            return std::make_unique<juce::AudioParameterInt>(
+                parameterID, spec.name,
+                juce::roundToInt(spec.minValue), juce::roundToInt(spec.maxValue), juce::roundToInt(spec.defaultValue),
+                juce::AudioParameterIntAttributes().withLabel(spec.label));
+
+        case ParameterSpec::Type::Float:
+            break;
+    }
+
+    return std::make_unique<juce::AudioParameterFloat>(
+        parameterID, spec.name,
+        juce::NormalisableRange<float>(spec.minValue, spec.maxValue, spec.interval, spec.skew),
+        spec.defaultValue,
+        juce::AudioParameterFloatAttributes().withLabel(spec.label));
+}
+
+/** Builds the APVTS layout from a table, preserving table order (= host parameter order). */
+template <size_t NumParameters>
+juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout(const std::array<ParameterSpec, NumParameters>& table)
+{
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+
+    for (const auto& spec : table)
+        layout.add(createParameter(spec));
+
+    return layout;
+}
+
+//==============================================================================
+/**
+    Plain copy of every parameter value, taken once at the start of a block.
+    Index with the plugin's parameter enum.
+*/
+template <typename ParamEnum, size_t NumParameters>
+struct ParameterSnapshot
+{
+    std::array<float, NumParameters> values {};
+
+    float operator[](ParamEnum parameter) const noexcept { return values[static_cast<size_t>(parameter)]; }
+    float operator[](size_t index) const noexcept        { return values[index]; }
+
+    bool getBool(ParamEnum parameter) const noexcept     { return (*this)[parameter] >= 0.5f; }
+    int getIndex(ParamEnum parameter) const noexcept     { return static_cast<int>((*this)[parameter] + 0.5f); }
+};
+
+/**
+    The APVTS raw value pointers for a table, resolved once (constructor) so
+    the audio thread only does atomic loads.
+
+    Declare it AFTER the AudioProcessorValueTreeState member it reads from.
+*/
+template <typename ParamEnum, size_t NumParameters>
+class ParameterCache
+{
+public:
+    using Snapshot = ParameterSnapshot<ParamEnum, NumParameters>;
+
+    ParameterCache(juce::AudioProcessorValueTreeState& state, const std::array<ParameterSpec, NumParameters>& table)
+    {
+        for (size_t i = 0; i < NumParameters; ++i)
+        {
+            rawValues[i] = state.getRawParameterValue(table[i].id);
+            jassert(rawValues[i] != nullptr);  // Table and APVTS layout out of sync
+        }
+    }
+
+    std::atomic<float>& operator[](ParamEnum parameter) const noexcept { return *rawValues[static_cast<size_t>(parameter)]; }
+    std::atomic<float>& operator[](size_t index) const noexcept        { return *rawValues[index]; }
+
+    float load(ParamEnum parameter) const noexcept
+    {
+        return rawValues[static_cast<size_t>(parameter)]->load(std::memory_order_relaxed);
+    }
+
+    /** Loads every value in one pass - call once at the top of processBlock. */
+    Snapshot snapshot() const noexcept
+    {
+        Snapshot result;
+
+        for (size_t i = 0; i < NumParameters; ++i)
+            result.values[i] = rawValues[i]->load(std::memory_order_relaxed);
+
+        return result;
+    }
+
+private:
+    std::array<std::atomic<float>*, NumParameters> rawValues {};
+
+    JUCE_DECLARE_NON_COPYABLE(ParameterCache)
+};
+
+} // namespace pfs
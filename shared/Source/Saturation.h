@@ -0,0 +1,187 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+namespace pfs::saturation
+{
+
+//==============================================================================
+/*
+    Saturation kernels shared by the plugins: tanh, the asymmetric tube curve
+    (RedShiftDistortion) and a cubic soft clip.
+
+    Every kernel is one template written against float and
+    juce::dsp::SIMDRegister<float>, so the scalar fallback and the vector path
+    compute the same rational/polynomial approximation - a feedback loop that
+    must run per sample (scalar) sounds the same as a block run through the
+    SIMD path.
+
+    tanh is a [13/6] odd rational approximation clamped at +-7.9053 (where it
+    reaches 1.0f), max absolute error against std::tanh ~4e-7 over the whole
+    float range (tools/SaturationCheck measures it). It needs one division:
+    SIMDRegister has no divide, so divide() maps to the native instruction per
+    instruction set (SSE/AVX, NEON on AArch64, reciprocal + Newton on ARMv7).
+*/
+
+namespace detail
+{
+   #if JUCE_USE_SIMD
+    using Vector = juce::dsp::SIMDRegister<float>;
+
+    #if JUCE_USE_SSE_INTRINSICS
+     inline __m128 divideNative(__m128 a, __m128 b) noexcept { return _mm_div_ps(a, b); }
+
+     #if defined(__AVX__)
+      inline __m256 divideNative(__m256 a, __m256 b) noexcept { return _mm256_div_ps(a, b); }
+     #endif
+    #elif JUCE_USE_ARM_NEON
+     inline float32x4_t divideNative(float32x4_t a, float32x4_t b) noexcept
+     {
+      #if defined(__aarch64__) || defined(_M_ARM64)
+        return vdivq_f32(a, b);
+      #else
+        // Reciprocal estimate refined twice: ~full float precision
+        auto reciprocal = vrecpeq_f32(b);
+        reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+        reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+        return vmulq_f32(a, reciprocal);
+      #endif
+     }
+    #endif
+
+    inline Vector divide(Vector a, Vector b) noexcept   { return Vector { divideNative(a.value, b.value) }; }
+    inline Vector minimum(Vector a, Vector b) noexcept  { return Vector::min(a, b); }
+    inline Vector maximum(Vector a, Vector b) noexcept  { return Vector::max(a, b); }
+
+    /** a where x > 0, otherwise b */
+    inline Vector selectPositive(Vector x, Vector a, Vector b) noexcept
+    {
+        const auto positive = Vector::greaterThan(x, Vector::expand(0.0f));
+        return (a & positive) + (b & ~positive);
+    }
+
+    template <typename T, std::enable_if_t<std::is_same_v<T, Vector>, int> = 0>
+    inline T broadcast(float value) noexcept { return Vector::expand(value); }
+   #endif
+
+    inline float divide(float a, float b) noexcept  { return a / b; }
+    inline float minimum(float a, float b) noexcept { return std::min(a, b); }
+    inline float maximum(float a, float b) noexcept { return std::max(a, b); }
+
+    inline float selectPositive(float x, float a, float b) noexcept { return x > 0.0f ? a : b; }
+
+    template <typename T, std::enable_if_t<std::is_same_v<T, float>, int> = 0>
+    inline T broadcast(float value) noexcept { return value; }
+
+    //==============================================================================
+    template <typename T>
+    inline T tanhKernel(T x) noexcept
+    {
+        constexpr float clampValue = 7.90531110763549805f;
+
+        x = minimum(maximum(x, broadcast<T>(-clampValue)), broadcast<T>(clampValue));
+        const T x2 = x * x;
+
+        T p = broadcast<T>(-2.76076847742355e-16f);
+        p = p * x2 + 2.00018790482477e-13f;
+        p = p * x2 - 8.60467152213735e-11f;
+        p = p * x2 + 5.12229709037114e-08f;
+        p = p * x2 + 1.48572235717979e-05f;
+        p = p * x2 + 6.37261928875436e-04f;
+        p = p * x2 + 4.89352455891786e-03f;
+        p = p * x;
+
+        T q = broadcast<T>(1.19825839466702e-06f);
+        q = q * x2 + 1.18534705686654e-04f;
+        q = q * x2 + 2.26843463243900e-03f;
+        q = q * x2 + 4.89352518554385e-03f;
+
+        return divide(p, q);
+    }
+
+    // RedShiftDistortion's tube curve on an already-driven input:
+    //   x > 0:  t = tanh(1.15x), t + 0.1x^2 (1 - t)   (even harmonics)
+    //   x <= 0: 0.95 tanh(0.85x)
+    template <typename T>
+    inline T asymmetricTubeKernel(T x) noexcept
+    {
+        constexpr float asymmetry = 0.15f;
+
+        const auto one = broadcast<T>(1.0f);
+        const T driveScale = selectPositive(x, broadcast<T>(1.0f + asymmetry), broadcast<T>(1.0f - asymmetry));
+        const T saturated = tanhKernel(x * driveScale);
+
+        const T positive = saturated + x * x * 0.1f * (one - saturated);
+        const T negative = saturated * 0.95f;
+
+        return selectPositive(x, positive, negative);
+    }
+
+    // Cubic soft clip: 1.5x - 0.5x^3 on [-1, 1], +-1 beyond (unity at the knee, slope 1.5 at 0)
+    template <typename T>
+    inline T softClipKernel(T x) noexcept
+    {
+        x = minimum(maximum(x, broadcast<T>(-1.0f)), broadcast<T>(1.0f));
+        return x * (broadcast<T>(1.5f) - x * x * 0.5f);
+    }
+
+    //==============================================================================
+    /** Runs kernel(inputGain * x) * outputGain over a block in place: scalar
+        until the pointer is SIMD-aligned, vectors for the body, scalar tail.
+    */
+    template <typename Kernel>
+    inline void processBlock(float* data, int numSamples, float inputGain, float outputGain, Kernel&& kernel) noexcept
+    {
+        int i = 0;
+
+       #if JUCE_USE_SIMD
+        constexpr auto alignment = static_cast<std::uintptr_t>(Vector::SIMDRegisterSize);
+        constexpr auto lanes = static_cast<int>(Vector::SIMDNumElements);
+
+        for (; i < numSamples && (reinterpret_cast<std::uintptr_t>(data + i) % alignment) != 0; ++i)
+            data[i] = kernel(data[i] * inputGain) * outputGain;
+
+        const auto vectorInputGain = Vector::expand(inputGain);
+        const auto vectorOutputGain = Vector::expand(outputGain);
+
+        for (; i + lanes <= numSamples; i += lanes)
+        {
+            const auto input = Vector::fromRawArray(data + i);
+            (kernel(input * vectorInputGain) * vectorOutputGain).copyToRawArray(data + i);
+        }
+       #endif
+
+        for (; i < numSamples; ++i)
+            data[i] = kernel(data[i] * inputGain) * outputGain;
+    }
+}
+
+//==============================================================================
+/** Scalar kernels - per-sample code such as feedback loops. */
+inline float tanh(float x) noexcept            { return detail::tanhKernel(x); }
+inline float asymmetricTube(float x) noexcept  { return detail::asymmetricTubeKernel(x); }
+inline float softClip(float x) noexcept        { return detail::softClipKernel(x); }
+
+/** Block kernels (in place): data[i] = curve(inputGain * data[i]) * outputGain. */
+inline void tanhBlock(float* data, int numSamples, float inputGain = 1.0f, float outputGain = 1.0f) noexcept
+{
+    detail::processBlock(data, numSamples, inputGain, outputGain,
+                         [](auto x) noexcept { return detail::tanhKernel(x); });
+}
+
+inline void asymmetricTubeBlock(float* data, int numSamples, float inputGain = 1.0f, float outputGain = 1.0f) noexcept
+{
+    detail::processBlock(data, numSamples, inputGain, outputGain,
+                         [](auto x) noexcept { return detail::asymmetricTubeKernel(x); });
+}
+
+inline void softClipBlock(float* data, int numSamples, float inputGain = 1.0f, float outputGain = 1.0f) noexcept
+{
+    detail::processBlock(data, numSamples, inputGain, outputGain,
+                         [](auto x) noexcept { return detail::softClipKernel(x); });
+}
+
+} // namespace pfs::saturation
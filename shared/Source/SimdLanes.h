@@ -0,0 +1,135 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <algorithm>
+#include <type_traits>
+
+namespace pfs::simd
+{
+
+//==============================================================================
+/*
+    Lane helpers for structure-of-arrays voice engines: one voice (or grain)
+    per SIMD lane, its state kept in aligned float arrays.
+
+    Every helper has a juce::dsp::SIMDRegister<float> overload and a float
+    overload (mask = bool), so a lane kernel is written once as a template and
+    runs as vectors of `laneWidth` lanes, or one lane at a time when
+    JUCE_USE_SIMD is off. Loads and stores are aligned: lay lane arrays out
+    with alignas(laneAlignment) and a lane count that is a multiple of
+    laneWidth.
+*/
+
+#if JUCE_USE_SIMD
+ using Vector = juce::dsp::SIMDRegister<float>;
+ using VectorMask = Vector::vMaskType;
+
+ /** The widest lane type on this build, and how many lanes it holds. */
+ using NativeLanes = Vector;
+ constexpr int laneWidth = static_cast<int>(Vector::SIMDNumElements);
+#else
+ using NativeLanes = float;
+ constexpr int laneWidth = 1;
+#endif
+
+/** Alignment for lane arrays - enough for every SIMDRegister width JUCE uses. */
+constexpr size_t laneAlignment = 32;
+
+/** Rounds a lane count up to whole vectors. */
+constexpr int roundUpToLanes(int numLanes) noexcept
+{
+    return ((numLanes + laneWidth - 1) / laneWidth) * laneWidth;
+}
+
+//==============================================================================
+template <typename T> struct MaskType { using Type = bool; };
+
+#if JUCE_USE_SIMD
+template <> struct MaskType<Vector> { using Type = VectorMask; };
+#endif
+
+template <typename T> using Mask = typename MaskType<T>::Type;
+
+//==============================================================================
+template <typename T, std::enable_if_t<std::is_same_v<T, float>, int> = 0>
+inline T broadcast(float value) noexcept                 { return value; }
+
+template <typename T, std::enable_if_t<std::is_same_v<T, float>, int> = 0>
+inline T load(const float* source) noexcept              { return *source; }
+
+inline void store(float* destination, float value) noexcept     { *destination = value; }
+
+inline bool lessThan(float a, float b) noexcept                 { return a < b; }
+inline bool greaterThan(float a, float b) noexcept              { return a > b; }
+inline bool greaterThanOrEqual(float a, float b) noexcept       { return a >= b; }
+
+/** a where mask is set, otherwise b */
+inline float select(bool mask, float a, float b) noexcept       { return mask ? a : b; }
+
+inline float minimum(float a, float b) noexcept                 { return std::min(a, b); }
+inline float maximum(float a, float b) noexcept                 { return std::max(a, b); }
+
+/** Horizontal sum of all lanes. */
+inline float sumLanes(float value) noexcept                     { return value; }
+
+#if JUCE_USE_SIMD
+template <typename T, std::enable_if_t<std::is_same_v<T, Vector>, int> = 0>
+inline T broadcast(float value) noexcept                 { return Vector::expand(value); }
+
+template <typename T, std::enable_if_t<std::is_same_v<T, Vector>, int> = 0>
+inline T load(const float* source) noexcept              { return Vector::fromRawArray(source); }
+
+inline void store(float* destination, Vector value) noexcept    { value.copyToRawArray(destination); }
+
+inline VectorMask lessThan(Vector a, Vector b) noexcept            { return Vector::lessThan(a, b); }
+inline VectorMask greaterThan(Vector a, Vector b) noexcept         { return Vector::greaterThan(a, b); }
+inline VectorMask greaterThanOrEqual(Vector a, Vector b) noexcept  { return Vector::greaterThanOrEqual(a, b); }
+
+inline Vector select(VectorMask mask, Vector a, Vector b) noexcept  { return (a & mask) + (b & ~mask); }
+
+inline Vector minimum(Vector a, Vector b) noexcept              { return Vector::min(a, b); }
+inline Vector maximum(Vector a, Vector b) noexcept              { return Vector::max(a, b); }
+
+inline float sumLanes(Vector value) noexcept                    { return value.sum(); }
+#endif
+
+//==============================================================================
+/** x - 1 where x >= 1: keeps a phase accumulator (in cycles) in [0, 1) after an increment below 1. */
+template <typename T>
+inline T wrapPhase(T phase) noexcept
+{
+    const auto one = broadcast<T>(1.0f);
+    return select(greaterThanOrEqual(phase, one), phase - one, phase);
+}
+
+/**
+    sin(2 pi (phase - 0.5)) for a phase in cycles, [0, 1) - the output of a
+    juce::dsp::Oscillator running std::sin (it evaluates sin(phase - pi)).
+
+    Folds to [-pi/2, pi/2] and evaluates an odd Taylor polynomial to x^11:
+    max error ~6e-8, no division, no table.
+*/
+template <typename T>
+inline T sineFromPhase(T phase) noexcept
+{
+    const auto quarter = broadcast<T>(0.25f);
+    const auto half = broadcast<T>(0.5f);
+
+    auto u = phase - half;                                              // [-0.5, 0.5)
+    u = select(greaterThan(u, quarter), half - u, u);
+    u = select(lessThan(u, broadcast<T>(-0.25f)), broadcast<T>(-0.5f) - u, u);
+
+    const auto x = u * juce::MathConstants<float>::twoPi;               // [-pi/2, pi/2]
+    const auto x2 = x * x;
+
+    auto p = broadcast<T>(-2.5052108385441720e-08f);
+    p = p * x2 + 2.7557319223985891e-06f;
+    p = p * x2 - 1.9841269841269841e-04f;
+    p = p * x2 + 8.3333333333333333e-03f;
+    p = p * x2 - 1.6666666666666667e-01f;
+    p = p * x2 + 1.0f;
+
+    return p * x;
+}
+
+} // namespace pfs::simd
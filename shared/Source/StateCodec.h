@@ -0,0 +1,292 @@
+#pragma once
+
+#include "ParameterTable.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace pfs
+{
+
+//==============================================================================
+/*
+    Compact binary plugin state.
+
+    Hosts call getStateInformation on every autosave and undo snapshot, so the
+    state is written as a flat little-endian blob instead of APVTS XML:
+
+        header   uint32 magic 'PFSt', uint16 format version,
+                 uint16 parameter count, uint16 string count, uint16 reserved
+        params   per parameter: uint32 FNV-1a hash of the ID, float plain value
+        strings  per string: uint8 key length, key bytes,
+                 uint32 value length, value bytes (UTF-8)
+
+    Parameters are matched by ID hash, so reordering, adding or removing table
+    entries keeps old blobs loadable (unknown hashes are skipped, missing ones
+    keep their current value). Blobs that don't start with the magic are
+    handed to the XML path the plugins used before (getXmlFromBinary), so
+    sessions saved by older builds still load.
+*/
+
+constexpr std::uint32_t hashStateID(const char* id) noexcept
+{
+    std::uint32_t hash = 2166136261u;
+
+    for (; *id != 0; ++id)
+        hash = (hash ^ static_cast<std::uint8_t>(*id)) * 16777619u;
+
+    return hash;
+}
+
+/** Compile-time check that no two IDs in a table share a state hash. Use with static_assert next to the table. */
+template <size_t NumParameters>
+constexpr bool hasUniqueStateHashes(const std::array<ParameterSpec, NumParameters>& table)
+{
+    for (size_t i = 0; i < NumParameters; ++i)
+        for (size_t j = i + 1; j < NumParameters; ++j)
+            if (hashStateID(table[i].id) == hashStateID(table[j].id))
+                return false;
+
+    return true;
+}
+
+/** A named string stored next to the parameters (sample folders etc.); both refs must outlive save(). */
+struct StateString
+{
+    juce::StringRef key;
+    juce::StringRef value;
+};
+
+//==============================================================================
+/**
+    Saves and restores one processor's parameters, resolved once from its
+    parameter table. Declare it AFTER the AudioProcessorValueTreeState member.
+*/
+template <size_t NumParameters>
+class StateCodec
+{
+public:
+    static constexpr std::uint32_t magic = 0x74534650;   // "PFSt" in little-endian byte order
+    static constexpr std::uint16_t formatVersion = 1;
+
+    StateCodec(juce::AudioProcessorValueTreeState& state, const std::array<ParameterSpec, NumParameters>& table)
+        : valueTreeState(state)
+    {
+        static_assert(NumParameters <= 0xffff);
+
+        for (size_t i = 0; i < NumParameters; ++i)
+        {
+            hashes[i] = hashStateID(table[i].id);
+            parameters[i] = state.getParameter(table[i].id);
+            rawValues[i] = state.getRawParameterValue(table[i].id);
+            jassert(parameters[i] != nullptr && rawValues[i] != nullptr);  // Table and APVTS layout out of sync
+        }
+    }
+
+    //==============================================================================
+    /** Replaces destData with the binary state: one allocation, no text formatting. */
+    void save(juce::MemoryBlock& destData, const StateString* strings = nullptr, int numStrings = 0) const
+    {
+        jassert(numStrings >= 0 && numStrings <= 0xffff);
+
+        size_t size = headerSize + NumParameters * parameterEntrySize;
+
+        for (int i = 0; i < numStrings; ++i)
+            size += 1 + getNumBytes(strings[i].key) + 4 + getNumBytes(strings[i].value);
+
+        destData.setSize(size);
+        auto* out = static_cast<std::uint8_t*>(destData.getData());
+
+        out = writeUint32(out, magic);
+        out = writeUint16(out, formatVersion);
+        out = writeUint16(out, static_cast<std::uint16_t>(NumParameters));
+        out = writeUint16(out, static_cast<std::uint16_t>(numStrings));
+        out = writeUint16(out, 0);
+
+        for (size_t i = 0; i < NumParameters; ++i)
+        {
+            out = writeUint32(out, hashes[i]);
+            out = writeFloat(out, rawValues[i]->load(std::memory_order_relaxed));
+        }
+
+        for (int i = 0; i < numStrings; ++i)
+        {
+            const auto keyBytes = getNumBytes(strings[i].key);
+            const auto valueBytes = getNumBytes(strings[i].value);
+            jassert(keyBytes <= 0xff);
+
+            *out++ = static_cast<std::uint8_t>(keyBytes);
+            std::memcpy(out, strings[i].key.text.getAddress(), keyBytes);
+            out += keyBytes;
+
+            out = writeUint32(out, static_cast<std::uint32_t>(valueBytes));
+            std::memcpy(out, strings[i].value.text.getAddress(), valueBytes);
+            out += valueBytes;
+        }
+
+        jassert(out == static_cast<std::uint8_t*>(destData.getData()) + size);
+    }
+
+    //==============================================================================
+    /** Restores a binary or legacy XML state. onString(key, value) is called for
+        every stored string (for XML, every property of the root tree).
+        Returns false when the data is neither.
+    */
+    template <typename StringCallback>
+    bool load(const void* data, int sizeInBytes, StringCallback&& onString)
+    {
+        if (data == nullptr || sizeInBytes < static_cast<int>(headerSize))
+            return loadXml(data, sizeInBytes, onString);
+
+        const auto* in = static_cast<const std::uint8_t*>(data);
+        const auto* end = in + sizeInBytes;
+
+        if (readUint32(in) != magic)
+            return loadXml(data, sizeInBytes, onString);
+
+        const auto version = readUint16(in + 4);
+        const auto numEntries = static_cast<size_t>(readUint16(in + 6));
+        const auto numStrings = static_cast<int>(readUint16(in + 8));
+        in += headerSize;
+
+        // A newer build's state - refuse it rather than guess at its layout
+        if (version > formatVersion || static_cast<size_t>(end - in) < numEntries * parameterEntrySize)
+            return false;
+
+        for (size_t entry = 0; entry < numEntries; ++entry, in += parameterEntrySize)
+        {
+            const auto index = findParameter(readUint32(in), entry);
+
+            if (index < NumParameters)
+            {
+                auto* parameter = parameters[index];
+                const auto normalised = parameter->convertTo0to1(readFloat(in + 4));
+
+                if (parameter->getValue() != normalised)
+                    parameter->setValueNotifyingHost(normalised);
+            }
+        }
+
+        for (int i = 0; i < numStrings; ++i)
+        {
+            if (end - in < 1)
+                return false;
+
+            const auto keyBytes = static_cast<size_t>(*in++);
+
+            if (static_cast<size_t>(end - in) < keyBytes + 4)
+                return false;
+
+            const auto* key = in;
+            in += keyBytes;
+
+            const auto valueBytes = static_cast<size_t>(readUint32(in));
+            in += 4;
+
+            if (static_cast<size_t>(end - in) < valueBytes)
+                return false;
+
+            onString(juce::String::fromUTF8(reinterpret_cast<const char*>(key), static_cast<int>(keyBytes)),
+                     juce::String::fromUTF8(reinterpret_cast<const char*>(in), static_cast<int>(valueBytes)));
+            in += valueBytes;
+        }
+
+        return true;
+    }
+
+    bool load(const void* data, int sizeInBytes)
+    {
+        return load(data, sizeInBytes, [](const juce::String&, const juce::String&) {});
+    }
+
+private:
+    static constexpr size_t headerSize = 12;
+    static constexpr size_t parameterEntrySize = 8;
+
+    juce::AudioProcessorValueTreeState& valueTreeState;
+    std::array<std::uint32_t, NumParameters> hashes {};
+    std::array<juce::RangedAudioParameter*, NumParameters> parameters {};
+    std::array<std::atomic<float>*, NumParameters> rawValues {};
+
+    //==============================================================================
+    // Entries are written in table order, so the expected slot is tried first
+    size_t findParameter(std::uint32_t hash, size_t expectedIndex) const noexcept
+    {
+        if (expectedIndex < NumParameters && hashes[expectedIndex] == hash)
+            return expectedIndex;
+
+        for (size_t i = 0; i < NumParameters; ++i)
+            if (hashes[i] == hash)
+                return i;
+
+        return NumParameters;
+    }
+
+    template <typename StringCallback>
+    bool loadXml(const void* data, int sizeInBytes, StringCallback& onString)
+    {
+        std::unique_ptr<juce::XmlElement> xmlState(juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes));
+
+        if (xmlState == nullptr || !xmlState->hasTagName(valueTreeState.state.getType()))
+            return false;
+
+        auto state = juce::ValueTree::fromXml(*xmlState);
+        valueTreeState.replaceState(state);
+
+        for (int i = 0; i < state.getNumProperties(); ++i)
+        {
+            const auto name = state.getPropertyName(i);
+            onString(name.toString(), state.getProperty(name).toString());
+        }
+
+        return true;
+    }
+
+    //==============================================================================
+    static size_t getNumBytes(juce::StringRef text) noexcept { return text.text.sizeInBytes() - 1; }
+
+    static std::uint8_t* writeUint16(std::uint8_t* out, std::uint16_t value) noexcept
+    {
+        out[0] = static_cast<std::uint8_t>(value);
+        out[1] = static_cast<std::uint8_t>(value >> 8);
+        return out + 2;
+    }
+
+    static std::uint8_t* writeUint32(std::uint8_t* out, std::uint32_t value) noexcept
+    {
+        for (int i = 0; i < 4; ++i)
+            out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+
+        return out + 4;
+    }
+
+    static std::uint8_t* writeFloat(std::uint8_t* out, float value) noexcept
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return writeUint32(out, bits);
+    }
+
+    static std::uint16_t readUint16(const std::uint8_t* in) noexcept
+    {
+        return static_cast<std::uint16_t>(in[0] | (in[1] << 8));
+    }
+
+    static std::uint32_t readUint32(const std::uint8_t* in) noexcept
+    {
+        return static_cast<std::uint32_t>(in[0]) | (static_cast<std::uint32_t>(in[1]) << 8)
+             | (static_cast<std::uint32_t>(in[2]) << 16) | (static_cast<std::uint32_t>(in[3]) << 24);
+    }
+
+    static float readFloat(const std::uint8_t* in) noexcept
+    {
+        const auto bits = readUint32(in);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(StateCodec)
+};
+
+} // namespace pfs
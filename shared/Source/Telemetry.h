@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace pfs
+{
+
+//==============================================================================
+/**
+    Wait-free single-producer / single-consumer ring for audio → UI events
+    (voice triggers, per-block meter frames).
+
+    The audio thread push()es, one consumer thread (the editor's timer)
+    pop()s. push() never blocks or allocates: when the ring is full (no
+    editor open, or the UI stalled) the event is dropped and push() returns
+    false. Items are copied by value, so T must be trivially copyable.
+*/
+template <typename T, size_t Capacity>
+class SpscRing
+{
+public:
+    static_assert(std::is_trivially_copyable_v<T>, "SpscRing items are copied with plain assignment");
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::atomic<size_t>::is_always_lock_free);
+
+    //==============================================================================
+    /** Producer: appends an item, or returns false (item dropped) when full. */
+    bool push(const T& item) noexcept
+    {
+        const auto write = writeIndex.load(std::memory_order_relaxed);
+
+        if (write - cachedReadIndex == Capacity)
+        {
+            cachedReadIndex = readIndex.load(std::memory_order_acquire);
+
+            if (write - cachedReadIndex == Capacity)
+                return false;
+        }
+
+        slots[write & indexMask] = item;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    //==============================================================================
+    /** Consumer: takes the oldest item, or returns false when empty. */
+    bool pop(T& item) noexcept
+    {
+        const auto read = readIndex.load(std::memory_order_relaxed);
+
+        if (read == cachedWriteIndex)
+        {
+            cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+
+            if (read == cachedWriteIndex)
+                return false;
+        }
+
+        item = slots[read & indexMask];
+        readIndex.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Consumer: drops everything published so far (e.g. stale events when an editor opens). */
+    void discardAll() noexcept
+    {
+        cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+        readIndex.store(cachedWriteIndex, std::memory_order_release);
+    }
+
+private:
+    static constexpr size_t indexMask = Capacity - 1;
+
+    // Producer and consumer indices on separate cache lines; each side keeps
+    // a cached copy of the other's index to avoid touching its line per call
+    alignas(64) std::atomic<size_t> writeIndex { 0 };
+    size_t cachedReadIndex = 0;
+
+    alignas(64) std::atomic<size_t> readIndex { 0 };
+    size_t cachedWriteIndex = 0;
+
+    alignas(64) std::array<T, Capacity> slots {};
+};
+
+//==============================================================================
+/**
+    Triple-buffered snapshot for state the UI draws as a whole (grain
+    positions, spectra): the audio thread fills getWriteBuffer() and
+    publish()es it, the UI calls update() then read().
+
+    Neither side ever waits; the reader always sees a complete snapshot, and
+    snapshots published between two UI frames are skipped, not queued.
+*/
+template <typename T>
+class TripleBuffer
+{
+public:
+    static_assert(std::atomic<int>::is_always_lock_free);
+
+    //==============================================================================
+    /** Producer: the buffer to fill - its previous contents are stale, overwrite it fully. */
+    T& getWriteBuffer() noexcept { return buffers[static_cast<size_t>(writeIndex)]; }
+
+    /** Producer: makes the write buffer the latest snapshot. */
+    void publish() noexcept
+    {
+        const auto previous = shared.exchange(writeIndex | newDataFlag, std::memory_order_acq_rel);
+        writeIndex = previous & indexMask;
+    }
+
+    //==============================================================================
+    /** Consumer: picks up the latest snapshot if one was published since the last call. */
+    bool update() noexcept
+    {
+        if ((shared.load(std::memory_order_relaxed) & newDataFlag) == 0)
+            return false;
+
+        const auto previous = shared.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & indexMask;
+        return true;
+    }
+
+    /** Consumer: the snapshot picked up by the last update(). */
+    const T& read() const noexcept { return buffers[static_cast<size_t>(readIndex)]; }
+
+private:
+    static constexpr int indexMask = 0x3;
+    static constexpr int newDataFlag = 0x4;
+
+    std::array<T, 3> buffers {};
+
+    alignas(64) int writeIndex = 0;         // producer only
+    alignas(64) std::atomic<int> shared { 1 };  // buffer in the middle (+ newDataFlag)
+    alignas(64) int readIndex = 2;          // consumer only
+};
+
+} // namespace pfs
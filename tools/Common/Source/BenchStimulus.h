@@ -0,0 +1,111 @@
+#pragma once
+
+/*
+    Deterministic stimulus shared by the headless tools (PluginBench,
+    PluginRTCheck): a fixed MIDI drum pattern for instruments and a seeded
+    sweep-plus-noise signal for effects, so every tool drives a processor the
+    same way.
+*/
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <vector>
+
+namespace pfs::bench
+{
+    struct TimedMidiEvent
+    {
+        juce::int64 samplePosition;
+        juce::MidiMessage message;
+    };
+
+    //==============================================================================
+    template <typename Type>
+    juce::Array<Type> parseList(const juce::String& text)
+    {
+        juce::Array<Type> values;
+
+        for (auto& token : juce::StringArray::fromTokens(text, ",", {}))
+        {
+            if (token.trim().isNotEmpty())
+                values.add(static_cast<Type>(token.trim().getDoubleValue()));
+        }
+
+        return values;
+    }
+
+    //==============================================================================
+    // 16th notes at 120 BPM cycling through the GM drum notes used across the
+    // instruments (kick, hats, snare/clap, toms), with a repeating velocity
+    // pattern. Each note is released after a 32nd note.
+    inline std::vector<TimedMidiEvent> createMidiPattern(double sampleRate, juce::int64 totalSamples)
+    {
+        static constexpr int notes[] = { 36, 42, 38, 42, 41, 46, 45, 42, 36, 36, 38, 44, 40, 43, 39, 37 };
+        static constexpr juce::uint8 velocities[] = { 127, 70, 110, 64, 96, 80, 100, 60 };
+
+        const auto samplesPerStep = sampleRate * 60.0 / 120.0 / 4.0;
+        const auto noteLength = static_cast<juce::int64>(samplesPerStep * 0.5);
+
+        std::vector<TimedMidiEvent> events;
+
+        for (int step = 0;; ++step)
+        {
+            const auto start = static_cast<juce::int64>(step * samplesPerStep);
+
+            if (start >= totalSamples)
+                break;
+
+            const auto note = notes[step % (int) std::size(notes)];
+            const auto velocity = velocities[step % (int) std::size(velocities)];
+
+            events.push_back({ start, juce::MidiMessage::noteOn(1, note, velocity) });
+            events.push_back({ start + noteLength, juce::MidiMessage::noteOff(1, note) });
+        }
+
+        std::stable_sort(events.begin(), events.end(),
+                         [](const auto& a, const auto& b) { return a.samplePosition < b.samplePosition; });
+
+        return events;
+    }
+
+    // Copies the pattern events that fall in [blockStart, blockStart + numSamples)
+    // into midi, advancing nextEvent.
+    inline void fillMidiBlock(juce::MidiBuffer& midi, const std::vector<TimedMidiEvent>& pattern,
+                              size_t& nextEvent, juce::int64 blockStart, int numSamples)
+    {
+        midi.clear();
+
+        while (nextEvent < pattern.size()
+               && pattern[nextEvent].samplePosition < blockStart + numSamples)
+        {
+            const auto& event = pattern[nextEvent++];
+            midi.addEvent(event.message, static_cast<int>(event.samplePosition - blockStart));
+        }
+    }
+
+    // Deterministic stimulus for effects: a slow sine sweep under seeded noise,
+    // roughly -12 dBFS, different on each channel.
+    inline void fillInput(juce::AudioBuffer<float>& buffer, int numInputChannels,
+                          juce::int64 startSample, double sampleRate, juce::Random& random)
+    {
+        buffer.clear();
+
+        for (int channel = 0; channel < numInputChannels; ++channel)
+        {
+            auto* data = buffer.getWritePointer(channel);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const auto t = static_cast<double>(startSample + i) / sampleRate;
+                const auto sweepHz = 110.0 + 55.0 * std::sin(0.25 * juce::MathConstants<double>::twoPi * t);
+                const auto tone = std::sin(juce::MathConstants<double>::twoPi * sweepHz * t + channel);
+                const auto noise = random.nextFloat() * 2.0f - 1.0f;
+
+                data[i] = static_cast<float>(0.2 * tone) + 0.05f * noise;
+            }
+        }
+    }
+}
@@ -0,0 +1,405 @@
+/*
+    Drum808Check - Drum808VoiceBank against the voices it replaced
+
+    Usage:
+        Drum808Check [--seconds=0.5]
+
+    Voices: one hit of each body instrument (kick, low tom, mid tom, clap) at
+    default settings is rendered by the bank and by a reference built the way
+    the per-voice code before it was: juce::dsp::Oscillator and
+    StateVariableTPTFilter advanced one sample at a time, envelopes from
+    std::exp on a float clock. The reference takes the bank's deliberate
+    changes - a hit starts with its oscillator at the zero crossing on its
+    target pitch and its filter empty, and noise comes from the bank's own
+    seeded generators - so what is left is float rounding, the polynomial
+    sine and the envelope recurrences. Runs at 44.1 and 96 kHz over the first
+    --seconds of each hit.
+
+    Aliasing: an open hat at 44.1 kHz, across tuning and tone, from the bank's
+    PolyBLEP operators and from the old naive squares (Oscillator with a sign
+    function). A square has only odd harmonics, so the energy away from the
+    operators' odd harmonics below Nyquist is aliasing; the bank must carry at
+    least minAliasReduction dB less of it, relative to the partials.
+
+    The run fails (exit code 1) when a bound below is exceeded.
+*/
+
+#include "Drum808Voices.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    constexpr double sampleRates[] = { 44100.0, 96000.0 };
+    constexpr int blockSize = 512;
+    constexpr float hitVelocity = 0.8f;
+
+    // Toms: sine polynomial and phase accumulator rounding (cycles here, radians in Oscillator)
+    constexpr double tomErrorBound = 2.0e-3;
+
+    // Kick: as the toms, plus the pitch glide. Once 1 + exp(-t / 20ms) rounds to 1 (about
+    // 0.33 s in), Oscillator's SmoothedValue stops being re-targeted and finishes its ramp
+    // linearly, while the bank's glide stays one-pole: about 5e-3 late in the default decay
+    constexpr double kickErrorBound = 1.0e-2;
+
+    // Clap: same filter and noise; its 1.934 s tail is a recurrence whose float
+    // coefficient drifts from std::exp by about 1e-3 relative over half a second
+    constexpr double clapErrorBound = 5.0e-4;
+
+    // Aliasing check: a window of the open hat, past its attack and the filter's settling
+    constexpr double aliasSampleRate = 44100.0;
+    constexpr int spectrumOrder = 12;
+    constexpr int spectrumSize = 1 << spectrumOrder;
+    constexpr int spectrumStart = 2048;
+    constexpr double minAliasReduction = 15.0;  // dB
+
+    // Drum808Voices.cpp's hi-hat operator frequency ratios
+    constexpr float hatRatios[] = { 1.0f, 1.4f, 1.7f, 2.1f, 2.5f, 3.0f };
+
+    const char* getName(Drum808Instrument instrument)
+    {
+        constexpr const char* names[] = { "kick", "low tom", "mid tom", "clap", "closed hat", "open hat" };
+        return names[static_cast<int>(instrument)];
+    }
+
+    Drum808ParameterSnapshot getDefaultParameters()
+    {
+        Drum808ParameterSnapshot params;
+
+        for (size_t i = 0; i < drum808ParameterTable.size(); ++i)
+            params.values[i] = drum808ParameterTable[i].defaultValue;
+
+        return params;
+    }
+
+    // What the first voice of a kick or clap plays after reset(): the bank seeds slot 0
+    // with noiseSeed (kick) and noiseSeed + numVoiceSlots (clap) and fills a chunk at a
+    // time, which reads the generator in the same order as one fill of the whole hit
+    std::vector<float> createNoise(Drum808Instrument instrument, juce::uint32 bankSeed, int numSamples)
+    {
+        const auto seed = instrument == Drum808Instrument::Clap
+                            ? bankSeed + static_cast<juce::uint32>(Drum808VoiceBank::numVoiceSlots)
+                            : bankSeed;
+
+        std::vector<float> noise (static_cast<size_t>(numSamples));
+        pfs::NoiseGenerator generator (seed);
+        generator.fill(noise.data(), numSamples);
+        return noise;
+    }
+
+    std::vector<float> renderBank(Drum808Instrument instrument, const Drum808ParameterSnapshot& params,
+                                  double sampleRate, int numSamples, juce::uint32& bankSeed)
+    {
+        auto bank = std::make_unique<Drum808VoiceBank>();
+        bank->prepare(sampleRate);
+        bankSeed = bank->getNoiseSeed();
+
+        std::vector<float> outputs (static_cast<size_t>(Drum808VoiceBank::numInstruments * numSamples));
+        float* channels[Drum808VoiceBank::numInstruments];
+
+        for (int i = 0; i < Drum808VoiceBank::numInstruments; ++i)
+            channels[i] = outputs.data() + i * numSamples;
+
+        bank->setParameters(params);
+        bank->trigger(instrument, hitVelocity);
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            bank->setParameters(params);
+            bank->render(channels, start, juce::jmin(blockSize, numSamples - start));
+        }
+
+        const auto* output = channels[static_cast<int>(instrument)];
+        return { output, output + numSamples };
+    }
+
+    // The old KickVoice / TomVoice / ClapVoice processing, one hit from rest
+    std::vector<float> renderReference(Drum808Instrument instrument, const Drum808ParameterSnapshot& params,
+                                       double sampleRate, juce::uint32 bankSeed, int numSamples)
+    {
+        const juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(blockSize), 1 };
+
+        juce::dsp::Oscillator<float> oscillator ([](float x) { return std::sin(x); });
+        oscillator.prepare(spec);
+
+        juce::dsp::StateVariableTPTFilter<float> filter;
+        filter.prepare(spec);
+        filter.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
+
+        const auto noise = createNoise(instrument, bankSeed, numSamples);
+        const auto samplePeriod = 1.0f / static_cast<float>(sampleRate);
+
+        std::vector<float> output (static_cast<size_t>(numSamples));
+        float envelopeTime = 0.0f;
+
+        if (instrument == Drum808Instrument::Kick)
+        {
+            const auto level = params[Drum808Param::KickLevel] / 100.0f;
+            const auto tone = params[Drum808Param::KickTone] / 100.0f;
+            const auto decay = params[Drum808Param::KickDecay] / 1000.0f;
+            const auto baseFrequency = 60.0f * std::pow(2.0f, params[Drum808Param::KickTuning] / 12.0f);
+
+            oscillator.setFrequency(baseFrequency * 2.0f, true);
+
+            for (size_t i = 0; i < output.size(); ++i)
+            {
+                oscillator.setFrequency(baseFrequency * (1.0f + std::exp(-envelopeTime / 0.02f)));
+                const auto body = oscillator.processSample(0.0f);
+                const auto attack = noise[i] * std::exp(-envelopeTime / 0.005f) * tone;
+
+                output[i] = (body + attack) * std::exp(-envelopeTime / decay) * hitVelocity * level;
+                envelopeTime += samplePeriod;
+            }
+        }
+        else if (instrument == Drum808Instrument::LowTom || instrument == Drum808Instrument::MidTom)
+        {
+            const auto isLow = instrument == Drum808Instrument::LowTom;
+            const auto level = params[isLow ? Drum808Param::LowTomLevel : Drum808Param::MidTomLevel] / 100.0f;
+            const auto tone = params[isLow ? Drum808Param::LowTomTone : Drum808Param::MidTomTone] / 100.0f;
+            const auto decay = params[isLow ? Drum808Param::LowTomDecay : Drum808Param::MidTomDecay] / 1000.0f;
+            const auto tuning = params[isLow ? Drum808Param::LowTomTuning : Drum808Param::MidTomTuning];
+            const auto baseFrequency = (isLow ? 150.0f : 220.0f) * std::pow(2.0f, tuning / 12.0f);
+
+            oscillator.setFrequency(baseFrequency, true);
+            filter.setCutoffFrequency(baseFrequency);
+            filter.setResonance(0.5f + tone * 4.5f);
+
+            for (auto& sample : output)
+            {
+                const auto filtered = filter.processSample(0, oscillator.processSample(0.0f));
+
+                sample = filtered * std::exp(-envelopeTime / decay) * hitVelocity * level;
+                envelopeTime += samplePeriod;
+            }
+        }
+        else if (instrument == Drum808Instrument::Clap)
+        {
+            const auto level = params[Drum808Param::ClapLevel] / 100.0f;
+            const auto snap = params[Drum808Param::ClapSnap] / 100.0f;
+            const auto spike2Start = static_cast<int>(sampleRate * 0.010);
+            const auto spike3Start = static_cast<int>(sampleRate * 0.020);
+            const auto decayStart = static_cast<int>(sampleRate * 0.030);
+            const auto rate = static_cast<float>(sampleRate);
+
+            filter.setCutoffFrequency(1000.0f * std::pow(2.0f, params[Drum808Param::ClapTuning] / 12.0f));
+            filter.setResonance(2.0f + params[Drum808Param::ClapTone] / 100.0f * 3.0f);
+
+            // Spike transitions take effect one sample late, as in the old state machine
+            int stage = 0;
+
+            for (int t = 0; t < numSamples; ++t)
+            {
+                const auto filtered = filter.processSample(0, noise[static_cast<size_t>(t)]);
+                float envelope = 0.0f;
+
+                if (stage == 0)
+                {
+                    envelope = snap * std::exp(-(static_cast<float>(t) / rate) / 0.003f);
+                    stage = t >= spike2Start ? 1 : 0;
+                }
+                else if (stage == 1)
+                {
+                    envelope = snap * 0.6f * std::exp(-(static_cast<float>(t - spike2Start) / rate) / 0.003f);
+                    stage = t >= spike3Start ? 2 : 1;
+                }
+                else if (stage == 2)
+                {
+                    envelope = snap * 0.3f * std::exp(-(static_cast<float>(t - spike3Start) / rate) / 0.003f);
+                    stage = t >= decayStart ? 3 : 2;
+                }
+                else
+                {
+                    envelope = std::exp(-(static_cast<float>(t - decayStart) / rate) / 1.934f);
+                }
+
+                output[static_cast<size_t>(t)] = filtered * envelope * level * hitVelocity;
+            }
+        }
+
+        return output;
+    }
+
+    // The old HiHatVoice: six naive squares mixed into one bandpass, exp() envelope
+    std::vector<float> renderReferenceOpenHat(const Drum808ParameterSnapshot& params, double sampleRate, int numSamples)
+    {
+        const juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(blockSize), 1 };
+        const auto baseFrequency = 3500.0f * std::pow(2.0f, params[Drum808Param::OpenHatTuning] / 12.0f);
+
+        std::array<juce::dsp::Oscillator<float>, std::size(hatRatios)> operators;
+
+        for (size_t i = 0; i < operators.size(); ++i)
+        {
+            operators[i].initialise([](float x) { return x < 0.0f ? -1.0f : 1.0f; });
+            operators[i].prepare(spec);
+            operators[i].setFrequency(baseFrequency * hatRatios[i], true);
+        }
+
+        juce::dsp::StateVariableTPTFilter<float> filter;
+        filter.prepare(spec);
+        filter.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
+        filter.setResonance(4.0f);
+        filter.setCutoffFrequency(6000.0f + params[Drum808Param::OpenHatTone] / 100.0f * 6000.0f);
+
+        const auto level = params[Drum808Param::OpenHatLevel] / 100.0f;
+        const auto decay = params[Drum808Param::OpenHatDecay] / 1000.0f;
+        const auto samplePeriod = 1.0f / static_cast<float>(sampleRate);
+
+        std::vector<float> output (static_cast<size_t>(numSamples));
+        float envelopeTime = 0.0f;
+
+        for (auto& sample : output)
+        {
+            float mix = 0.0f;
+
+            for (auto& op : operators)
+                mix += op.processSample(0.0f) / static_cast<float>(operators.size());
+
+            sample = filter.processSample(0, mix) * std::exp(-envelopeTime / decay) * hitVelocity * level;
+            envelopeTime += samplePeriod;
+        }
+
+        return output;
+    }
+
+    // Energy away from the operators' odd harmonics against the energy on them, in dB
+    double getAliasRatio(const float* signal, double sampleRate, float baseFrequency)
+    {
+        juce::dsp::FFT fft (spectrumOrder);
+        std::vector<float> spectrum (static_cast<size_t>(2 * spectrumSize));
+
+        for (int i = 0; i < spectrumSize; ++i)
+        {
+            const auto hann = 0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * i / spectrumSize);
+            spectrum[static_cast<size_t>(i)] = static_cast<float>(hann * signal[i]);
+        }
+
+        fft.performFrequencyOnlyForwardTransform(spectrum.data(), true);
+
+        // Hann main lobe, plus the operators' float increments
+        const auto tolerance = 4.0 * sampleRate / spectrumSize;
+        const auto nyquist = sampleRate / 2.0;
+        double partialEnergy = 0.0, aliasEnergy = 0.0;
+
+        for (int bin = 1; bin < spectrumSize / 2; ++bin)
+        {
+            const auto frequency = bin * sampleRate / spectrumSize;
+            bool isPartial = false;
+
+            for (auto ratio : hatRatios)
+            {
+                const auto fundamental = static_cast<double>(baseFrequency * ratio);
+
+                for (auto harmonic = fundamental; harmonic < nyquist && !isPartial; harmonic += 2.0 * fundamental)
+                    isPartial = std::abs(frequency - harmonic) < tolerance;
+            }
+
+            const auto energy = juce::square(static_cast<double>(spectrum[static_cast<size_t>(bin)]));
+            (isPartial ? partialEnergy : aliasEnergy) += energy;
+        }
+
+        return 10.0 * std::log10(aliasEnergy / partialEnergy);
+    }
+
+    bool checkAliasing(float tuning, float tone)
+    {
+        auto params = getDefaultParameters();
+        params.values[static_cast<size_t>(Drum808Param::OpenHatTuning)] = tuning;
+        params.values[static_cast<size_t>(Drum808Param::OpenHatTone)] = tone;
+        params.values[static_cast<size_t>(Drum808Param::OpenHatDecay)] = 1000.0f;
+
+        constexpr int numSamples = spectrumStart + spectrumSize;
+        const auto baseFrequency = 3500.0f * std::pow(2.0f, tuning / 12.0f);
+
+        juce::uint32 bankSeed = 0;
+        const auto bankOutput = renderBank(Drum808Instrument::OpenHat, params, aliasSampleRate, numSamples, bankSeed);
+        const auto reference = renderReferenceOpenHat(params, aliasSampleRate, numSamples);
+
+        const auto naive = getAliasRatio(reference.data() + spectrumStart, aliasSampleRate, baseFrequency);
+        const auto bandLimited = getAliasRatio(bankOutput.data() + spectrumStart, aliasSampleRate, baseFrequency);
+        const auto passed = naive - bandLimited >= minAliasReduction;
+
+        std::printf("open hat  tuning %+5.1f st  tone %3.0f%%  naive %6.1f dB  band-limited %6.1f dB  (%.1f dB lower, min %.0f)  %s\n",
+                    static_cast<double>(tuning), static_cast<double>(tone), naive, bandLimited,
+                    naive - bandLimited, minAliasReduction, passed ? "ok" : "FAILED");
+
+        return passed;
+    }
+
+    bool checkVoice(Drum808Instrument instrument, double sampleRate, double seconds, double bound)
+    {
+        const auto params = getDefaultParameters();
+        const auto numSamples = juce::jmax(1, static_cast<int>(seconds * sampleRate));
+
+        juce::uint32 bankSeed = 0;
+        const auto bankOutput = renderBank(instrument, params, sampleRate, numSamples, bankSeed);
+        const auto reference = renderReference(instrument, params, sampleRate, bankSeed, numSamples);
+
+        double maxError = 0.0, peak = 0.0;
+        int worstSample = 0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto error = std::abs(static_cast<double>(bankOutput[static_cast<size_t>(i)])
+                                        - static_cast<double>(reference[static_cast<size_t>(i)]));
+
+            if (error > maxError)
+            {
+                maxError = error;
+                worstSample = i;
+            }
+
+            peak = std::max(peak, std::abs(static_cast<double>(reference[static_cast<size_t>(i)])));
+        }
+
+        // A silent render would match a silent reference: the hit must actually sound
+        const auto passed = peak > 0.01 && maxError <= bound;
+
+        std::printf("%-10s %6.1f kHz  peak %.3f  max error %.3e at sample %6d (bound %.0e)  %s\n",
+                    getName(instrument), sampleRate / 1000.0, peak, maxError, worstSample, bound,
+                    passed ? "ok" : "FAILED");
+
+        return passed;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    const juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        std::printf("usage: %s [--seconds=N]\n", args.executableName.toRawUTF8());
+        return 0;
+    }
+
+    const auto seconds = args.containsOption("--seconds") ? juce::jmax(0.01, args.getValueForOption("--seconds").getDoubleValue()) : 0.5;
+
+    std::printf("voices: one hit at default settings against the per-voice reference, first %.2f s\n\n", seconds);
+
+    bool passed = true;
+
+    for (auto sampleRate : sampleRates)
+    {
+        passed &= checkVoice(Drum808Instrument::Kick, sampleRate, seconds, kickErrorBound);
+        passed &= checkVoice(Drum808Instrument::LowTom, sampleRate, seconds, tomErrorBound);
+        passed &= checkVoice(Drum808Instrument::MidTom, sampleRate, seconds, tomErrorBound);
+        passed &= checkVoice(Drum808Instrument::Clap, sampleRate, seconds, clapErrorBound);
+    }
+
+    std::printf("\naliasing: energy off the operator partials relative to on them, %.1f kHz\n\n", aliasSampleRate / 1000.0);
+
+    const auto defaultTone = drum808ParameterTable[static_cast<size_t>(Drum808Param::OpenHatTone)].defaultValue;
+
+    for (auto tuning : { 0.0f, 7.0f, -12.0f })
+        for (auto tone : { 0.0f, defaultTone, 100.0f })
+            passed &= checkAliasing(tuning, tone);
+
+    std::printf("\n%s\n", passed ? "all checks within bounds" : "FAILED: error above bound");
+    return passed ? 0 : 1;
+}
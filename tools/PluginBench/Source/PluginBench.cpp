@@ -0,0 +1,412 @@
+/*
+    PluginBench - headless offline render / real-time-factor benchmark
+
+    Built once per plugin (<Plugin>_Bench). The processor is created through the
+    plugin's own createPluginFilter() factory and never asked for an editor, so
+    only the DSP hot path is measured.
+
+    Usage:
+        <Plugin>_Bench [--seconds=10] [--rates=44100,48000,96000]
+                       [--blocks=64,128,256,512,1024] [--instances=1]
+                       [--seed=1] [--all-buses]
+        <Plugin>_Bench --state [--iterations=2000] [--instances=1] [--seed=1]
+                       [--xml-tag=Parameters]
+
+    For every sample rate / block size pair the runner renders the requested
+    duration of deterministic input (effects) or a fixed MIDI pattern
+    (instruments) and prints:
+        - real-time factor (audio seconds rendered per wall-clock second)
+        - CPU per instance (share of the real-time budget one instance uses)
+        - per-block processBlock time p50 / p99 / max
+
+    --state measures what a host autosave / undo snapshot costs instead:
+    getStateInformation and setStateInformation time per instance for the
+    plugin's binary state, next to the APVTS XML state it replaced (built from
+    the same parameters, loaded through the plugin's XML fallback - pass the
+    plugin's APVTS root tag if it isn't "Parameters"). Loads alternate between
+    two random parameter sets so every call really changes the parameters, and
+    both formats are checked to restore the values they saved.
+*/
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "BenchStimulus.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#ifndef PLUGIN_BENCH_NAME
+ #define PLUGIN_BENCH_NAME "Plugin"
+#endif
+
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter();
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct BenchOptions
+    {
+        double seconds = 10.0;
+        juce::Array<double> sampleRates { 44100.0, 48000.0, 96000.0 };
+        juce::Array<int> blockSizes { 64, 128, 256, 512, 1024 };
+        int instances = 1;
+        juce::int64 seed = 1;
+        bool allBuses = false;
+        bool state = false;
+        int iterations = 2000;
+        juce::String xmlTag { "Parameters" };
+    };
+
+    struct BlockStats
+    {
+        double p50 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+        double total = 0.0;
+    };
+
+    //==============================================================================
+    BenchOptions parseOptions(const juce::ArgumentList& args)
+    {
+        BenchOptions options;
+
+        if (args.containsOption("--seconds"))
+            options.seconds = juce::jmax(0.1, args.getValueForOption("--seconds").getDoubleValue());
+
+        if (args.containsOption("--rates"))
+            options.sampleRates = pfs::bench::parseList<double>(args.getValueForOption("--rates"));
+
+        if (args.containsOption("--blocks"))
+            options.blockSizes = pfs::bench::parseList<int>(args.getValueForOption("--blocks"));
+
+        if (args.containsOption("--instances"))
+            options.instances = juce::jmax(1, args.getValueForOption("--instances").getIntValue());
+
+        if (args.containsOption("--seed"))
+            options.seed = args.getValueForOption("--seed").getLargeIntValue();
+
+        if (args.containsOption("--iterations"))
+            options.iterations = juce::jmax(1, args.getValueForOption("--iterations").getIntValue());
+
+        if (args.containsOption("--xml-tag"))
+            options.xmlTag = args.getValueForOption("--xml-tag");
+
+        options.allBuses = args.containsOption("--all-buses");
+        options.state = args.containsOption("--state");
+        return options;
+    }
+
+    BlockStats computeStats(std::vector<double>& blockMicros)
+    {
+        BlockStats stats;
+
+        if (blockMicros.empty())
+            return stats;
+
+        for (auto t : blockMicros)
+            stats.total += t;
+
+        std::sort(blockMicros.begin(), blockMicros.end());
+
+        auto percentile = [&blockMicros](double p)
+        {
+            const auto index = static_cast<size_t>(p * static_cast<double>(blockMicros.size() - 1) + 0.5);
+            return blockMicros[juce::jmin(index, blockMicros.size() - 1)];
+        };
+
+        stats.p50 = percentile(0.50);
+        stats.p99 = percentile(0.99);
+        stats.max = blockMicros.back();
+        return stats;
+    }
+
+    //==============================================================================
+    void runConfiguration(const BenchOptions& options, double sampleRate, int blockSize)
+    {
+        std::vector<std::unique_ptr<juce::AudioProcessor>> processors;
+
+        for (int i = 0; i < options.instances; ++i)
+        {
+            std::unique_ptr<juce::AudioProcessor> processor(createPluginFilter());
+
+            if (options.allBuses)
+                processor->enableAllBuses();
+
+            processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+            processor->prepareToPlay(sampleRate, blockSize);
+            processors.push_back(std::move(processor));
+        }
+
+        auto& first = *processors.front();
+        const auto numInputs = first.getTotalNumInputChannels();
+        const auto numChannels = juce::jmax(1, numInputs, first.getTotalNumOutputChannels());
+        const auto usesMidi = first.acceptsMidi();
+
+        const auto totalSamples = static_cast<juce::int64>(options.seconds * sampleRate);
+        const auto numBlocks = static_cast<int>((totalSamples + blockSize - 1) / blockSize);
+        const auto midiPattern = usesMidi ? pfs::bench::createMidiPattern(sampleRate, totalSamples)
+                                          : std::vector<pfs::bench::TimedMidiEvent>{};
+
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        juce::MidiBuffer midi;
+        midi.ensureSize(4096);
+
+        juce::Random random(options.seed);
+        size_t nextEvent = 0;
+
+        std::vector<double> blockMicros;
+        blockMicros.reserve(static_cast<size_t>(numBlocks) * processors.size());
+
+        juce::ScopedNoDenormals noDenormals;
+        const auto renderStart = Clock::now();
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            const auto blockStart = static_cast<juce::int64>(block) * blockSize;
+
+            pfs::bench::fillMidiBlock(midi, midiPattern, nextEvent, blockStart, blockSize);
+
+            for (auto& processor : processors)
+            {
+                // Each instance gets a freshly filled buffer, as if it were on its own track
+                pfs::bench::fillInput(buffer, numInputs, blockStart, sampleRate, random);
+
+                const auto start = Clock::now();
+                processor->processBlock(buffer, midi);
+                const auto end = Clock::now();
+
+                blockMicros.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            }
+        }
+
+        const auto wallSeconds = std::chrono::duration<double>(Clock::now() - renderStart).count();
+
+        for (auto& processor : processors)
+            processor->releaseResources();
+
+        auto stats = computeStats(blockMicros);
+
+        const auto renderedSeconds = static_cast<double>(numBlocks) * blockSize / sampleRate;
+        const auto processSeconds = stats.total * 1.0e-6;
+        const auto realTimeFactor = processSeconds > 0.0 ? renderedSeconds * options.instances / processSeconds : 0.0;
+        const auto cpuPerInstance = 100.0 * processSeconds / (renderedSeconds * options.instances);
+        const auto blockBudgetMicros = 1.0e6 * blockSize / sampleRate;
+
+        std::printf("%-8.0f %6d %10.1fx %9.3f%% %10.2f %10.2f %10.2f %10.2f %9.2fs\n",
+                    sampleRate, blockSize, realTimeFactor, cpuPerInstance,
+                    stats.p50, stats.p99, stats.max, blockBudgetMicros, wallSeconds);
+        std::fflush(stdout);
+    }
+
+    //==============================================================================
+    using ParameterValues = std::vector<float>;
+
+    ParameterValues randomiseParameters(juce::AudioProcessor& processor, juce::Random& random)
+    {
+        ParameterValues values;
+
+        for (auto* parameter : processor.getParameters())
+        {
+            parameter->setValueNotifyingHost(random.nextFloat());
+            values.push_back(parameter->getValue());
+        }
+
+        return values;
+    }
+
+    bool hasParameterValues(juce::AudioProcessor& processor, const ParameterValues& values)
+    {
+        const auto& parameters = processor.getParameters();
+
+        for (int i = 0; i < parameters.size(); ++i)
+            if (std::abs(parameters[i]->getValue() - values[static_cast<size_t>(i)]) > 1.0e-4f)
+                return false;
+
+        return true;
+    }
+
+    // The state the plugins wrote before the binary format: APVTS copyState()
+    // (one PARAM child per parameter) as XML, via copyXmlToBinary
+    void saveXmlState(juce::AudioProcessor& processor, const juce::String& rootTag, juce::MemoryBlock& destData)
+    {
+        juce::ValueTree state(rootTag);
+
+        for (auto* parameter : processor.getParameters())
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+                state.appendChild(juce::ValueTree("PARAM", { { "id", ranged->paramID },
+                                                             { "value", ranged->convertFrom0to1(ranged->getValue()) } }),
+                                  nullptr);
+
+        std::unique_ptr<juce::XmlElement> xml(state.createXml());
+        juce::AudioProcessor::copyXmlToBinary(*xml, destData);
+    }
+
+    struct StateTimes
+    {
+        size_t bytes = 0;
+        BlockStats save, load;
+        bool restored = true;
+    };
+
+    void setParameterValues(juce::AudioProcessor& processor, const ParameterValues& values)
+    {
+        const auto& parameters = processor.getParameters();
+
+        for (int i = 0; i < parameters.size(); ++i)
+            parameters[i]->setValueNotifyingHost(values[static_cast<size_t>(i)]);
+    }
+
+    template <typename Save>
+    StateTimes measureState(std::vector<std::unique_ptr<juce::AudioProcessor>>& processors,
+                            const std::vector<ParameterValues>& valuesA, const std::vector<ParameterValues>& valuesB,
+                            int iterations, Save&& save)
+    {
+        const auto numInstances = processors.size();
+        std::vector<juce::MemoryBlock> statesA(numInstances), statesB(numInstances);
+
+        StateTimes times;
+
+        for (size_t i = 0; i < numInstances; ++i)
+        {
+            setParameterValues(*processors[i], valuesA[i]);
+            save(*processors[i], statesA[i]);
+
+            setParameterValues(*processors[i], valuesB[i]);
+            save(*processors[i], statesB[i]);
+        }
+
+        times.bytes = statesA.front().getSize();
+
+        std::vector<double> saveMicros, loadMicros;
+        saveMicros.reserve(static_cast<size_t>(iterations) * numInstances);
+        loadMicros.reserve(static_cast<size_t>(iterations) * numInstances);
+
+        for (int iteration = 0; iteration < iterations; ++iteration)
+        {
+            // Every instance holds the other set, so each load changes every parameter
+            const auto loadA = (iteration % 2 == 0);
+
+            for (size_t i = 0; i < numInstances; ++i)
+            {
+                auto& processor = *processors[i];
+                const auto& state = loadA ? statesA[i] : statesB[i];
+                juce::MemoryBlock saved;
+
+                auto start = Clock::now();
+                save(processor, saved);
+                auto end = Clock::now();
+                saveMicros.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+
+                start = Clock::now();
+                processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+                end = Clock::now();
+                loadMicros.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+
+                times.restored = times.restored && hasParameterValues(processor, loadA ? valuesA[i] : valuesB[i]);
+            }
+        }
+
+        times.save = computeStats(saveMicros);
+        times.load = computeStats(loadMicros);
+        return times;
+    }
+
+    void printStateTimes(const char* format, const StateTimes& times, size_t numCalls)
+    {
+        std::printf("%-14s %8zu %10.2f %10.2f %10.2f %10.2f   %s\n", format, times.bytes,
+                    times.save.total / static_cast<double>(numCalls), times.save.p99,
+                    times.load.total / static_cast<double>(numCalls), times.load.p99,
+                    times.restored ? "ok" : "FAILED");
+        std::fflush(stdout);
+    }
+
+    bool runStateBenchmark(const BenchOptions& options)
+    {
+        std::vector<std::unique_ptr<juce::AudioProcessor>> processors;
+        std::vector<ParameterValues> valuesA, valuesB;
+        juce::Random random(options.seed);
+
+        for (int i = 0; i < options.instances; ++i)
+        {
+            processors.emplace_back(createPluginFilter());
+            valuesA.push_back(randomiseParameters(*processors.back(), random));
+            valuesB.push_back(randomiseParameters(*processors.back(), random));
+        }
+
+        const auto numCalls = static_cast<size_t>(options.iterations) * processors.size();
+
+        std::printf("%-14s %8s %10s %10s %10s %10s   %s\n",
+                    "format", "bytes", "save us", "save p99", "load us", "load p99", "restored");
+
+        const auto binary = measureState(processors, valuesA, valuesB, options.iterations,
+                                         [](juce::AudioProcessor& processor, juce::MemoryBlock& destData)
+                                         {
+                                             processor.getStateInformation(destData);
+                                         });
+        printStateTimes("binary", binary, numCalls);
+
+        const auto xml = measureState(processors, valuesA, valuesB, options.iterations,
+                                      [&options](juce::AudioProcessor& processor, juce::MemoryBlock& destData)
+                                      {
+                                          saveXmlState(processor, options.xmlTag, destData);
+                                      });
+        printStateTimes("xml (legacy)", xml, numCalls);
+
+        if (binary.save.total > 0.0 && binary.load.total > 0.0)
+            std::printf("\nbinary vs xml: save %.1fx, load %.1fx faster\n",
+                        xml.save.total / binary.save.total, xml.load.total / binary.load.total);
+
+        return binary.restored && xml.restored;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        std::printf("usage: %s [--seconds=N] [--rates=R1,R2,...] [--blocks=B1,B2,...]\n"
+                    "       [--instances=N] [--seed=N] [--all-buses]\n"
+                    "       %s --state [--iterations=N] [--instances=N] [--seed=N] [--xml-tag=T]\n",
+                    args.executableName.toRawUTF8(), args.executableName.toRawUTF8());
+        return 0;
+    }
+
+    const auto options = parseOptions(args);
+
+    if (options.state)
+    {
+        std::printf("%s: state save / load, %d iteration(s) x %d instance(s), seed %lld\n\n",
+                    PLUGIN_BENCH_NAME, options.iterations, options.instances, static_cast<long long>(options.seed));
+
+        return runStateBenchmark(options) ? 0 : 1;
+    }
+
+    if (options.sampleRates.isEmpty() || options.blockSizes.isEmpty())
+    {
+        std::fprintf(stderr, "error: --rates and --blocks need at least one value\n");
+        return 1;
+    }
+
+    std::printf("%s: %.1f s per run, %d instance(s), seed %lld%s\n\n",
+                PLUGIN_BENCH_NAME, options.seconds, options.instances,
+                static_cast<long long>(options.seed), options.allBuses ? ", all buses enabled" : "");
+
+    std::printf("%-8s %6s %11s %10s %10s %10s %10s %10s %10s\n",
+                "rate", "block", "RTF", "cpu/inst", "p50 us", "p99 us", "max us", "budget us", "wall");
+
+    for (auto sampleRate : options.sampleRates)
+        for (auto blockSize : options.blockSizes)
+            if (sampleRate > 0.0 && blockSize > 0)
+                runConfiguration(options, sampleRate, blockSize);
+
+    return 0;
+}
@@ -0,0 +1,259 @@
+/*
+    PluginRTCheck - fails when the audio thread allocates, locks or opens files
+
+    Built once per plugin (<Plugin>_RTCheck). The processor is created through
+    createPluginFilter() and driven like a host would drive it, with every
+    processBlock call made inside an rtcheck::ScopedAudioThread:
+        - the PluginBench stimulus (MIDI pattern or sweep + noise)
+        - block sizes that vary below the prepared maximum (1, odd sizes, max)
+        - with --oversized, also blocks larger than the prepared maximum, which
+          some hosts send. Only for processors that slice such blocks: one that
+          indexes buffers sized in prepareToPlay overruns them, so the run
+          corrupts memory instead of reporting
+        - a random parameter moved between blocks, from the "message thread"
+        - a getStateInformation / setStateInformation round trip mid-run
+
+    Usage:
+        <Plugin>_RTCheck [--seconds=5] [--rates=44100,96000] [--block=512]
+                         [--seed=1] [--all-buses] [--strict-state] [--oversized]
+
+    Every real-time-unsafe call site is printed once with a hit count and a
+    backtrace. The exit code is 1 if processBlock made any such call, 0 if it
+    made none, 2 if interception is not supported on this platform.
+
+    getStateInformation / setStateInformation are checked and reported too, but
+    hosts call them off the audio thread (and saving allocates the state
+    block), so they only fail the run with --strict-state.
+*/
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "BenchStimulus.h"
+#include "RealtimeGuard.h"
+
+#include <cstdio>
+#include <iterator>
+#include <memory>
+
+#ifndef PLUGIN_RTCHECK_NAME
+ #define PLUGIN_RTCHECK_NAME "Plugin"
+#endif
+
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter();
+
+namespace
+{
+    // The guard keeps scope names by pointer - they must outlive the report
+    constexpr const char* processBlockScope = "processBlock";
+    constexpr const char* getStateScope = "getStateInformation";
+    constexpr const char* setStateScope = "setStateInformation";
+
+    struct CheckOptions
+    {
+        double seconds = 5.0;
+        juce::Array<double> sampleRates { 44100.0, 96000.0 };
+        int maximumBlockSize = 512;
+        juce::int64 seed = 1;
+        bool allBuses = false;
+        bool strictState = false;
+        bool oversizedBlocks = false;
+    };
+
+    CheckOptions parseOptions(const juce::ArgumentList& args)
+    {
+        CheckOptions options;
+
+        if (args.containsOption("--seconds"))
+            options.seconds = juce::jmax(0.1, args.getValueForOption("--seconds").getDoubleValue());
+
+        if (args.containsOption("--rates"))
+            options.sampleRates = pfs::bench::parseList<double>(args.getValueForOption("--rates"));
+
+        if (args.containsOption("--block"))
+            options.maximumBlockSize = juce::jmax(1, args.getValueForOption("--block").getIntValue());
+
+        if (args.containsOption("--seed"))
+            options.seed = args.getValueForOption("--seed").getLargeIntValue();
+
+        options.allBuses = args.containsOption("--all-buses");
+        options.strictState = args.containsOption("--strict-state");
+        options.oversizedBlocks = args.containsOption("--oversized");
+        return options;
+    }
+
+    // Largest block the oversized part of the pattern sends
+    int getOversizedBlockSize(int maximumBlockSize)
+    {
+        return maximumBlockSize * 2 + 3;
+    }
+
+    // Hosts may pass any block size up to the prepared maximum - cycle through
+    // the ones that expose "resize on block-size change" code paths. Some hosts
+    // also exceed the maximum; with oversizedBlocks the pattern goes past it too,
+    // for processors that split such blocks rather than grow their buffers.
+    int getBlockSize(int blockIndex, int maximumBlockSize, bool oversizedBlocks)
+    {
+        const int pattern[] = { maximumBlockSize, maximumBlockSize, maximumBlockSize / 2, 1,
+                                maximumBlockSize - 1, maximumBlockSize / 3 + 1, maximumBlockSize, 17,
+                                getOversizedBlockSize(maximumBlockSize), maximumBlockSize + 1 };
+
+        const auto largestBlockSize = oversizedBlocks ? getOversizedBlockSize(maximumBlockSize) : maximumBlockSize;
+        return juce::jlimit(1, largestBlockSize, pattern[blockIndex % (int) std::size(pattern)]);
+    }
+
+    //==============================================================================
+    struct RunResult
+    {
+        juce::int64 processViolations = 0;
+        juce::int64 stateViolations = 0;
+    };
+
+    RunResult runCheck(const CheckOptions& options, double sampleRate)
+    {
+        std::unique_ptr<juce::AudioProcessor> processor(createPluginFilter());
+
+        if (options.allBuses)
+            processor->enableAllBuses();
+
+        const auto maximumBlockSize = options.maximumBlockSize;
+
+        processor->setRateAndBufferSizeDetails(sampleRate, maximumBlockSize);
+        processor->prepareToPlay(sampleRate, maximumBlockSize);
+
+        const auto numInputs = processor->getTotalNumInputChannels();
+        const auto numChannels = juce::jmax(1, numInputs, processor->getTotalNumOutputChannels());
+
+        const auto totalSamples = static_cast<juce::int64>(options.seconds * sampleRate);
+        const auto midiPattern = processor->acceptsMidi() ? pfs::bench::createMidiPattern(sampleRate, totalSamples)
+                                                          : std::vector<pfs::bench::TimedMidiEvent>{};
+
+        auto& parameters = processor->getParameters();
+
+        juce::AudioBuffer<float> storage(numChannels, options.oversizedBlocks ? getOversizedBlockSize(maximumBlockSize)
+                                                                              : maximumBlockSize);
+        juce::MidiBuffer midi;
+        midi.ensureSize(4096);
+
+        juce::MemoryBlock state;
+        state.ensureSize(64 * 1024);
+
+        juce::Random random(options.seed);
+        size_t nextEvent = 0;
+        bool stateRoundTripDone = false;
+
+        juce::ScopedNoDenormals noDenormals;
+        rtcheck::clear();
+
+        juce::int64 position = 0;
+
+        for (int block = 0; position < totalSamples; ++block)
+        {
+            const auto numSamples = getBlockSize(block, maximumBlockSize, options.oversizedBlocks);
+
+            // Host side, outside the guarded scope: stimulus, MIDI, automation
+            juce::AudioBuffer<float> buffer(storage.getArrayOfWritePointers(), numChannels, numSamples);
+            pfs::bench::fillInput(buffer, numInputs, position, sampleRate, random);
+            pfs::bench::fillMidiBlock(midi, midiPattern, nextEvent, position, numSamples);
+
+            if (block % 4 == 0 && !parameters.isEmpty())
+                parameters[random.nextInt(parameters.size())]->setValueNotifyingHost(random.nextFloat());
+
+            if (!stateRoundTripDone && position >= totalSamples / 2)
+            {
+                {
+                    rtcheck::ScopedAudioThread scope(getStateScope, block);
+                    processor->getStateInformation(state);
+                }
+                {
+                    rtcheck::ScopedAudioThread scope(setStateScope, block);
+                    processor->setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+                }
+
+                stateRoundTripDone = true;
+            }
+
+            {
+                rtcheck::ScopedAudioThread scope(processBlockScope, block);
+                processor->processBlock(buffer, midi);
+            }
+
+            position += numSamples;
+        }
+
+        processor->releaseResources();
+
+        RunResult result;
+        result.processViolations = rtcheck::getNumViolations(processBlockScope);
+        result.stateViolations = rtcheck::getNumViolations(getStateScope) + rtcheck::getNumViolations(setStateScope);
+
+        std::printf("%-8.0f %10lld %14lld %14lld\n", sampleRate,
+                    static_cast<long long>(result.processViolations),
+                    static_cast<long long>(rtcheck::getNumViolations(getStateScope)),
+                    static_cast<long long>(rtcheck::getNumViolations(setStateScope)));
+        std::fflush(stdout);
+
+        for (auto* scopeName : { processBlockScope, getStateScope, setStateScope })
+            rtcheck::printReport(scopeName, stdout);
+
+        return result;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    rtcheck::initialise();
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        std::printf("usage: %s [--seconds=N] [--rates=R1,R2,...] [--block=N]\n"
+                    "       [--seed=N] [--all-buses] [--strict-state] [--oversized]\n",
+                    args.executableName.toRawUTF8());
+        return 0;
+    }
+
+    if (!rtcheck::isAvailable())
+    {
+        std::fprintf(stderr, "error: real-time call interception is not supported on this platform\n");
+        return 2;
+    }
+
+    const auto options = parseOptions(args);
+
+    if (options.sampleRates.isEmpty())
+    {
+        std::fprintf(stderr, "error: --rates needs at least one value\n");
+        return 1;
+    }
+
+    std::printf("%s: %.1f s per run, block size up to %d (prepared %d), seed %lld%s\n\n",
+                PLUGIN_RTCHECK_NAME, options.seconds,
+                options.oversizedBlocks ? getOversizedBlockSize(options.maximumBlockSize) : options.maximumBlockSize,
+                options.maximumBlockSize,
+                static_cast<long long>(options.seed), options.allBuses ? ", all buses enabled" : "");
+
+    std::printf("%-8s %10s %14s %14s\n", "rate", "process", "getState", "setState");
+
+    juce::int64 processViolations = 0, stateViolations = 0;
+
+    for (auto sampleRate : options.sampleRates)
+    {
+        if (sampleRate <= 0.0)
+            continue;
+
+        const auto result = runCheck(options, sampleRate);
+        processViolations += result.processViolations;
+        stateViolations += result.stateViolations;
+    }
+
+    const auto failed = processViolations > 0 || (options.strictState && stateViolations > 0);
+
+    std::printf("\n%s: %s (%lld in processBlock, %lld in state calls%s)\n",
+                PLUGIN_RTCHECK_NAME, failed ? "FAILED" : "passed",
+                static_cast<long long>(processViolations), static_cast<long long>(stateViolations),
+                options.strictState ? "" : ", not gated");
+
+    return failed ? 1 : 0;
+}
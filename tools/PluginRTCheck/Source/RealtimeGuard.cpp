@@ -0,0 +1,485 @@
+#include "RealtimeGuard.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdarg>
+#include <cstddef>
+#include <cstring>
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+ #define RTCHECK_DYLD_INTERPOSE 1
+#elif defined(__GLIBC__)
+ #define RTCHECK_GLIBC_REPLACE 1
+#endif
+
+namespace rtcheck
+{
+namespace
+{
+    constexpr int maxSites = 64;
+    constexpr int maxFrames = 24;
+    constexpr int maxScopes = 8;
+    constexpr int hookFrames = 2;   // record() + the hook itself
+
+    struct Site
+    {
+        Violation kind;
+        const char* scope;
+        std::int64_t firstBlock;
+        std::int64_t hits;
+        void* frames[maxFrames];
+        int numFrames;
+    };
+
+    struct ScopeCount
+    {
+        const char* name;
+        std::int64_t count;
+    };
+
+    // Fixed storage: the hooks run inside malloc and must not allocate themselves
+    Site sites[maxSites];
+    int numSites = 0;
+    std::int64_t droppedHits = 0;
+
+    ScopeCount scopeCounts[maxScopes];
+    int numScopes = 0;
+
+    // Written by ScopedAudioThread before scopeActive is published, read by the hooks
+    std::atomic<bool> scopeActive { false };
+    pthread_t audioThread;
+    const char* currentScope = nullptr;
+    std::int64_t currentBlock = 0;
+
+    // Only touched by the audio thread while a scope is active
+    bool insideHook = false;
+
+    bool isStrEqual(const char* a, const char* b) noexcept
+    {
+        return a == b || std::strcmp(a, b) == 0;
+    }
+
+    ScopeCount* findScope(const char* scopeName, bool create) noexcept
+    {
+        for (int i = 0; i < numScopes; ++i)
+            if (isStrEqual(scopeCounts[i].name, scopeName))
+                return &scopeCounts[i];
+
+        if (!create || numScopes == maxScopes)
+            return nullptr;
+
+        scopeCounts[numScopes] = { scopeName, 0 };
+        return &scopeCounts[numScopes++];
+    }
+
+    void record(Violation kind) noexcept
+    {
+        if (!scopeActive.load(std::memory_order_acquire)
+            || !pthread_equal(pthread_self(), audioThread)
+            || insideHook)
+            return;
+
+        insideHook = true;  // anything backtrace() does below goes through unrecorded
+
+        void* frames[maxFrames + hookFrames];
+        const auto captured = backtrace(frames, maxFrames + hookFrames);
+        const auto numFrames = captured > hookFrames ? captured - hookFrames : 0;
+        void** stack = frames + (captured - numFrames);
+
+        if (auto* scope = findScope(currentScope, true))
+            ++scope->count;
+
+        Site* site = nullptr;
+
+        for (int i = 0; i < numSites && site == nullptr; ++i)
+        {
+            auto& candidate = sites[i];
+
+            if (candidate.kind == kind && candidate.scope == currentScope
+                && candidate.numFrames == numFrames
+                && std::memcmp(candidate.frames, stack, sizeof(void*) * static_cast<size_t>(numFrames)) == 0)
+                site = &candidate;
+        }
+
+        if (site == nullptr && numSites < maxSites)
+        {
+            site = &sites[numSites++];
+            site->kind = kind;
+            site->scope = currentScope;
+            site->firstBlock = currentBlock;
+            site->hits = 0;
+            site->numFrames = numFrames;
+            std::memcpy(site->frames, stack, sizeof(void*) * static_cast<size_t>(numFrames));
+        }
+
+        if (site != nullptr)
+            ++site->hits;
+        else
+            ++droppedHits;
+
+        insideHook = false;
+    }
+
+    // Looks up every real function a hook forwards to (defined with the hooks below)
+    void resolveNextFunctions() noexcept;
+
+    int readOpenMode(int flags, va_list args) noexcept
+    {
+        auto needsMode = (flags & O_CREAT) != 0;
+
+       #ifdef O_TMPFILE
+        needsMode = needsMode || (flags & O_TMPFILE) == O_TMPFILE;
+       #endif
+
+        return needsMode ? va_arg(args, int) : 0;
+    }
+}
+
+//==============================================================================
+const char* getViolationName(Violation kind) noexcept
+{
+    switch (kind)
+    {
+        case Violation::Allocation:   return "allocation";
+        case Violation::Deallocation: return "deallocation";
+        case Violation::MutexLock:    return "mutex lock";
+        case Violation::FileOpen:     return "file open";
+    }
+
+    return "unknown";
+}
+
+bool isAvailable() noexcept
+{
+   #if RTCHECK_DYLD_INTERPOSE || RTCHECK_GLIBC_REPLACE
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+void initialise()
+{
+    // dlsym() may allocate, so it runs here rather than on a hook's first call inside a scope
+    resolveNextFunctions();
+
+    // glibc loads the unwinder lazily on the first backtrace() call
+    void* frames[4];
+    backtrace(frames, 4);
+}
+
+ScopedAudioThread::ScopedAudioThread(const char* scopeName, std::int64_t blockIndex) noexcept
+{
+    audioThread = pthread_self();
+    currentScope = scopeName;
+    currentBlock = blockIndex;
+    scopeActive.store(true, std::memory_order_release);
+}
+
+ScopedAudioThread::~ScopedAudioThread() noexcept
+{
+    scopeActive.store(false, std::memory_order_release);
+}
+
+std::int64_t getNumViolations(const char* scopeName) noexcept
+{
+    if (auto* scope = findScope(scopeName, false))
+        return scope->count;
+
+    return 0;
+}
+
+void printReport(const char* scopeName, std::FILE* stream)
+{
+    for (int i = 0; i < numSites; ++i)
+    {
+        const auto& site = sites[i];
+
+        if (!isStrEqual(site.scope, scopeName))
+            continue;
+
+        std::fprintf(stream, "\n  %s in %s: %lld hit(s), first in block %lld\n",
+                     getViolationName(site.kind), site.scope,
+                     static_cast<long long>(site.hits), static_cast<long long>(site.firstBlock));
+        std::fflush(stream);
+
+        backtrace_symbols_fd(site.frames, site.numFrames, fileno(stream));
+    }
+
+    if (droppedHits > 0)
+        std::fprintf(stream, "\n  (%lld further hit(s) from call sites beyond the first %d not shown)\n",
+                     static_cast<long long>(droppedHits), maxSites);
+}
+
+void clear() noexcept
+{
+    numSites = 0;
+    numScopes = 0;
+    droppedHits = 0;
+}
+} // namespace rtcheck
+
+using rtcheck::Violation;
+
+//==============================================================================
+#if RTCHECK_GLIBC_REPLACE
+
+// glibc allows the application to replace the malloc family; the replacements
+// forward to glibc's own allocator through its __libc_* entry points. The
+// other hooks forward to the next definition, found with dlsym(RTLD_NEXT) by
+// initialise() (or on first use, if a hook runs before it).
+// Asm labels give the exact symbol names regardless of how the system
+// headers redirect them (_FILE_OFFSET_BITS, _FORTIFY_SOURCE).
+
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void __libc_free(void*);
+}
+
+namespace
+{
+    template <typename Function>
+    Function resolveNext(Function& cached, const char* name) noexcept
+    {
+        if (cached == nullptr)
+            cached = reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+
+        return cached;
+    }
+
+    using MutexLockFunction = int (*)(pthread_mutex_t*);
+    using OpenFunction = int (*)(const char*, int, ...);
+    using FopenFunction = std::FILE* (*)(const char*, const char*);
+
+    MutexLockFunction nextMutexLock = nullptr;
+    OpenFunction nextOpen = nullptr, nextOpen64 = nullptr;
+    FopenFunction nextFopen = nullptr, nextFopen64 = nullptr;
+}
+
+namespace rtcheck
+{
+namespace
+{
+    void resolveNextFunctions() noexcept
+    {
+        resolveNext(nextMutexLock, "pthread_mutex_lock");
+        resolveNext(nextOpen, "open");
+        resolveNext(nextOpen64, "open64");
+        resolveNext(nextFopen, "fopen");
+        resolveNext(nextFopen64, "fopen64");
+    }
+}
+} // namespace rtcheck
+
+void* rtcheckMalloc(size_t) __asm__("malloc");
+void* rtcheckCalloc(size_t, size_t) __asm__("calloc");
+void* rtcheckRealloc(void*, size_t) __asm__("realloc");
+void* rtcheckMemalign(size_t, size_t) __asm__("memalign");
+void* rtcheckAlignedAlloc(size_t, size_t) __asm__("aligned_alloc");
+int rtcheckPosixMemalign(void**, size_t, size_t) __asm__("posix_memalign");
+void rtcheckFree(void*) __asm__("free");
+int rtcheckMutexLock(pthread_mutex_t*) __asm__("pthread_mutex_lock");
+int rtcheckOpen(const char*, int, ...) __asm__("open");
+int rtcheckOpen64(const char*, int, ...) __asm__("open64");
+std::FILE* rtcheckFopen(const char*, const char*) __asm__("fopen");
+std::FILE* rtcheckFopen64(const char*, const char*) __asm__("fopen64");
+
+void* rtcheckMalloc(size_t size)
+{
+    rtcheck::record(Violation::Allocation);
+    return __libc_malloc(size);
+}
+
+void* rtcheckCalloc(size_t count, size_t size)
+{
+    rtcheck::record(Violation::Allocation);
+    return __libc_calloc(count, size);
+}
+
+void* rtcheckRealloc(void* pointer, size_t size)
+{
+    rtcheck::record(Violation::Allocation);
+    return __libc_realloc(pointer, size);
+}
+
+void* rtcheckMemalign(size_t alignment, size_t size)
+{
+    rtcheck::record(Violation::Allocation);
+    return __libc_memalign(alignment, size);
+}
+
+void* rtcheckAlignedAlloc(size_t alignment, size_t size)
+{
+    rtcheck::record(Violation::Allocation);
+    return __libc_memalign(alignment, size);
+}
+
+int rtcheckPosixMemalign(void** result, size_t alignment, size_t size)
+{
+    rtcheck::record(Violation::Allocation);
+
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+        return EINVAL;
+
+    *result = __libc_memalign(alignment, size);
+    return *result != nullptr ? 0 : ENOMEM;
+}
+
+void rtcheckFree(void* pointer)
+{
+    if (pointer != nullptr)
+        rtcheck::record(Violation::Deallocation);
+
+    __libc_free(pointer);
+}
+
+int rtcheckMutexLock(pthread_mutex_t* mutex)
+{
+    rtcheck::record(Violation::MutexLock);
+    return resolveNext(nextMutexLock, "pthread_mutex_lock")(mutex);
+}
+
+int rtcheckOpen(const char* path, int flags, ...)
+{
+    va_list args;
+    va_start(args, flags);
+    const auto mode = rtcheck::readOpenMode(flags, args);
+    va_end(args);
+
+    rtcheck::record(Violation::FileOpen);
+    return resolveNext(nextOpen, "open")(path, flags, mode);
+}
+
+int rtcheckOpen64(const char* path, int flags, ...)
+{
+    va_list args;
+    va_start(args, flags);
+    const auto mode = rtcheck::readOpenMode(flags, args);
+    va_end(args);
+
+    rtcheck::record(Violation::FileOpen);
+    return resolveNext(nextOpen64, "open64")(path, flags, mode);
+}
+
+std::FILE* rtcheckFopen(const char* path, const char* mode)
+{
+    rtcheck::record(Violation::FileOpen);
+    return resolveNext(nextFopen, "fopen")(path, mode);
+}
+
+std::FILE* rtcheckFopen64(const char* path, const char* mode)
+{
+    rtcheck::record(Violation::FileOpen);
+    return resolveNext(nextFopen64, "fopen64")(path, mode);
+}
+
+//==============================================================================
+#elif RTCHECK_DYLD_INTERPOSE
+
+// dyld rebinds every image's references to the originals to these functions
+// (calls made from this library itself still reach the originals).
+
+#include <malloc/malloc.h>
+
+// The interposed originals are bound by dyld at load time
+namespace rtcheck
+{
+namespace
+{
+    void resolveNextFunctions() noexcept {}
+}
+} // namespace rtcheck
+
+#define RTCHECK_INTERPOSE(replacement, original) \
+    __attribute__((used)) static const struct { const void* r; const void* o; } \
+        interpose_##original __attribute__((section("__DATA,__interpose"))) = \
+        { reinterpret_cast<const void*>(&replacement), reinterpret_cast<const void*>(&original) };
+
+namespace
+{
+    void* rtcheckMalloc(size_t size)
+    {
+        rtcheck::record(Violation::Allocation);
+        return malloc(size);
+    }
+
+    void* rtcheckCalloc(size_t count, size_t size)
+    {
+        rtcheck::record(Violation::Allocation);
+        return calloc(count, size);
+    }
+
+    void* rtcheckRealloc(void* pointer, size_t size)
+    {
+        rtcheck::record(Violation::Allocation);
+        return realloc(pointer, size);
+    }
+
+    int rtcheckPosixMemalign(void** result, size_t alignment, size_t size)
+    {
+        rtcheck::record(Violation::Allocation);
+        return posix_memalign(result, alignment, size);
+    }
+
+    void rtcheckFree(void* pointer)
+    {
+        if (pointer != nullptr)
+            rtcheck::record(Violation::Deallocation);
+
+        free(pointer);
+    }
+
+    int rtcheckMutexLock(pthread_mutex_t* mutex)
+    {
+        rtcheck::record(Violation::MutexLock);
+        return pthread_mutex_lock(mutex);
+    }
+
+    int rtcheckOpen(const char* path, int flags, ...)
+    {
+        va_list args;
+        va_start(args, flags);
+        const auto mode = rtcheck::readOpenMode(flags, args);
+        va_end(args);
+
+        rtcheck::record(Violation::FileOpen);
+        return open(path, flags, mode);
+    }
+
+    std::FILE* rtcheckFopen(const char* path, const char* mode)
+    {
+        rtcheck::record(Violation::FileOpen);
+        return fopen(path, mode);
+    }
+}
+
+RTCHECK_INTERPOSE(rtcheckMalloc, malloc)
+RTCHECK_INTERPOSE(rtcheckCalloc, calloc)
+RTCHECK_INTERPOSE(rtcheckRealloc, realloc)
+RTCHECK_INTERPOSE(rtcheckPosixMemalign, posix_memalign)
+RTCHECK_INTERPOSE(rtcheckFree, free)
+RTCHECK_INTERPOSE(rtcheckMutexLock, pthread_mutex_lock)
+RTCHECK_INTERPOSE(rtcheckOpen, open)
+RTCHECK_INTERPOSE(rtcheckFopen, fopen)
+
+#else
+
+namespace rtcheck
+{
+namespace
+{
+    void resolveNextFunctions() noexcept {}
+}
+} // namespace rtcheck
+
+#endif
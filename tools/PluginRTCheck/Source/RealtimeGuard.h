@@ -0,0 +1,65 @@
+#pragma once
+
+/*
+    RealtimeGuard - catches real-time-unsafe calls made on the audio thread
+
+    The PluginRTCheckGuard library replaces malloc / calloc / realloc / free /
+    posix_memalign / aligned_alloc, pthread_mutex_lock and open / fopen for the
+    whole process (symbol replacement on glibc, dyld interposing on macOS).
+    The hooks forward to the real functions and only record a call when the
+    calling thread is inside a ScopedAudioThread - everything else in the
+    process (JUCE start-up, the harness, the message thread) runs unobserved.
+
+    Each distinct call site (kind + scope + stack) is recorded once with a hit
+    count and a backtrace, into fixed storage, so recording never allocates.
+
+    The library has no JUCE dependency: it is built once and linked into every
+    <Plugin>_RTCheck runner.
+*/
+
+#include <cstdint>
+#include <cstdio>
+
+namespace rtcheck
+{
+    enum class Violation
+    {
+        Allocation,     // malloc, calloc, realloc, posix_memalign, aligned_alloc (and operator new)
+        Deallocation,   // free (and operator delete)
+        MutexLock,      // pthread_mutex_lock (std::mutex, juce::CriticalSection, ...)
+        FileOpen        // open, fopen
+    };
+
+    const char* getViolationName(Violation kind) noexcept;
+
+    /** False on platforms where the hooks are not compiled in - results would be empty. */
+    bool isAvailable() noexcept;
+
+    /** Call once from main() before the first scope: resolves the real functions
+        and warms up backtrace() so the hooks never trigger lazy loading.
+    */
+    void initialise();
+
+    /** Marks the calling thread as the audio thread for its lifetime.
+        scopeName must be a string literal (stored by pointer); blockIndex is
+        reported with the first hit of each call site.
+    */
+    class ScopedAudioThread
+    {
+    public:
+        ScopedAudioThread(const char* scopeName, std::int64_t blockIndex) noexcept;
+        ~ScopedAudioThread() noexcept;
+
+        ScopedAudioThread(const ScopedAudioThread&) = delete;
+        ScopedAudioThread& operator=(const ScopedAudioThread&) = delete;
+    };
+
+    /** Total violations recorded in a scope (all kinds, all call sites). */
+    std::int64_t getNumViolations(const char* scopeName) noexcept;
+
+    /** Prints every recorded call site of a scope with its backtrace. */
+    void printReport(const char* scopeName, std::FILE* stream);
+
+    /** Forgets everything recorded so far. Not callable inside a scope. */
+    void clear() noexcept;
+}
@@ -0,0 +1,236 @@
+/*
+    SaturationCheck - accuracy and throughput of pfs::saturation
+
+    Usage:
+        SaturationCheck [--points=1048576] [--range=12] [--block=512] [--seconds=1]
+
+    Accuracy: every kernel is swept over [-range, range] (plus the float
+    extremes) and compared with its reference - std::tanh in double precision,
+    RedShiftDistortion's original tube curve, the cubic soft clip formula - and
+    the SIMD block path is compared with the scalar kernel. The run fails
+    (exit code 1) when a bound below is exceeded.
+
+    Throughput: ns per sample for a std::tanh loop, the scalar kernel loop and
+    the block kernel, on a block of the given size refilled from the sweep.
+*/
+
+#include <juce_dsp/juce_dsp.h>
+#include "Saturation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+   #if JUCE_USE_SIMD
+    constexpr bool simdEnabled = true;
+   #else
+    constexpr bool simdEnabled = false;
+   #endif
+
+    constexpr double tanhErrorBound = 1.0e-6;
+    constexpr double tubeErrorBound = 2.0e-6;
+    constexpr double blockErrorBound = 1.0e-6;   // SIMD vs scalar (FMA contraction may differ)
+
+    struct ErrorStats
+    {
+        double maxError = 0.0;
+        float worstInput = 0.0f;
+
+        void add(float input, double error) noexcept
+        {
+            if (error > maxError)
+            {
+                maxError = error;
+                worstInput = input;
+            }
+        }
+    };
+
+    std::vector<float> createSweep(int numPoints, float range)
+    {
+        std::vector<float> sweep;
+        sweep.reserve(static_cast<size_t>(numPoints) + 6);
+
+        for (int i = 0; i < numPoints; ++i)
+            sweep.push_back(-range + 2.0f * range * static_cast<float>(i) / static_cast<float>(numPoints - 1));
+
+        // Far outside the audio range, the smallest normal, a denormal
+        for (auto extreme : { 1.0e4f, std::numeric_limits<float>::min(), 1.0e-40f })
+        {
+            sweep.push_back(extreme);
+            sweep.push_back(-extreme);
+        }
+
+        return sweep;
+    }
+
+    // RedShiftDistortion's original lambda, on std::tanh
+    double referenceTube(double driven)
+    {
+        if (driven > 0.0)
+        {
+            const auto saturated = std::tanh(driven * 1.15);
+            return saturated + driven * driven * 0.1 * (1.0 - saturated);
+        }
+
+        return std::tanh(driven * 0.85) * 0.95;
+    }
+
+    double referenceSoftClip(double x)
+    {
+        x = juce::jlimit(-1.0, 1.0, x);
+        return 1.5 * x - 0.5 * x * x * x;
+    }
+
+    template <typename Scalar, typename Block, typename Reference>
+    bool checkAccuracy(const char* name, const std::vector<float>& sweep, double bound,
+                       Scalar&& scalar, Block&& block, Reference&& reference)
+    {
+        ErrorStats referenceError, blockError;
+
+        // Offset by one float so the block kernel also runs its unaligned head
+        std::vector<float> blockData(sweep.size() + 1);
+        std::copy(sweep.begin(), sweep.end(), blockData.begin() + 1);
+        block(blockData.data() + 1, static_cast<int>(sweep.size()));
+
+        bool bounded = true;
+
+        for (size_t i = 0; i < sweep.size(); ++i)
+        {
+            const auto x = sweep[i];
+            const auto y = scalar(x);
+
+            referenceError.add(x, std::abs(static_cast<double>(y) - reference(static_cast<double>(x))));
+            blockError.add(x, std::abs(static_cast<double>(blockData[i + 1]) - static_cast<double>(y)));
+            bounded = bounded && std::isfinite(y);
+        }
+
+        const auto passed = bounded && referenceError.maxError <= bound && blockError.maxError <= blockErrorBound;
+
+        std::printf("%-16s max error %.3e at %+.4f (bound %.0e), block vs scalar %.3e  %s\n",
+                    name, referenceError.maxError, static_cast<double>(referenceError.worstInput), bound,
+                    blockError.maxError, passed ? "ok" : "FAILED");
+
+        return passed;
+    }
+
+    template <typename Process>
+    double measureNanosPerSample(const std::vector<float>& source, int blockSize, double seconds, Process&& process)
+    {
+        std::vector<float> block(static_cast<size_t>(blockSize));
+        size_t readPosition = 0;
+        juce::int64 samples = 0;
+        double elapsed = 0.0;
+
+        while (elapsed < seconds)
+        {
+            for (auto& sample : block)
+            {
+                sample = source[readPosition];
+                readPosition = (readPosition + 1) % source.size();
+            }
+
+            const auto start = Clock::now();
+            process(block.data(), blockSize);
+            elapsed += std::chrono::duration<double>(Clock::now() - start).count();
+            samples += blockSize;
+        }
+
+        // Keep the optimiser from discarding the work
+        volatile auto sink = block.front();
+        juce::ignoreUnused(sink);
+
+        return 1.0e9 * elapsed / static_cast<double>(samples);
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    const juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        std::printf("usage: %s [--points=N] [--range=X] [--block=N] [--seconds=N]\n",
+                    args.executableName.toRawUTF8());
+        return 0;
+    }
+
+    const auto numPoints = args.containsOption("--points") ? juce::jmax(2, args.getValueForOption("--points").getIntValue()) : 1 << 20;
+    const auto range = args.containsOption("--range") ? juce::jmax(0.1f, args.getValueForOption("--range").getFloatValue()) : 12.0f;
+    const auto blockSize = args.containsOption("--block") ? juce::jmax(1, args.getValueForOption("--block").getIntValue()) : 512;
+    const auto seconds = args.containsOption("--seconds") ? juce::jmax(0.05, args.getValueForOption("--seconds").getDoubleValue()) : 1.0;
+
+    const auto sweep = createSweep(numPoints, range);
+
+    std::printf("accuracy: %d points over [-%.1f, %.1f], SIMD %s\n\n", numPoints, static_cast<double>(range),
+                static_cast<double>(range), simdEnabled ? "enabled" : "disabled (scalar fallback)");
+
+    bool passed = true;
+
+    passed &= checkAccuracy("tanh", sweep, tanhErrorBound,
+                            [](float x) { return pfs::saturation::tanh(x); },
+                            [](float* data, int n) { pfs::saturation::tanhBlock(data, n); },
+                            [](double x) { return std::tanh(x); });
+
+    passed &= checkAccuracy("asymmetricTube", sweep, tubeErrorBound,
+                            [](float x) { return pfs::saturation::asymmetricTube(x); },
+                            [](float* data, int n) { pfs::saturation::asymmetricTubeBlock(data, n); },
+                            [](double x) { return referenceTube(x); });
+
+    passed &= checkAccuracy("softClip", sweep, tanhErrorBound,
+                            [](float x) { return pfs::saturation::softClip(x); },
+                            [](float* data, int n) { pfs::saturation::softClipBlock(data, n); },
+                            [](double x) { return referenceSoftClip(x); });
+
+    std::printf("\nthroughput: block %d, %.2f s per kernel (ns/sample)\n\n", blockSize, seconds);
+    std::printf("%-16s %12s %12s %12s %10s\n", "curve", "std::tanh", "scalar", "block", "speedup");
+
+    const auto stdTanh = measureNanosPerSample(sweep, blockSize, seconds, [](float* data, int n)
+    {
+        for (int i = 0; i < n; ++i)
+            data[i] = std::tanh(data[i]);
+    });
+
+    const auto scalarTanh = measureNanosPerSample(sweep, blockSize, seconds, [](float* data, int n)
+    {
+        for (int i = 0; i < n; ++i)
+            data[i] = pfs::saturation::tanh(data[i]);
+    });
+
+    const auto blockTanh = measureNanosPerSample(sweep, blockSize, seconds, [](float* data, int n)
+    {
+        pfs::saturation::tanhBlock(data, n);
+    });
+
+    std::printf("%-16s %12.3f %12.3f %12.3f %9.1fx\n", "tanh", stdTanh, scalarTanh, blockTanh, stdTanh / blockTanh);
+
+    const auto stdTube = measureNanosPerSample(sweep, blockSize, seconds, [](float* data, int n)
+    {
+        for (int i = 0; i < n; ++i)
+            data[i] = static_cast<float>(referenceTube(data[i]));
+    });
+
+    const auto scalarTube = measureNanosPerSample(sweep, blockSize, seconds, [](float* data, int n)
+    {
+        for (int i = 0; i < n; ++i)
+            data[i] = pfs::saturation::asymmetricTube(data[i]);
+    });
+
+    const auto blockTube = measureNanosPerSample(sweep, blockSize, seconds, [](float* data, int n)
+    {
+        pfs::saturation::asymmetricTubeBlock(data, n);
+    });
+
+    std::printf("%-16s %12.3f %12.3f %12.3f %9.1fx\n", "asymmetricTube", stdTube, scalarTube, blockTube, stdTube / blockTube);
+
+    std::printf("\n%s\n", passed ? "all kernels within bounds" : "FAILED: kernel error above bound");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,310 @@
+/*
+    ScatterCheck - accuracy of Scatter's grain reads
+
+    Usage:
+        ScatterCheck [--seconds=10] [--points=65536]
+
+    Interpolation: GrainBuffer's lane-parallel path (readPoints() into lane
+    arrays, interpolate() on pfs::simd::NativeLanes, as the grain renderer
+    runs it) against its scalar read(), at random positions and fractions,
+    and both against 3rd-order Lagrange in double.
+
+    Read positions: ScatterAudioProcessor is fed a quadrature pair - sine on
+    the left, cosine on the right, one cycle every phasePeriod samples - with
+    pan random off (equal pan gains), no feedback, fully wet, and a density low
+    enough that grains never overlap. Each grain's output then carries the
+    buffer position it read in its phase, atan2(left, right), whatever its
+    window and gain. Per grain, the positions must lie on a straight line
+    whose slope is the grain's pitch ratio (2^(k/12), either direction); the
+    longest grains at the widest pitch range, at 44.1 and 96 kHz, reach
+    buffer offsets where a float read offset keeps under a hundredth of a
+    sample.
+
+    The run fails (exit code 1) when a bound below is exceeded.
+*/
+
+#include "PluginProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+   #if JUCE_USE_SIMD
+    constexpr bool simdEnabled = true;
+   #else
+    constexpr bool simdEnabled = false;
+   #endif
+
+    constexpr double lanesErrorBound = 1.0e-6;          // vector vs scalar read (FMA contraction may differ)
+    constexpr double lagrangeErrorBound = 2.0e-6;       // float kernel vs double, signal in [-1, 1]
+    constexpr double positionErrorBound = 2.0e-4;       // samples off the grain's line
+    constexpr double rateErrorBound = 1.0e-6;           // fitted slope vs the nearest 2^(k/12)
+    constexpr int minGrains = 4;                        // a grain a second from 1.5 s: --seconds is at least 8
+
+    constexpr double sampleRates[] = { 44100.0, 96000.0 };
+    constexpr int blockSize = 512;
+    constexpr int phasePeriod = 1024;                   // input samples per cycle of the quadrature pair
+    constexpr int bufferSize = 4096;
+
+    //==============================================================================
+    double lagrange(double fraction, double xMinus1, double x0, double x1, double x2)
+    {
+        return -xMinus1 * fraction * (fraction - 1.0) * (fraction - 2.0) / 6.0
+             + x0 * (fraction + 1.0) * (fraction - 1.0) * (fraction - 2.0) / 2.0
+             - x1 * (fraction + 1.0) * fraction * (fraction - 2.0) / 2.0
+             + x2 * (fraction + 1.0) * fraction * (fraction - 1.0) / 6.0;
+    }
+
+    bool checkInterpolation(int numPoints)
+    {
+        using namespace pfs::simd;
+
+        juce::Random random (0x5ca77e4);
+
+        std::vector<float> left (bufferSize), right (bufferSize);
+
+        for (int i = 0; i < bufferSize; ++i)
+        {
+            left[static_cast<size_t>(i)] = random.nextFloat() * 2.0f - 1.0f;
+            right[static_cast<size_t>(i)] = random.nextFloat() * 2.0f - 1.0f;
+        }
+
+        GrainBuffer buffer;
+        buffer.prepare(bufferSize);
+        buffer.write(left.data(), right.data(), bufferSize);
+
+        alignas(laneAlignment) float fractions[laneWidth];
+        alignas(laneAlignment) float pointsLeft[4 * laneWidth], pointsRight[4 * laneWidth];
+        alignas(laneAlignment) float lanesLeft[laneWidth], lanesRight[laneWidth];
+        juce::int64 positions[laneWidth];
+
+        double lanesError = 0.0, lagrangeError = 0.0;
+
+        for (int batch = 0; batch < numPoints; batch += laneWidth)
+        {
+            for (int lane = 0; lane < laneWidth; ++lane)
+            {
+                // readPoints() needs position - 1 .. position + 2 written and inside the ring
+                positions[lane] = 2 + random.nextInt(bufferSize - 4);
+                fractions[lane] = random.nextFloat();
+                buffer.readPoints(positions[lane], pointsLeft + lane, pointsRight + lane, laneWidth);
+            }
+
+            const auto fraction = load<NativeLanes>(fractions);
+            store(lanesLeft, GrainBuffer::interpolate(fraction, load<NativeLanes>(pointsLeft), load<NativeLanes>(pointsLeft + laneWidth),
+                                                      load<NativeLanes>(pointsLeft + 2 * laneWidth), load<NativeLanes>(pointsLeft + 3 * laneWidth)));
+            store(lanesRight, GrainBuffer::interpolate(fraction, load<NativeLanes>(pointsRight), load<NativeLanes>(pointsRight + laneWidth),
+                                                       load<NativeLanes>(pointsRight + 2 * laneWidth), load<NativeLanes>(pointsRight + 3 * laneWidth)));
+
+            for (int lane = 0; lane < laneWidth; ++lane)
+            {
+                float scalarLeft = 0.0f, scalarRight = 0.0f;
+                buffer.read(positions[lane], fractions[lane], scalarLeft, scalarRight);
+
+                const auto index = static_cast<size_t>(positions[lane]);
+                const auto exactLeft = lagrange(fractions[lane], left[index - 1], left[index], left[index + 1], left[index + 2]);
+                const auto exactRight = lagrange(fractions[lane], right[index - 1], right[index], right[index + 1], right[index + 2]);
+
+                lanesError = std::max({ lanesError, std::abs(static_cast<double>(lanesLeft[lane] - scalarLeft)),
+                                        std::abs(static_cast<double>(lanesRight[lane] - scalarRight)) });
+                lagrangeError = std::max({ lagrangeError, std::abs(scalarLeft - exactLeft), std::abs(scalarRight - exactRight) });
+            }
+        }
+
+        const auto passed = lanesError <= lanesErrorBound && lagrangeError <= lagrangeErrorBound;
+
+        std::printf("GrainBuffer      lanes vs scalar %.3e (bound %.0e), scalar vs double Lagrange %.3e (bound %.0e)  %s\n",
+                    lanesError, lanesErrorBound, lagrangeError, lagrangeErrorBound, passed ? "ok" : "FAILED");
+
+        return passed;
+    }
+
+    //==============================================================================
+    void setParameter(ScatterAudioProcessor& processor, const char* id, float value)
+    {
+        auto* parameter = processor.parameters.getParameter(id);
+        jassert(parameter != nullptr);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    struct GrainFit
+    {
+        double maxPositionError = 0.0;
+        double rateError = 0.0;
+        double rate = 0.0;
+    };
+
+    // One grain's output [start, end): its read positions, fitted to a line by least squares
+    GrainFit fitGrain(const std::vector<float>& left, const std::vector<float>& right, int start, int end)
+    {
+        std::vector<double> positions;
+        positions.reserve(static_cast<size_t>(end - start));
+
+        // Phase of the quadrature pair, unwrapped, in input samples
+        double previousAngle = 0.0, turns = 0.0;
+
+        for (int i = start; i < end; ++i)
+        {
+            const auto angle = std::atan2(static_cast<double>(left[static_cast<size_t>(i)]),
+                                          static_cast<double>(right[static_cast<size_t>(i)]));
+
+            if (i > start)
+            {
+                if (angle - previousAngle > juce::MathConstants<double>::pi)
+                    turns -= 1.0;
+                else if (angle - previousAngle < -juce::MathConstants<double>::pi)
+                    turns += 1.0;
+            }
+
+            previousAngle = angle;
+            positions.push_back((turns + angle / juce::MathConstants<double>::twoPi) * phasePeriod);
+        }
+
+        const auto count = static_cast<double>(positions.size());
+        const auto meanIndex = (count - 1.0) / 2.0;
+        double meanPosition = 0.0;
+
+        for (auto position : positions)
+            meanPosition += position / count;
+
+        double covariance = 0.0, variance = 0.0;
+
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+            covariance += (static_cast<double>(i) - meanIndex) * (positions[i] - meanPosition);
+            variance += juce::square(static_cast<double>(i) - meanIndex);
+        }
+
+        GrainFit fit;
+        fit.rate = covariance / variance;
+
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+            const auto line = meanPosition + fit.rate * (static_cast<double>(i) - meanIndex);
+            fit.maxPositionError = std::max(fit.maxPositionError, std::abs(positions[i] - line));
+        }
+
+        const auto semitones = std::round(12.0 * std::log2(std::abs(fit.rate)));
+        fit.rateError = std::abs(std::abs(fit.rate) - std::pow(2.0, semitones / 12.0));
+
+        return fit;
+    }
+
+    bool checkReadPositions(double sampleRate, double seconds)
+    {
+        auto processor = std::make_unique<ScatterAudioProcessor>();
+
+        // Longest grains over the whole pitch range, one at a time, read back unchanged
+        setParameter(*processor, "grain_size", 500.0f);
+        setParameter(*processor, "density", 25.0f);         // overlap 0.5: jittered spawns stay over a grain apart
+        setParameter(*processor, "pitch_random", 100.0f);
+        setParameter(*processor, "scale", 0.0f);            // chromatic
+        setParameter(*processor, "pan_random", 0.0f);
+        setParameter(*processor, "feedback", 0.0f);
+        setParameter(*processor, "mix", 100.0f);
+
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        const auto numBlocks = static_cast<int>(std::ceil(seconds * sampleRate / blockSize));
+        const auto numSamples = numBlocks * blockSize;
+
+        std::vector<float> left (static_cast<size_t>(numSamples)), right (static_cast<size_t>(numSamples));
+        juce::AudioBuffer<float> buffer (2, blockSize);
+        juce::MidiBuffer midi;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            const auto blockStart = block * blockSize;
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const auto phase = juce::MathConstants<double>::twoPi * ((blockStart + i) % phasePeriod) / phasePeriod;
+                buffer.setSample(0, i, static_cast<float>(std::sin(phase)));
+                buffer.setSample(1, i, static_cast<float>(std::cos(phase)));
+            }
+
+            processor->processBlock(buffer, midi);
+
+            std::copy(buffer.getReadPointer(0), buffer.getReadPointer(0) + blockSize, left.begin() + blockStart);
+            std::copy(buffer.getReadPointer(1), buffer.getReadPointer(1) + blockSize, right.begin() + blockStart);
+        }
+
+        // Grains are the runs of non-silent output. Skip the ones cut off by the end of the
+        // render, and the early ones: a grain reads up to 1.25 s back (500 ms delay, then a
+        // reversed 500 ms grain at +7 semitones), and must only read written input
+        const auto firstGrainSample = static_cast<int>(1.5 * sampleRate);
+        const auto minGrainSamples = static_cast<int>(0.4 * sampleRate);
+        int numGrains = 0;
+        double maxPositionError = 0.0, maxRateError = 0.0, minRate = 0.0, maxRate = 0.0;
+
+        for (int start = 0; start < numSamples;)
+        {
+            const auto isSilent = [&](int i) { return left[static_cast<size_t>(i)] == 0.0f && right[static_cast<size_t>(i)] == 0.0f; };
+
+            if (isSilent(start))
+            {
+                ++start;
+                continue;
+            }
+
+            auto end = start;
+
+            while (end < numSamples && ! isSilent(end))
+                ++end;
+
+            if (start >= firstGrainSample && end < numSamples && end - start >= minGrainSamples)
+            {
+                const auto fit = fitGrain(left, right, start, end);
+
+                maxPositionError = std::max(maxPositionError, fit.maxPositionError);
+                maxRateError = std::max(maxRateError, fit.rateError);
+                minRate = numGrains == 0 ? fit.rate : std::min(minRate, fit.rate);
+                maxRate = numGrains == 0 ? fit.rate : std::max(maxRate, fit.rate);
+                ++numGrains;
+            }
+
+            start = end;
+        }
+
+        const auto passed = numGrains >= minGrains && maxPositionError <= positionErrorBound && maxRateError <= rateErrorBound;
+
+        std::printf("read positions %5.1f kHz  %d grains, rates %+.3f to %+.3f  off line %.3e samples (bound %.0e), "
+                    "rate error %.1e (bound %.0e)  %s\n",
+                    sampleRate / 1000.0, numGrains, minRate, maxRate, maxPositionError, positionErrorBound,
+                    maxRateError, rateErrorBound, passed ? "ok" : "FAILED");
+
+        return passed;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        std::printf("usage: %s [--seconds=N] [--points=N]\n", args.executableName.toRawUTF8());
+        return 0;
+    }
+
+    const auto seconds = args.containsOption("--seconds") ? juce::jmax(8.0, args.getValueForOption("--seconds").getDoubleValue()) : 10.0;
+    const auto numPoints = args.containsOption("--points") ? juce::jmax(1, args.getValueForOption("--points").getIntValue()) : 1 << 16;
+
+    std::printf("SIMD %s\n\n", simdEnabled ? "enabled" : "disabled (scalar fallback)");
+
+    bool passed = checkInterpolation(numPoints);
+
+    for (auto sampleRate : sampleRates)
+        passed &= checkReadPositions(sampleRate, seconds);
+
+    std::printf("\n%s\n", passed ? "all reads within bounds" : "FAILED: read error above bound");
+    return passed ? 0 : 1;
+}